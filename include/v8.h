@@ -1487,6 +1487,20 @@ class V8_EXPORT ScriptCompiler {
       Local<String> arguments[], size_t context_extension_count,
       Local<Object> context_extensions[]);
 
+  /**
+   * Creates and returns code cache for the specified unbound_script.
+   * This will return nullptr if the script cannot be serialized. The
+   * CachedData returned by this function should be owned by the caller.
+   *
+   * Unlike the data produced with kProduceCodeCache, the cache can be created
+   * after the script has run. It then also contains the functions that were
+   * compiled lazily, and, with --cache-optimization-hints, records which
+   * functions were optimized so that they can be optimized again as soon as
+   * their type feedback is stable when the cache is consumed.
+   */
+  static CachedData* CreateCodeCache(Local<UnboundScript> unbound_script,
+                                     Local<String> source);
+
  private:
   static V8_WARN_UNUSED_RESULT MaybeLocal<UnboundScript> CompileUnboundInternal(
       Isolate* isolate, Source* source, CompileOptions options);
@@ -6353,6 +6367,174 @@ class V8_EXPORT HeapCodeStatistics {
   friend class Isolate;
 };
 
+/**
+ * A histogram of garbage collection pause times. Bucket boundaries grow
+ * exponentially from 0.1ms to 250ms.
+ */
+class V8_EXPORT GCPauseHistogram {
+ public:
+  static const int kNumberOfBuckets = 12;
+
+  /**
+   * Returns the exclusive upper bound in milliseconds of the bucket at
+   * |index|. The last bucket is unbounded and returns infinity.
+   */
+  static double BucketUpperBound(int index);
+
+  GCPauseHistogram();
+  size_t bucket_count(int index) const { return bucket_counts_[index]; }
+  size_t count() const { return count_; }
+  double total_ms() const { return total_ms_; }
+  double max_ms() const { return max_ms_; }
+
+ private:
+  size_t bucket_counts_[kNumberOfBuckets];
+  size_t count_;
+  double total_ms_;
+  double max_ms_;
+
+  friend class Isolate;
+};
+
+/**
+ * Cumulative garbage collection statistics of an isolate since its creation.
+ * Collecting them is cheap and always enabled; embedders that want per-interval
+ * values compute the difference between two snapshots.
+ */
+class V8_EXPORT GCStatistics {
+ public:
+  enum Pause {
+    // Whole atomic pauses of the different collectors.
+    kScavenge,
+    kMinorMarkCompact,
+    kMarkCompact,
+    kIncrementalMarkingStep,
+    // Phases of the (minor) mark-compact pauses.
+    kMark,
+    kSweep,
+    kEvacuate,
+    kUpdatePointers,
+    // Processing of weak global handles, in all pauses.
+    kExternalWeakHandles,
+    kNumberOfPauses
+  };
+
+  enum BackgroundTask {
+    kBackgroundMarking,
+    kBackgroundSweeping,
+    kBackgroundUnmapping,
+    kNumberOfBackgroundTasks
+  };
+
+  enum Space {
+    kNewSpace,
+    kOldSpace,
+    kCodeSpace,
+    kMapSpace,
+    kLargeObjectSpace,
+    kNumberOfSpaces
+  };
+
+  GCStatistics();
+  const GCPauseHistogram& pause_histogram(Pause pause) const {
+    return pauses_[pause];
+  }
+  double background_time_ms(BackgroundTask task) const {
+    return background_time_ms_[task];
+  }
+  size_t bytes_promoted() const { return bytes_promoted_; }
+  size_t bytes_survived_new_space() const { return bytes_survived_new_space_; }
+  /**
+   * Bytes freed in |space| by garbage collection pauses. Memory that is freed
+   * by concurrent sweeping after a pause is not included.
+   */
+  size_t bytes_freed(Space space) const { return bytes_freed_[space]; }
+
+ private:
+  GCPauseHistogram pauses_[kNumberOfPauses];
+  double background_time_ms_[kNumberOfBackgroundTasks];
+  size_t bytes_promoted_;
+  size_t bytes_survived_new_space_;
+  size_t bytes_freed_[kNumberOfSpaces];
+
+  friend class Isolate;
+};
+
+/**
+ * Statistics about one member of a HeapGroup, as recorded by the group at the
+ * end of the member's last garbage collection.
+ */
+class V8_EXPORT HeapGroupMemberStatistics {
+ public:
+  HeapGroupMemberStatistics();
+  Isolate* isolate() { return isolate_; }
+  size_t old_generation_size() { return old_generation_size_; }
+  size_t old_generation_allocation_limit() {
+    return old_generation_allocation_limit_;
+  }
+  size_t memory_pressure_notifications() {
+    return memory_pressure_notifications_;
+  }
+
+ private:
+  Isolate* isolate_;
+  size_t old_generation_size_;
+  size_t old_generation_allocation_limit_;
+  size_t memory_pressure_notifications_;
+
+  friend class HeapGroup;
+};
+
+/**
+ * A group of isolates in the same process that share one old generation
+ * budget. The old generation allocation limit of each member is capped to the
+ * part of the budget not used by the other members, and when the group goes
+ * over budget the largest members are sent a critical memory pressure
+ * notification first.
+ *
+ * A heap group is thread-safe. It must outlive its members, or all members
+ * must leave the group before it is disposed.
+ */
+class V8_EXPORT HeapGroup {
+ public:
+  /**
+   * Creates a new heap group sharing |old_generation_budget_in_bytes|
+   * between its members.
+   */
+  static HeapGroup* New(size_t old_generation_budget_in_bytes);
+
+  /**
+   * Disposes the heap group. The group must not have any members left.
+   */
+  void Dispose();
+
+  size_t old_generation_budget();
+
+  /**
+   * Returns the number of isolates that are currently members of the group.
+   */
+  size_t NumberOfMembers();
+
+  /**
+   * Returns the combined old generation size of all members.
+   */
+  size_t TotalOldGenerationSize();
+
+  /**
+   * Fills |statistics| for the member at |index|. Returns false if |index| is
+   * out of range.
+   */
+  bool GetMemberStatistics(HeapGroupMemberStatistics* statistics,
+                           size_t index);
+
+  HeapGroup() = delete;
+  ~HeapGroup() = delete;
+  HeapGroup(const HeapGroup&) = delete;
+  HeapGroup& operator=(const HeapGroup&) = delete;
+  void* operator new(size_t size) = delete;
+  void operator delete(void*, size_t) = delete;
+};
+
 class RetainedObjectInfo;
 
 
@@ -7018,6 +7200,19 @@ class V8_EXPORT Isolate {
    */
   bool GetHeapCodeAndMetadataStatistics(HeapCodeStatistics* object_statistics);
 
+  /**
+   * Get cumulative garbage collection pause histograms and byte counts.
+   * Must be called on the thread the isolate is used on.
+   */
+  void GetGCStatistics(GCStatistics* statistics);
+
+  /**
+   * Makes this isolate a member of |group|, leaving the group it belonged to
+   * before, if any. Passing nullptr only leaves the current group. Isolates
+   * leave their group automatically when they are disposed.
+   */
+  void SetHeapGroup(HeapGroup* group);
+
   /**
    * Get a call stack sample from the isolate.
    * \param state Execution state.
@@ -7388,6 +7583,25 @@ class V8_EXPORT Isolate {
    */
   void IsolateInBackgroundNotification();
 
+  /**
+   * Sets a target for the memory committed by the V8 heap of this isolate.
+   * While the target is exceeded, V8 uses the idle periods announced with
+   * MemoryReducerIdleNotification() to shrink the heap towards the target
+   * by running memory reducing garbage collections and releasing free pages
+   * to the operating system. Passing 0 removes the target.
+   */
+  void SetHeapMemoryTarget(size_t committed_bytes);
+
+  /**
+   * Optional notification that the isolate is idle and is expected to stay
+   * idle for |idle_time_in_ms|, e.g. between two requests of a server. The
+   * call returns immediately. The work towards the heap memory target is done
+   * in short tasks posted to the foreground thread, which stop at the end of
+   * the idle period, so that it does not block a request that arrives in the
+   * meantime. Passing 0 ends the idle period early.
+   */
+  void MemoryReducerIdleNotification(double idle_time_in_ms);
+
   /**
    * Optional notification to tell V8 the current performance requirements
    * of the embedder based on RAIL.
@@ -41,6 +41,8 @@
 #include "src/gdb-jit.h"
 #include "src/global-handles.h"
 #include "src/globals.h"
+#include "src/heap/gc-tracer.h"
+#include "src/heap/heap-group.h"
 #include "src/icu_util.h"
 #include "src/isolate-inl.h"
 #include "src/json-parser.h"
@@ -2469,6 +2471,34 @@ Local<Function> ScriptCompiler::CompileFunctionInContext(
 }
 
 
+ScriptCompiler::CachedData* ScriptCompiler::CreateCodeCache(
+    Local<UnboundScript> unbound_script, Local<String> source) {
+  i::Handle<i::SharedFunctionInfo> shared =
+      i::Handle<i::SharedFunctionInfo>::cast(
+          Utils::OpenHandle(*unbound_script));
+  i::Isolate* isolate = shared->GetIsolate();
+  DCHECK(shared->is_toplevel());
+  i::HandleScope scope(isolate);
+  i::Handle<i::Script> script(i::Script::cast(shared->script()), isolate);
+  {
+    // asm.js modules are instantiated as wasm and cannot be serialized.
+    i::DisallowHeapAllocation no_gc;
+    i::SharedFunctionInfo::ScriptIterator iter(script);
+    while (i::SharedFunctionInfo* info = iter.Next()) {
+      if (info->HasAsmWasmData()) return nullptr;
+    }
+  }
+
+  i::ScriptData* script_data =
+      i::CodeSerializer::Serialize(isolate, shared, Utils::OpenHandle(*source));
+  CachedData* result = new CachedData(
+      script_data->data(), script_data->length(), CachedData::BufferOwned);
+  script_data->ReleaseDataOwnership();
+  delete script_data;
+  return result;
+}
+
+
 ScriptCompiler::ScriptStreamingTask* ScriptCompiler::StartStreamingScript(
     Isolate* v8_isolate, StreamedSource* source, CompileOptions options) {
   if (!i::FLAG_script_streaming) {
@@ -6322,6 +6352,71 @@ HeapObjectStatistics::HeapObjectStatistics()
 HeapCodeStatistics::HeapCodeStatistics()
     : code_and_metadata_size_(0), bytecode_and_metadata_size_(0) {}
 
+GCPauseHistogram::GCPauseHistogram()
+    : count_(0), total_ms_(0.0), max_ms_(0.0) {
+  for (int i = 0; i < kNumberOfBuckets; i++) bucket_counts_[i] = 0;
+}
+
+double GCPauseHistogram::BucketUpperBound(int index) {
+  STATIC_ASSERT(kNumberOfBuckets ==
+                i::GCTracer::PauseHistogram::kNumberOfBuckets);
+  DCHECK_LE(0, index);
+  DCHECK_LT(index, kNumberOfBuckets);
+  if (index == kNumberOfBuckets - 1) {
+    return std::numeric_limits<double>::infinity();
+  }
+  return i::GCTracer::PauseHistogram::kBucketUpperBounds[index];
+}
+
+GCStatistics::GCStatistics()
+    : bytes_promoted_(0), bytes_survived_new_space_(0) {
+  for (int i = 0; i < kNumberOfBackgroundTasks; i++) {
+    background_time_ms_[i] = 0.0;
+  }
+  for (int i = 0; i < kNumberOfSpaces; i++) bytes_freed_[i] = 0;
+}
+
+HeapGroupMemberStatistics::HeapGroupMemberStatistics()
+    : isolate_(nullptr),
+      old_generation_size_(0),
+      old_generation_allocation_limit_(0),
+      memory_pressure_notifications_(0) {}
+
+HeapGroup* HeapGroup::New(size_t old_generation_budget_in_bytes) {
+  return reinterpret_cast<HeapGroup*>(
+      new i::HeapGroup(old_generation_budget_in_bytes));
+}
+
+void HeapGroup::Dispose() { delete reinterpret_cast<i::HeapGroup*>(this); }
+
+size_t HeapGroup::old_generation_budget() {
+  return reinterpret_cast<i::HeapGroup*>(this)->old_generation_budget();
+}
+
+size_t HeapGroup::NumberOfMembers() {
+  return reinterpret_cast<i::HeapGroup*>(this)->NumberOfMembers();
+}
+
+size_t HeapGroup::TotalOldGenerationSize() {
+  return reinterpret_cast<i::HeapGroup*>(this)->TotalOldGenerationSize();
+}
+
+bool HeapGroup::GetMemberStatistics(HeapGroupMemberStatistics* statistics,
+                                    size_t index) {
+  i::HeapGroup::MemberStatistics stats;
+  if (!reinterpret_cast<i::HeapGroup*>(this)->GetMemberStatistics(index,
+                                                                  &stats)) {
+    return false;
+  }
+  statistics->isolate_ = reinterpret_cast<Isolate*>(stats.heap->isolate());
+  statistics->old_generation_size_ = stats.old_generation_size;
+  statistics->old_generation_allocation_limit_ =
+      stats.old_generation_allocation_limit;
+  statistics->memory_pressure_notifications_ =
+      stats.memory_pressure_notifications;
+  return true;
+}
+
 bool v8::V8::InitializeICU(const char* icu_data_file) {
   return i::InitializeICU(icu_data_file);
 }
@@ -7814,8 +7909,9 @@ Local<ArrayBuffer> v8::ArrayBuffer::New(Isolate* isolate, size_t byte_length) {
   i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
   LOG_API(i_isolate, ArrayBuffer, New);
   ENTER_V8_NO_SCRIPT_NO_EXCEPTION(i_isolate);
-  i::Handle<i::JSArrayBuffer> obj =
-      i_isolate->factory()->NewJSArrayBuffer(i::SharedFlag::kNotShared);
+  i::Handle<i::JSArrayBuffer> obj = i_isolate->factory()->NewJSArrayBuffer(
+      i::SharedFlag::kNotShared,
+      i_isolate->heap()->GetArrayBufferPretenureMode());
   // TODO(jbroman): It may be useful in the future to provide a MaybeLocal
   // version that throws an exception or otherwise does not crash.
   if (!i::JSArrayBuffer::SetupAllocatingData(obj, i_isolate, byte_length)) {
@@ -7833,8 +7929,9 @@ Local<ArrayBuffer> v8::ArrayBuffer::New(Isolate* isolate, void* data,
   i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
   LOG_API(i_isolate, ArrayBuffer, New);
   ENTER_V8_NO_SCRIPT_NO_EXCEPTION(i_isolate);
-  i::Handle<i::JSArrayBuffer> obj =
-      i_isolate->factory()->NewJSArrayBuffer(i::SharedFlag::kNotShared);
+  i::Handle<i::JSArrayBuffer> obj = i_isolate->factory()->NewJSArrayBuffer(
+      i::SharedFlag::kNotShared,
+      i_isolate->heap()->GetArrayBufferPretenureMode());
   i::JSArrayBuffer::Setup(obj, i_isolate,
                           mode == ArrayBufferCreationMode::kExternalized, data,
                           byte_length);
@@ -8008,8 +8105,8 @@ Local<SharedArrayBuffer> v8::SharedArrayBuffer::New(Isolate* isolate,
   i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
   LOG_API(i_isolate, SharedArrayBuffer, New);
   ENTER_V8_NO_SCRIPT_NO_EXCEPTION(i_isolate);
-  i::Handle<i::JSArrayBuffer> obj =
-      i_isolate->factory()->NewJSArrayBuffer(i::SharedFlag::kShared);
+  i::Handle<i::JSArrayBuffer> obj = i_isolate->factory()->NewJSArrayBuffer(
+      i::SharedFlag::kShared, i_isolate->heap()->GetArrayBufferPretenureMode());
   // TODO(jbroman): It may be useful in the future to provide a MaybeLocal
   // version that throws an exception or otherwise does not crash.
   if (!i::JSArrayBuffer::SetupAllocatingData(obj, i_isolate, byte_length, true,
@@ -8029,8 +8126,8 @@ Local<SharedArrayBuffer> v8::SharedArrayBuffer::New(
   i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
   LOG_API(i_isolate, SharedArrayBuffer, New);
   ENTER_V8_NO_SCRIPT_NO_EXCEPTION(i_isolate);
-  i::Handle<i::JSArrayBuffer> obj =
-      i_isolate->factory()->NewJSArrayBuffer(i::SharedFlag::kShared);
+  i::Handle<i::JSArrayBuffer> obj = i_isolate->factory()->NewJSArrayBuffer(
+      i::SharedFlag::kShared, i_isolate->heap()->GetArrayBufferPretenureMode());
   i::JSArrayBuffer::Setup(obj, i_isolate,
                           mode == ArrayBufferCreationMode::kExternalized, data,
                           byte_length, i::SharedFlag::kShared);
@@ -8482,6 +8579,67 @@ Isolate::SuppressMicrotaskExecutionScope::~SuppressMicrotaskExecutionScope() {
 }
 
 
+void Isolate::SetHeapGroup(HeapGroup* group) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->heap()->SetHeapGroup(reinterpret_cast<i::HeapGroup*>(group));
+}
+
+void Isolate::GetGCStatistics(GCStatistics* statistics) {
+#define CHECK_PAUSE(api_name, internal_name)                            \
+  STATIC_ASSERT(static_cast<int>(GCStatistics::api_name) ==            \
+                static_cast<int>(i::GCTracer::Telemetry::internal_name))
+  CHECK_PAUSE(kScavenge, kScavenge);
+  CHECK_PAUSE(kMinorMarkCompact, kMinorMarkCompact);
+  CHECK_PAUSE(kMarkCompact, kMarkCompact);
+  CHECK_PAUSE(kIncrementalMarkingStep, kIncrementalMarkingStep);
+  CHECK_PAUSE(kMark, kMark);
+  CHECK_PAUSE(kSweep, kSweep);
+  CHECK_PAUSE(kEvacuate, kEvacuate);
+  CHECK_PAUSE(kUpdatePointers, kUpdatePointers);
+  CHECK_PAUSE(kExternalWeakHandles, kExternalWeakHandles);
+  CHECK_PAUSE(kNumberOfPauses, kNumberOfPauses);
+#undef CHECK_PAUSE
+  STATIC_ASSERT(static_cast<int>(GCStatistics::kBackgroundMarking) ==
+                i::GCTracer::BackgroundScope::MC_BACKGROUND_MARKING);
+  STATIC_ASSERT(static_cast<int>(GCStatistics::kBackgroundSweeping) ==
+                i::GCTracer::BackgroundScope::MC_BACKGROUND_SWEEPING);
+  STATIC_ASSERT(static_cast<int>(GCStatistics::kBackgroundUnmapping) ==
+                i::GCTracer::BackgroundScope::BACKGROUND_UNMAPPER);
+  STATIC_ASSERT(static_cast<int>(GCStatistics::kNumberOfBackgroundTasks) ==
+                i::GCTracer::BackgroundScope::NUMBER_OF_SCOPES);
+  STATIC_ASSERT(static_cast<int>(GCStatistics::kNewSpace) == i::NEW_SPACE);
+  STATIC_ASSERT(static_cast<int>(GCStatistics::kOldSpace) == i::OLD_SPACE);
+  STATIC_ASSERT(static_cast<int>(GCStatistics::kCodeSpace) == i::CODE_SPACE);
+  STATIC_ASSERT(static_cast<int>(GCStatistics::kMapSpace) == i::MAP_SPACE);
+  STATIC_ASSERT(static_cast<int>(GCStatistics::kLargeObjectSpace) ==
+                i::LO_SPACE);
+  STATIC_ASSERT(static_cast<int>(GCStatistics::kNumberOfSpaces) ==
+                i::LAST_SPACE + 1);
+
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  i::GCTracer::Telemetry telemetry;
+  isolate->heap()->tracer()->GetTelemetry(&telemetry);
+  for (int i = 0; i < GCStatistics::kNumberOfPauses; i++) {
+    const i::GCTracer::PauseHistogram& source = telemetry.pauses[i];
+    GCPauseHistogram* target = &statistics->pauses_[i];
+    for (int bucket = 0; bucket < GCPauseHistogram::kNumberOfBuckets;
+         bucket++) {
+      target->bucket_counts_[bucket] = source.bucket_count(bucket);
+    }
+    target->count_ = source.count();
+    target->total_ms_ = source.total_ms();
+    target->max_ms_ = source.max_ms();
+  }
+  for (int i = 0; i < GCStatistics::kNumberOfBackgroundTasks; i++) {
+    statistics->background_time_ms_[i] = telemetry.background_time_ms[i];
+  }
+  statistics->bytes_promoted_ = telemetry.bytes_promoted;
+  statistics->bytes_survived_new_space_ = telemetry.bytes_survived_new_space;
+  for (int i = 0; i < GCStatistics::kNumberOfSpaces; i++) {
+    statistics->bytes_freed_[i] = telemetry.bytes_freed[i];
+  }
+}
+
 void Isolate::GetHeapStatistics(HeapStatistics* heap_statistics) {
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
   i::Heap* heap = isolate->heap();
@@ -8795,6 +8953,16 @@ void Isolate::IsolateInBackgroundNotification() {
   return isolate->IsolateInBackgroundNotification();
 }
 
+void Isolate::SetHeapMemoryTarget(size_t committed_bytes) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->heap()->SetHeapMemoryTarget(committed_bytes);
+}
+
+void Isolate::MemoryReducerIdleNotification(double idle_time_in_ms) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->heap()->MemoryReducerIdleNotification(idle_time_in_ms);
+}
+
 void Isolate::MemoryPressureNotification(MemoryPressureLevel level) {
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
   bool on_isolate_thread =
@@ -161,6 +161,19 @@ void OS::Unprotect(void* address, const size_t size) {
 #endif
 }
 
+void OS::DiscardSystemPages(void* address, const size_t size) {
+#if V8_OS_CYGWIN
+  VirtualAlloc(address, size, MEM_RESET, PAGE_READWRITE);
+#elif defined(MADV_DONTNEED)
+  int result = madvise(reinterpret_cast<char*>(address), size, MADV_DONTNEED);
+  USE(result);
+  DCHECK_EQ(0, result);
+#else
+  USE(address);
+  USE(size);
+#endif
+}
+
 static LazyInstance<RandomNumberGenerator>::type
     platform_random_number_generator = LAZY_INSTANCE_INITIALIZER;
 
@@ -838,6 +838,13 @@ void OS::Unprotect(void* address, const size_t size) {
   USE(result);
 }
 
+void OS::DiscardSystemPages(void* address, const size_t size) {
+  // MEM_RESET keeps the pages committed but allows the system to drop their
+  // contents instead of writing them to the paging file.
+  LPVOID result = VirtualAlloc(address, size, MEM_RESET, PAGE_READWRITE);
+  USE(result);
+}
+
 void OS::Sleep(TimeDelta interval) {
   ::Sleep(static_cast<DWORD>(interval.InMilliseconds()));
 }
@@ -192,6 +192,11 @@ class V8_BASE_EXPORT OS {
   // Make a region of memory readable and writable.
   static void Unprotect(void* address, const size_t size);
 
+  // Tells the OS that the contents of the given committed region are no longer
+  // needed, so that the backing physical pages can be reclaimed. The region
+  // stays accessible; its contents are undefined afterwards.
+  static void DiscardSystemPages(void* address, const size_t size);
+
   // Generate a random address to be used for hinting mmap().
   static void* GetRandomMmapAddr();
 
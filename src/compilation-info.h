@@ -53,6 +53,7 @@ class V8_EXPORT_PRIVATE CompilationInfo final {
     kOptimizeFromBytecode = 1 << 15,
     kLoopPeelingEnabled = 1 << 16,
     kBlockCoverageEnabled = 1 << 17,
+    kLoopAwareRegisterAllocation = 1 << 18,
   };
 
   CompilationInfo(Zone* zone, ParseInfo* parse_info, Isolate* isolate,
@@ -187,6 +188,14 @@ class V8_EXPORT_PRIVATE CompilationInfo final {
     return GetFlag(kBlockCoverageEnabled);
   }
 
+  void MarkAsLoopAwareRegisterAllocation() {
+    SetFlag(kLoopAwareRegisterAllocation);
+  }
+
+  bool is_loop_aware_register_allocation() const {
+    return GetFlag(kLoopAwareRegisterAllocation);
+  }
+
   bool GeneratePreagedPrologue() const {
     // Generate a pre-aged prologue if we are optimizing for size, which
     // will make code old more aggressive. Only apply to Code::FUNCTION,
@@ -283,6 +292,11 @@ class V8_EXPORT_PRIVATE CompilationInfo final {
     osr_expr_stack_height_ = height;
   }
 
+  // The profiler ticks of the function when its optimization was requested.
+  // They are recorded before the ticks are reset for the optimization.
+  int profiler_ticks() const { return profiler_ticks_; }
+  void set_profiler_ticks(int ticks) { profiler_ticks_ = ticks; }
+
   bool has_simple_parameters();
 
   struct InlinedFunctionHolder {
@@ -394,6 +408,8 @@ class V8_EXPORT_PRIVATE CompilationInfo final {
   // The current OSR frame for specialization or {nullptr}.
   JavaScriptFrame* osr_frame_ = nullptr;
 
+  int profiler_ticks_ = 0;
+
   Vector<const char> debug_name_;
 
   // Encapsulates coverage information gathered by the bytecode generator.
@@ -56,12 +56,17 @@ class OptimizingCompileDispatcher::CompileTask : public v8::Task {
       TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.compile"),
                    "V8.RecompileConcurrent");
 
-      if (dispatcher_->recompilation_delay_ != 0) {
-        base::OS::Sleep(base::TimeDelta::FromMilliseconds(
-            dispatcher_->recompilation_delay_));
+      // Keep compiling until the input queue runs dry so that a bounded
+      // number of tasks works through the jobs in priority order.
+      for (;;) {
+        if (dispatcher_->recompilation_delay_ != 0) {
+          base::OS::Sleep(base::TimeDelta::FromMilliseconds(
+              dispatcher_->recompilation_delay_));
+        }
+        CompilationJob* job = dispatcher_->NextInputForTask();
+        if (job == nullptr) break;
+        dispatcher_->CompileNext(job);
       }
-
-      dispatcher_->CompileNext(dispatcher_->NextInput(true));
     }
     {
       base::LockGuard<base::Mutex> lock_guard(&dispatcher_->ref_count_mutex_);
@@ -84,27 +89,63 @@ OptimizingCompileDispatcher::~OptimizingCompileDispatcher() {
     DCHECK_EQ(0, ref_count_);
   }
 #endif
-  DCHECK_EQ(0, input_queue_length_);
-  DeleteArray(input_queue_);
+  DCHECK(input_queue_.empty());
+  DCHECK(blocked_jobs_.empty());
+}
+
+// static
+int OptimizingCompileDispatcher::HotnessPriority(CompilationInfo* info) {
+  // Profiler ticks measure time spent in the function, invocations break
+  // ties between functions with the same number of ticks.
+  static const int kMaxInvocationCount = (1 << 16) - 1;
+  JSFunction* function = *info->closure();
+  int invocations = function->has_feedback_vector()
+                        ? function->feedback_vector()->invocation_count()
+                        : 0;
+  return (info->profiler_ticks() << 16) + Min(invocations, kMaxInvocationCount);
 }
 
-CompilationJob* OptimizingCompileDispatcher::NextInput(bool check_if_flushing) {
+CompilationJob* OptimizingCompileDispatcher::NextInput() {
   base::LockGuard<base::Mutex> access_input_queue_(&input_queue_mutex_);
-  if (input_queue_length_ == 0) return NULL;
-  CompilationJob* job = input_queue_[InputQueueIndex(0)];
+  if (input_queue_.empty()) return NULL;
+  std::pop_heap(input_queue_.begin(), input_queue_.end(), InputQueueOrder());
+  CompilationJob* job = input_queue_.back().job;
   DCHECK_NOT_NULL(job);
-  input_queue_shift_ = InputQueueIndex(1);
-  input_queue_length_--;
-  if (check_if_flushing) {
-    if (static_cast<ModeFlag>(base::Acquire_Load(&mode_)) == FLUSH) {
-      AllowHandleDereference allow_handle_dereference;
-      DisposeCompilationJob(job, true);
-      return NULL;
-    }
+  input_queue_.pop_back();
+  return job;
+}
+
+CompilationJob* OptimizingCompileDispatcher::NextInputForTask() {
+  base::LockGuard<base::Mutex> access_input_queue_(&input_queue_mutex_);
+  if (static_cast<ModeFlag>(base::Acquire_Load(&mode_)) == FLUSH) {
+    AllowHandleDereference allow_handle_dereference;
+    FlushInputQueue();
+  }
+  if (input_queue_.empty()) {
+    // Retire while holding the lock so that QueueForOptimization either sees
+    // this task as running and leaves the new job to it, or posts a new one.
+    DCHECK_LT(0, running_tasks_);
+    running_tasks_--;
+    return NULL;
   }
+  std::pop_heap(input_queue_.begin(), input_queue_.end(), InputQueueOrder());
+  CompilationJob* job = input_queue_.back().job;
+  DCHECK_NOT_NULL(job);
+  input_queue_.pop_back();
   return job;
 }
 
+void OptimizingCompileDispatcher::FlushInputQueue() {
+  for (const InputQueueEntry& entry : input_queue_) {
+    DisposeCompilationJob(entry.job, true);
+  }
+  input_queue_.clear();
+  for (const InputQueueEntry& entry : blocked_jobs_) {
+    DisposeCompilationJob(entry.job, true);
+  }
+  blocked_jobs_.clear();
+}
+
 void OptimizingCompileDispatcher::CompileNext(CompilationJob* job) {
   if (!job) return;
 
@@ -137,13 +178,9 @@ void OptimizingCompileDispatcher::FlushOutputQueue(bool restore_function_code) {
 void OptimizingCompileDispatcher::Flush(BlockingBehavior blocking_behavior) {
   if (blocking_behavior == BlockingBehavior::kDontBlock) {
     if (FLAG_block_concurrent_recompilation) Unblock();
-    base::LockGuard<base::Mutex> access_input_queue_(&input_queue_mutex_);
-    while (input_queue_length_ > 0) {
-      CompilationJob* job = input_queue_[InputQueueIndex(0)];
-      DCHECK_NOT_NULL(job);
-      input_queue_shift_ = InputQueueIndex(1);
-      input_queue_length_--;
-      DisposeCompilationJob(job, true);
+    {
+      base::LockGuard<base::Mutex> access_input_queue_(&input_queue_mutex_);
+      FlushInputQueue();
     }
     FlushOutputQueue(true);
     if (FLAG_trace_concurrent_recompilation) {
@@ -175,8 +212,8 @@ void OptimizingCompileDispatcher::Stop() {
 
   if (recompilation_delay_ != 0) {
     // At this point the optimizing compiler thread's event loop has stopped.
-    // There is no need for a mutex when reading input_queue_length_.
-    while (input_queue_length_ > 0) CompileNext(NextInput());
+    // There is no need for a mutex when reading input_queue_.
+    while (!input_queue_.empty()) CompileNext(NextInput());
     InstallOptimizedFunctions();
   } else {
     FlushOutputQueue(false);
@@ -209,29 +246,53 @@ void OptimizingCompileDispatcher::InstallOptimizedFunctions() {
   }
 }
 
-void OptimizingCompileDispatcher::QueueForOptimization(CompilationJob* job) {
+void OptimizingCompileDispatcher::QueueForOptimization(CompilationJob* job,
+                                                       int priority) {
   DCHECK(IsQueueAvailable());
+  bool post_task = false;
   {
-    // Add job to the back of the input queue.
+    // Add job to the input queue.
     base::LockGuard<base::Mutex> access_input_queue(&input_queue_mutex_);
-    DCHECK_LT(input_queue_length_, input_queue_capacity_);
-    input_queue_[InputQueueIndex(input_queue_length_)] = job;
-    input_queue_length_++;
-  }
-  if (FLAG_block_concurrent_recompilation) {
-    blocked_jobs_++;
-  } else {
-    V8::GetCurrentPlatform()->CallOnBackgroundThread(
-        new CompileTask(isolate_, this), v8::Platform::kShortRunningTask);
+    DCHECK_LT(static_cast<int>(input_queue_.size() + blocked_jobs_.size()),
+              input_queue_capacity_);
+    InputQueueEntry entry = {job, priority, input_queue_sequence_++};
+    if (FLAG_block_concurrent_recompilation) {
+      // Keep the job away from running tasks until Unblock().
+      blocked_jobs_.push_back(entry);
+    } else {
+      input_queue_.push_back(entry);
+      std::push_heap(input_queue_.begin(), input_queue_.end(),
+                     InputQueueOrder());
+      post_task = ShouldPostTaskLocked();
+    }
   }
+  if (post_task) PostCompileTask();
 }
 
 void OptimizingCompileDispatcher::Unblock() {
-  while (blocked_jobs_ > 0) {
-    V8::GetCurrentPlatform()->CallOnBackgroundThread(
-        new CompileTask(isolate_, this), v8::Platform::kShortRunningTask);
-    blocked_jobs_--;
+  int tasks_to_post = 0;
+  {
+    base::LockGuard<base::Mutex> access_input_queue(&input_queue_mutex_);
+    for (const InputQueueEntry& entry : blocked_jobs_) {
+      input_queue_.push_back(entry);
+      std::push_heap(input_queue_.begin(), input_queue_.end(),
+                     InputQueueOrder());
+      if (ShouldPostTaskLocked()) tasks_to_post++;
+    }
+    blocked_jobs_.clear();
   }
+  for (int i = 0; i < tasks_to_post; i++) PostCompileTask();
+}
+
+bool OptimizingCompileDispatcher::ShouldPostTaskLocked() {
+  if (running_tasks_ >= max_running_tasks_) return false;
+  running_tasks_++;
+  return true;
+}
+
+void OptimizingCompileDispatcher::PostCompileTask() {
+  V8::GetCurrentPlatform()->CallOnBackgroundThread(
+      new CompileTask(isolate_, this), v8::Platform::kShortRunningTask);
 }
 
 }  // namespace internal
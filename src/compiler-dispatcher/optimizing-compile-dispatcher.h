@@ -5,7 +5,9 @@
 #ifndef V8_COMPILER_DISPATCHER_OPTIMIZING_COMPILE_DISPATCHER_H_
 #define V8_COMPILER_DISPATCHER_OPTIMIZING_COMPILE_DISPATCHER_H_
 
+#include <algorithm>
 #include <queue>
+#include <vector>
 
 #include "src/base/atomicops.h"
 #include "src/base/platform/condition-variable.h"
@@ -18,6 +20,7 @@
 namespace v8 {
 namespace internal {
 
+class CompilationInfo;
 class CompilationJob;
 class SharedFunctionInfo;
 
@@ -28,54 +31,83 @@ class V8_EXPORT_PRIVATE OptimizingCompileDispatcher {
   explicit OptimizingCompileDispatcher(Isolate* isolate)
       : isolate_(isolate),
         input_queue_capacity_(FLAG_concurrent_recompilation_queue_length),
-        input_queue_length_(0),
-        input_queue_shift_(0),
-        blocked_jobs_(0),
+        input_queue_sequence_(0),
+        running_tasks_(0),
+        max_running_tasks_(
+            std::max(1, FLAG_concurrent_recompilation_max_threads)),
         ref_count_(0),
         recompilation_delay_(FLAG_concurrent_recompilation_delay) {
     base::Relaxed_Store(&mode_, static_cast<base::AtomicWord>(COMPILE));
-    input_queue_ = NewArray<CompilationJob*>(input_queue_capacity_);
   }
 
   ~OptimizingCompileDispatcher();
 
   void Stop();
   void Flush(BlockingBehavior blocking_behavior);
-  // Takes ownership of |job|.
-  void QueueForOptimization(CompilationJob* job);
+  // Takes ownership of |job|. Pending jobs are handed to the background tasks
+  // in order of decreasing |priority|, and in FIFO order for equal priority.
+  void QueueForOptimization(CompilationJob* job, int priority = 0);
   void Unblock();
   void InstallOptimizedFunctions();
 
   inline bool IsQueueAvailable() {
     base::LockGuard<base::Mutex> access_input_queue(&input_queue_mutex_);
-    return input_queue_length_ < input_queue_capacity_;
+    return static_cast<int>(input_queue_.size() + blocked_jobs_.size()) <
+           input_queue_capacity_;
   }
 
   static bool Enabled() { return FLAG_concurrent_recompilation; }
 
+  // Returns the priority of the job compiling |info|, which is higher for
+  // functions the runtime profiler found hotter. Must be called on the main
+  // thread.
+  static int HotnessPriority(CompilationInfo* info);
+
  private:
   class CompileTask;
 
   enum ModeFlag { COMPILE, FLUSH };
 
+  struct InputQueueEntry {
+    CompilationJob* job;
+    int priority;
+    uint64_t sequence;
+  };
+
+  // Orders the input queue heap so that its front is the entry with the
+  // highest priority that was queued first.
+  struct InputQueueOrder {
+    bool operator()(const InputQueueEntry& a, const InputQueueEntry& b) const {
+      if (a.priority != b.priority) return a.priority < b.priority;
+      return a.sequence > b.sequence;
+    }
+  };
+
   void FlushOutputQueue(bool restore_function_code);
+  void FlushInputQueue();
   void CompileNext(CompilationJob* job);
-  CompilationJob* NextInput(bool check_if_flushing = false);
-
-  inline int InputQueueIndex(int i) {
-    int result = (i + input_queue_shift_) % input_queue_capacity_;
-    DCHECK_LE(0, result);
-    DCHECK_LT(result, input_queue_capacity_);
-    return result;
-  }
+  CompilationJob* NextInput();
+  // Returns the next job for a compile task. Returns nullptr and retires the
+  // calling task if there is no more work, disposing all pending jobs if the
+  // queues are being flushed.
+  CompilationJob* NextInputForTask();
+  // Returns true and accounts for a new compile task unless
+  // |max_running_tasks_| are already running. Must be called with
+  // |input_queue_mutex_| held.
+  bool ShouldPostTaskLocked();
+  void PostCompileTask();
 
   Isolate* isolate_;
 
-  // Circular queue of incoming recompilation tasks (including OSR).
-  CompilationJob** input_queue_;
+  // Binary heap of incoming recompilation tasks (including OSR), ordered by
+  // InputQueueOrder. It grows on demand up to |input_queue_capacity_|.
+  std::vector<InputQueueEntry> input_queue_;
   int input_queue_capacity_;
-  int input_queue_length_;
-  int input_queue_shift_;
+  uint64_t input_queue_sequence_;
+  // Number of compile tasks that have been posted and have not yet run out of
+  // work. Protected by |input_queue_mutex_|.
+  int running_tasks_;
+  int max_running_tasks_;
   base::Mutex input_queue_mutex_;
 
   // Queue of recompilation tasks ready to be installed (excluding OSR).
@@ -86,7 +118,9 @@ class V8_EXPORT_PRIVATE OptimizingCompileDispatcher {
 
   volatile base::AtomicWord mode_;
 
-  int blocked_jobs_;
+  // Jobs queued with --block-concurrent-recompilation. They are moved to the
+  // input queue by Unblock(). Protected by |input_queue_mutex_|.
+  std::vector<InputQueueEntry> blocked_jobs_;
 
   int ref_count_;
   base::Mutex ref_count_mutex_;
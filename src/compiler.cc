@@ -182,6 +182,9 @@ void CompilationJob::RecordOptimizedCompilationStats() const {
     int opt_count = function->shared()->opt_count();
     function->shared()->set_opt_count(opt_count + 1);
   }
+  if (FLAG_cache_optimization_hints) {
+    function->shared()->set_has_optimization_hint(true);
+  }
   double ms_creategraph = time_taken_to_prepare_.InMillisecondsF();
   double ms_optimize = time_taken_to_execute_.InMillisecondsF();
   double ms_codegen = time_taken_to_finalize_.InMillisecondsF();
@@ -607,6 +610,32 @@ bool CompileUnoptimizedInnerFunctions(
   return true;
 }
 
+// Enqueues the lazily compiled functions that the top-level code of the script
+// calls on the compiler dispatcher, so that they get parsed and compiled in the
+// background before their first call.
+void EnqueuePrecompileCandidates(CompilationInfo* info) {
+  ParseInfo* parse_info = info->parse_info();
+  Isolate* isolate = info->isolate();
+  CompilerDispatcher* dispatcher = isolate->compiler_dispatcher();
+  // Don't bother looking at the candidates if the dispatcher doesn't take any
+  // jobs, e.g. because of memory pressure.
+  if (parse_info->precompile_candidates().empty() ||
+      !dispatcher->CanEnqueue() || info->is_debug() || info->will_serialize()) {
+    return;
+  }
+  Handle<Script> script = info->script();
+  for (FunctionLiteral* literal : parse_info->precompile_candidates()) {
+    Handle<SharedFunctionInfo> shared;
+    if (!script->FindSharedFunctionInfo(isolate, literal).ToHandle(&shared) ||
+        shared->is_compiled() ||
+        UseAsmWasm(literal->scope(), shared, info->is_debug())) {
+      continue;
+    }
+    // The dispatcher may still refuse single functions, e.g. natives.
+    dispatcher->EnqueueAndStep(shared);
+  }
+}
+
 bool InnerFunctionIsAsmModule(
     ThreadedList<ThreadedListZoneEntry<FunctionLiteral*>>* literals) {
   for (auto it : *literals) {
@@ -852,7 +881,8 @@ bool GetOptimizedCodeLater(CompilationJob* job) {
                "V8.RecompileSynchronous");
 
   if (job->PrepareJob() != CompilationJob::SUCCEEDED) return false;
-  isolate->optimizing_compile_dispatcher()->QueueForOptimization(job);
+  isolate->optimizing_compile_dispatcher()->QueueForOptimization(
+      job, OptimizingCompileDispatcher::HotnessPriority(info));
   info->closure()->shared()->set_has_concurrent_optimization_job(true);
 
   if (FLAG_trace_concurrent_recompilation) {
@@ -888,11 +918,15 @@ MaybeHandle<Code> GetOptimizedCode(Handle<JSFunction> function,
     return cached_code;
   }
 
-  // Reset profiler ticks, function is no longer considered hot.
+  // Reset profiler ticks, function is no longer considered hot. The ticks
+  // are recorded on the compilation info below.
   DCHECK(shared->is_compiled());
+  int profiler_ticks = 0;
   if (shared->HasBaselineCode()) {
+    profiler_ticks = shared->code()->profiler_ticks();
     shared->code()->set_profiler_ticks(0);
   } else if (shared->HasBytecodeArray()) {
+    profiler_ticks = shared->profiler_ticks();
     shared->set_profiler_ticks(0);
   }
 
@@ -911,6 +945,7 @@ MaybeHandle<Code> GetOptimizedCode(Handle<JSFunction> function,
   ParseInfo* parse_info = info->parse_info();
 
   info->SetOptimizingForOsr(osr_ast_id, osr_frame);
+  info->set_profiler_ticks(profiler_ticks);
 
   // Do not use Crankshaft/TurboFan if we need to be able to set break points.
   if (info->shared_info()->HasBreakInfo()) {
@@ -1185,6 +1220,10 @@ Handle<SharedFunctionInfo> CompileToplevel(CompilationInfo* info) {
       return Handle<SharedFunctionInfo>::null();
     }
 
+    if (FLAG_compiler_dispatcher_precompile) {
+      EnqueuePrecompileCandidates(info);
+    }
+
     Handle<String> script_name =
         script->name()->IsString()
             ? Handle<String>(String::cast(script->name()))
@@ -4,6 +4,9 @@
 
 #include "src/compiler/instruction-scheduler.h"
 
+#include "src/base/cpu.h"
+#include "src/base/once.h"
+
 namespace v8 {
 namespace internal {
 namespace compiler {
@@ -175,9 +178,88 @@ int InstructionScheduler::GetTargetInstructionFlags(
 }
 
 
-int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
-  // Basic latency modeling for arm64 instructions. They have been determined
-  // in an empirical way.
+namespace {
+
+// Latency model of an arm64 core. All values are in cycles. They are rounded
+// from the cores' software optimization guides and are meant to rank
+// instructions, not to predict exact timings.
+struct Arm64LatencyModel {
+  int issue_width;
+  int alu;
+  int alu_shifted;  // ALU operation with a shifted or extended operand.
+  int load;
+  int checked_load;
+  int store;
+  int mul32;
+  int mul64;
+  int div32;
+  int div64;
+  int float_add;  // Also covers sub.
+  int float_misc;  // Abs, neg and cmp.
+  int float32_div;  // Also covers sqrt.
+  int float64_div;  // Also covers sqrt.
+  int float_round;
+  int float_convert;
+  int other;
+};
+
+const Arm64LatencyModel kModels[] = {
+    // The generic model keeps the empirical values that were used before
+    // per-core models existed.
+    {1, 1, 3, 11, 5, 1, 3, 5, 12, 20, 5, 3, 12, 19, 5, 5, 2},
+    // In-order dual-issue cores (Cortex-A53, Cortex-A55).
+    {2, 1, 2, 3, 4, 1, 3, 4, 8, 12, 4, 4, 10, 19, 4, 4, 1},
+    // Out-of-order three-wide cores (Cortex-A57, Cortex-A72, Cortex-A73).
+    {3, 1, 2, 4, 5, 1, 3, 5, 12, 20, 4, 3, 11, 18, 5, 5, 1},
+};
+const int kCortexA53Model = 1;
+const int kCortexA57Model = 2;
+
+int host_latency_model = InstructionScheduler::kGenericLatencyModel;
+base::OnceType init_host_latency_model_once = V8_ONCE_INIT;
+
+void InitHostLatencyModel() {
+  base::CPU cpu;
+  if (cpu.implementer() != base::CPU::ARM) return;
+  switch (cpu.part()) {
+    case base::CPU::ARM_CORTEX_A53:
+    case base::CPU::ARM_CORTEX_A55:
+      host_latency_model = kCortexA53Model;
+      break;
+    case base::CPU::ARM_CORTEX_A57:
+    case base::CPU::ARM_CORTEX_A72:
+    case base::CPU::ARM_CORTEX_A73:
+      host_latency_model = kCortexA57Model;
+      break;
+    default:
+      break;
+  }
+}
+
+const Arm64LatencyModel* GetLatencyModel(int model) {
+  DCHECK_LE(0, model);
+  DCHECK_LT(model, static_cast<int>(arraysize(kModels)));
+  return &kModels[model];
+}
+
+}  // namespace
+
+int InstructionScheduler::LatencyModelCount() {
+  return static_cast<int>(arraysize(kModels));
+}
+
+int InstructionScheduler::HostLatencyModel() {
+  base::CallOnce(&init_host_latency_model_once, &InitHostLatencyModel);
+  return host_latency_model;
+}
+
+int InstructionScheduler::GetIssueWidth(int model) {
+  return GetLatencyModel(model)->issue_width;
+}
+
+int InstructionScheduler::GetInstructionLatency(const Instruction* instr,
+                                                int model_index) {
+  const Arm64LatencyModel* model = GetLatencyModel(model_index);
   switch (instr->arch_opcode()) {
     case kArm64Add:
     case kArm64Add32:
@@ -204,9 +286,9 @@ int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
     case kArm64Tst:
     case kArm64Tst32:
       if (instr->addressing_mode() != kMode_None) {
-        return 3;
+        return model->alu_shifted;
       } else {
-        return 1;
+        return model->alu;
       }
 
     case kArm64Clz:
@@ -218,7 +300,7 @@ int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
     case kArm64Ubfiz32:
     case kArm64Ubfx:
     case kArm64Ubfx32:
-      return 1;
+      return model->alu;
 
     case kArm64Lsl:
     case kArm64Lsl32:
@@ -228,7 +310,7 @@ int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
     case kArm64Asr32:
     case kArm64Ror:
     case kArm64Ror32:
-      return 1;
+      return model->alu;
 
     case kArm64Ldr:
     case kArm64LdrD:
@@ -239,7 +321,7 @@ int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
     case kArm64Ldrsb:
     case kArm64Ldrsh:
     case kArm64Ldrsw:
-      return 11;
+      return model->load;
 
     case kCheckedLoadInt8:
     case kCheckedLoadUint8:
@@ -249,7 +331,7 @@ int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
     case kCheckedLoadWord64:
     case kCheckedLoadFloat32:
     case kCheckedLoadFloat64:
-      return 5;
+      return model->checked_load;
 
     case kArm64Str:
     case kArm64StrD:
@@ -257,7 +339,7 @@ int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
     case kArm64StrW:
     case kArm64Strb:
     case kArm64Strh:
-      return 1;
+      return model->store;
 
     case kCheckedStoreWord8:
     case kCheckedStoreWord16:
@@ -265,33 +347,33 @@ int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
     case kCheckedStoreWord64:
     case kCheckedStoreFloat32:
     case kCheckedStoreFloat64:
-      return 1;
+      return model->store;
 
     case kArm64Madd32:
     case kArm64Mneg32:
     case kArm64Msub32:
     case kArm64Mul32:
-      return 3;
+      return model->mul32;
 
     case kArm64Madd:
     case kArm64Mneg:
     case kArm64Msub:
     case kArm64Mul:
-      return 5;
+      return model->mul64;
 
     case kArm64Idiv32:
     case kArm64Udiv32:
-      return 12;
+      return model->div32;
 
     case kArm64Idiv:
     case kArm64Udiv:
-      return 20;
+      return model->div64;
 
     case kArm64Float32Add:
     case kArm64Float32Sub:
     case kArm64Float64Add:
     case kArm64Float64Sub:
-      return 5;
+      return model->float_add;
 
     case kArm64Float32Abs:
     case kArm64Float32Cmp:
@@ -299,15 +381,15 @@ int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
     case kArm64Float64Abs:
     case kArm64Float64Cmp:
     case kArm64Float64Neg:
-      return 3;
+      return model->float_misc;
 
     case kArm64Float32Div:
     case kArm64Float32Sqrt:
-      return 12;
+      return model->float32_div;
 
     case kArm64Float64Div:
     case kArm64Float64Sqrt:
-      return 19;
+      return model->float64_div;
 
     case kArm64Float32RoundDown:
     case kArm64Float32RoundTiesEven:
@@ -318,7 +400,7 @@ int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
     case kArm64Float64RoundTiesEven:
     case kArm64Float64RoundTruncate:
     case kArm64Float64RoundUp:
-      return 5;
+      return model->float_round;
 
     case kArm64Float32ToFloat64:
     case kArm64Float64ToFloat32:
@@ -334,10 +416,10 @@ int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
     case kArm64Uint32ToFloat64:
     case kArm64Uint64ToFloat32:
     case kArm64Uint64ToFloat64:
-      return 5;
+      return model->float_convert;
 
     default:
-      return 2;
+      return model->other;
   }
 }
 
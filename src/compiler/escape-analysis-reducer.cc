@@ -72,6 +72,11 @@ Reduction EscapeAnalysisReducer::ReduceNode(Node* node) {
             depends_on_object_state =
                 depends_on_object_state || escape_analysis()->IsVirtual(input);
             break;
+          case IrOpcode::kPhi:
+            depends_on_object_state =
+                depends_on_object_state ||
+                escape_analysis()->IsVirtualObjectPhi(input);
+            break;
           case IrOpcode::kFrameState:
           case IrOpcode::kStateValues:
             depends_on_object_state =
@@ -360,7 +365,8 @@ Node* EscapeAnalysisReducer::ReduceStateValueInput(Node* node, int node_index,
         input->op()->mnemonic());
   Node* clone = nullptr;
   if (input->opcode() == IrOpcode::kFinishRegion ||
-      input->opcode() == IrOpcode::kAllocate) {
+      input->opcode() == IrOpcode::kAllocate ||
+      escape_analysis()->IsVirtualObjectPhi(input)) {
     if (escape_analysis()->IsVirtual(input)) {
       if (escape_analysis()->IsCyclicObjectState(effect, input)) {
         // TODO(mstarzinger): Represent cyclic object states differently to
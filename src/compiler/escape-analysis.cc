@@ -62,6 +62,7 @@ class EscapeStatusAnalysis : public ZoneObject {
   bool IsVirtual(Node* node);
   bool IsEscaped(Node* node);
   bool IsAllocation(Node* node);
+  bool IsObjectPhi(Node* node);
 
   bool IsInQueue(NodeId id);
   void SetInQueue(NodeId id, bool on_stack);
@@ -106,6 +107,8 @@ class EscapeStatusAnalysis : public ZoneObject {
   bool HasEntry(Node* node);
 
   bool IsAllocationPhi(Node* node);
+  bool IsObjectPhiCandidate(Node* node);
+  bool IsObservedAfter(Node* node, Node* effect_phi, Node* stop);
 
   ZoneVector<Node*> stack_;
   EscapeAnalysis* object_analysis_;
@@ -114,6 +117,7 @@ class EscapeStatusAnalysis : public ZoneObject {
   Alias next_free_alias_;
   ZoneVector<Node*> status_stack_;
   ZoneVector<Alias> aliases_;
+  Zone* const zone_;
 
   DISALLOW_COPY_AND_ASSIGN(EscapeStatusAnalysis);
 };
@@ -279,6 +283,9 @@ class VirtualState : public ZoneObject {
   bool UpdateFrom(VirtualState* state, Zone* zone);
   bool MergeFrom(MergeCache* cache, Zone* zone, Graph* graph,
                  CommonOperatorBuilder* common, Node* at);
+  bool MergeObjectPhiFrom(MergeCache* cache, Alias alias, NodeId id,
+                          Zone* zone, Graph* graph,
+                          CommonOperatorBuilder* common, Node* at);
   size_t size() const { return info_.size(); }
   Node* owner() const { return owner_; }
   VirtualObject* Copy(VirtualObject* obj, Alias alias);
@@ -299,7 +306,7 @@ class VirtualState : public ZoneObject {
 class MergeCache : public ZoneObject {
  public:
   explicit MergeCache(Zone* zone)
-      : states_(zone), objects_(zone), fields_(zone) {
+      : states_(zone), objects_(zone), fields_(zone), phi_aliases_(zone) {
     states_.reserve(5);
     objects_.reserve(5);
     fields_.reserve(5);
@@ -307,10 +314,13 @@ class MergeCache : public ZoneObject {
   ZoneVector<VirtualState*>& states() { return states_; }
   ZoneVector<VirtualObject*>& objects() { return objects_; }
   ZoneVector<Node*>& fields() { return fields_; }
+  // Aliases of object phis at the merge, which are merged separately.
+  ZoneVector<Alias>& phi_aliases() { return phi_aliases_; }
   void Clear() {
     states_.clear();
     objects_.clear();
     fields_.clear();
+    phi_aliases_.clear();
   }
   size_t LoadVirtualObjectsFromStatesFor(Alias alias);
   void LoadVirtualObjectsForFieldsFrom(VirtualState* state,
@@ -321,6 +331,7 @@ class MergeCache : public ZoneObject {
   ZoneVector<VirtualState*> states_;
   ZoneVector<VirtualObject*> objects_;
   ZoneVector<Node*> fields_;
+  ZoneVector<Alias> phi_aliases_;
 
   DISALLOW_COPY_AND_ASSIGN(MergeCache);
 };
@@ -513,6 +524,10 @@ bool VirtualState::MergeFrom(MergeCache* cache, Zone* zone, Graph* graph,
   DCHECK_GT(cache->states().size(), 0u);
   bool changed = false;
   for (Alias alias = 0; alias < size(); ++alias) {
+    if (std::find(cache->phi_aliases().begin(), cache->phi_aliases().end(),
+                  alias) != cache->phi_aliases().end()) {
+      continue;
+    }
     cache->objects().clear();
     VirtualObject* mergeObject = VirtualObjectFromAlias(alias);
     bool copy_merge_object = false;
@@ -569,6 +584,51 @@ bool VirtualState::MergeFrom(MergeCache* cache, Zone* zone, Graph* graph,
   return changed;
 }
 
+// Merges the objects in {cache}, one per merged state, into the object of
+// the object phi {id} with alias {alias}. The objects are distinct
+// allocations, so unlike in {MergeFrom} they are not looked up by {alias}.
+bool VirtualState::MergeObjectPhiFrom(MergeCache* cache, Alias alias,
+                                      NodeId id, Zone* zone, Graph* graph,
+                                      CommonOperatorBuilder* common,
+                                      Node* at) {
+  VirtualObject* mergeObject = VirtualObjectFromAlias(alias);
+  bool mergeable = cache->objects().size() == cache->states().size() &&
+                   (mergeObject || !initialized_.Contains(alias));
+  for (VirtualObject* obj : cache->objects()) {
+    if (obj->field_count() != cache->objects().front()->field_count()) {
+      mergeable = false;
+    }
+  }
+  if (!mergeable) {
+    if (mergeObject) {
+      TRACE("  Object phi #%d, virtual object removed\n", id);
+      SetVirtualObject(alias, nullptr);
+      return true;
+    }
+    return false;
+  }
+  bool changed = false;
+  bool initialMerge = false;
+  size_t fields = cache->objects().front()->field_count();
+  if (!mergeObject) {
+    initialMerge = true;
+    mergeObject = new (zone) VirtualObject(id, this, zone, fields, true);
+    SetVirtualObject(alias, mergeObject);
+    changed = true;
+  } else if (std::find(cache->objects().begin(), cache->objects().end(),
+                       mergeObject) != cache->objects().end()) {
+    mergeObject = new (zone) VirtualObject(this, *mergeObject);
+    SetVirtualObject(alias, mergeObject);
+    changed = true;
+  } else {
+    changed = mergeObject->ResizeFields(fields) || changed;
+  }
+  TRACE("  Object phi #%d, merging into %p\n", id,
+        static_cast<void*>(mergeObject));
+  return mergeObject->MergeFrom(cache, at, graph, common, initialMerge) ||
+         changed;
+}
+
 EscapeStatusAnalysis::EscapeStatusAnalysis(EscapeAnalysis* object_analysis,
                                            Graph* graph, Zone* zone)
     : stack_(zone),
@@ -577,7 +637,8 @@ EscapeStatusAnalysis::EscapeStatusAnalysis(EscapeAnalysis* object_analysis,
       status_(zone),
       next_free_alias_(0),
       status_stack_(zone),
-      aliases_(zone) {}
+      aliases_(zone),
+      zone_(zone) {}
 
 bool EscapeStatusAnalysis::HasEntry(Node* node) {
   return status_[node->id()] & (kTracked | kEscaped);
@@ -600,6 +661,13 @@ bool EscapeStatusAnalysis::IsAllocation(Node* node) {
          node->opcode() == IrOpcode::kFinishRegion;
 }
 
+// Object phis are phis over allocations that are scalar replaced as a whole,
+// see {IsObjectPhiCandidate}. They are the only phis that get an alias.
+bool EscapeStatusAnalysis::IsObjectPhi(Node* node) {
+  return node->opcode() == IrOpcode::kPhi && node->id() < aliases_.size() &&
+         aliases_[node->id()] < kUntrackable;
+}
+
 bool EscapeStatusAnalysis::SetEscaped(Node* node) {
   bool changed = !(status_[node->id()] & kEscaped);
   status_[node->id()] |= kEscaped | kTracked;
@@ -714,13 +782,27 @@ void EscapeStatusAnalysis::Process(Node* node) {
         RevisitInputs(node);
         RevisitUses(node);
       }
-      CheckUsesForEscape(node);
+      if (CheckUsesForEscape(node, IsObjectPhi(node))) {
+        RevisitInputs(node);
+        RevisitUses(node);
+      }
     default:
       break;
   }
 }
 
 bool EscapeStatusAnalysis::IsAllocationPhi(Node* node) {
+  if (IsObjectPhi(node)) {
+    // An object phi stays virtual only as long as all of its inputs do.
+    for (int i = 0; i < node->op()->ValueInputCount(); ++i) {
+      Node* input = NodeProperties::GetValueInput(node, i);
+      if (IsEscaped(input)) return false;
+      if (input->opcode() == IrOpcode::kPhi && !IsObjectPhi(input)) {
+        return false;
+      }
+    }
+    return true;
+  }
   for (Edge edge : node->input_edges()) {
     Node* input = edge.to();
     if (input->opcode() == IrOpcode::kPhi && !IsEscaped(input)) continue;
@@ -788,7 +870,7 @@ bool EscapeStatusAnalysis::CheckUsesForEscape(Node* uses, Node* rep,
       continue;
     switch (use->opcode()) {
       case IrOpcode::kPhi:
-        if (phi_escaping && SetEscaped(rep)) {
+        if (phi_escaping && !IsObjectPhi(use) && SetEscaped(rep)) {
           TRACE(
               "Setting #%d (%s) to escaped because of use by phi node "
               "#%d (%s)\n",
@@ -882,6 +964,11 @@ void EscapeStatusAnalysis::ProcessFinishRegion(Node* node) {
     status_[node->id()] |= kTracked;
     RevisitUses(node);
   }
+  if (FLAG_turbo_escape_loop_phis &&
+      IsEscaped(NodeProperties::GetValueInput(node, 0)) && SetEscaped(node)) {
+    // Object phis using this region have to learn about the escape.
+    RevisitUses(node);
+  }
   if (CheckUsesForEscape(node, true)) {
     RevisitInputs(node);
     RevisitUses(node);
@@ -973,6 +1060,15 @@ void EscapeStatusAnalysis::AssignAliases() {
         }
         break;
       }
+      case IrOpcode::kPhi:
+        if (aliases_[node->id()] >= kUntrackable &&
+            IsObjectPhiCandidate(node)) {
+          aliases_[node->id()] = NextAlias();
+          TRACE(" @%d:%s#%u", aliases_[node->id()], node->op()->mnemonic(),
+                node->id());
+          EnqueueForStatusAnalysis(node);
+        }
+        break;
       default:
         DCHECK_EQ(aliases_[node->id()], kUntrackable);
         break;
@@ -988,6 +1084,126 @@ void EscapeStatusAnalysis::AssignAliases() {
   TRACE("\n");
 }
 
+namespace {
+
+// Returns true if {node} is only read from, map checked or captured by frame
+// states, apart from at most one use by a phi, which has to be {phi} unless
+// that is null. Objects like this cannot be mutated or compared for identity
+// after construction, so merging them into a single virtual object at a phi
+// is safe.
+bool HasOnlyReadUses(Node* node, Node* phi) {
+  int phi_uses = 0;
+  for (Edge edge : node->use_edges()) {
+    if (!NodeProperties::IsValueEdge(edge)) continue;
+    Node* use = edge.from();
+    switch (use->opcode()) {
+      case IrOpcode::kLoadField:
+      case IrOpcode::kLoadElement:
+      case IrOpcode::kCheckMaps:
+        if (edge.index() != 0) return false;
+        break;
+      case IrOpcode::kFrameState:
+      case IrOpcode::kStateValues:
+        break;
+      case IrOpcode::kPhi:
+        if ((phi != nullptr && use != phi) || ++phi_uses > 1) return false;
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+Node* FindEffectPhi(Node* phi) {
+  Node* control = NodeProperties::GetControlInput(phi);
+  for (Node* use : control->uses()) {
+    if (use->opcode() == IrOpcode::kEffectPhi) return use;
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+// Returns true if a frame state capturing {node} is used on an effect path
+// that starts at {effect_phi} without passing through {stop}. A deopt there
+// would materialize {node} separately from a phi merging it at
+// {effect_phi}, even though both can refer to the same object.
+bool EscapeStatusAnalysis::IsObservedAfter(Node* node, Node* effect_phi,
+                                           Node* stop) {
+  ZoneSet<Node*> states(zone_);
+  ZoneVector<Node*> users(zone_);
+  ZoneVector<Node*> worklist(zone_);
+  worklist.push_back(node);
+  while (!worklist.empty()) {
+    Node* current = worklist.back();
+    worklist.pop_back();
+    for (Edge edge : current->use_edges()) {
+      if (!NodeProperties::IsValueEdge(edge) &&
+          !NodeProperties::IsFrameStateEdge(edge)) {
+        continue;
+      }
+      Node* use = edge.from();
+      if (use->opcode() == IrOpcode::kFrameState ||
+          use->opcode() == IrOpcode::kStateValues) {
+        if (states.insert(use).second) worklist.push_back(use);
+      } else if (current != node) {
+        if (use->op()->EffectInputCount() == 0) return true;
+        users.push_back(use);
+      }
+    }
+  }
+  if (users.empty()) return false;
+  ZoneSet<Node*> reached(zone_);
+  worklist.push_back(effect_phi);
+  while (!worklist.empty()) {
+    Node* current = worklist.back();
+    worklist.pop_back();
+    for (Edge edge : current->use_edges()) {
+      if (!NodeProperties::IsEffectEdge(edge)) continue;
+      Node* use = edge.from();
+      if (use != stop && reached.insert(use).second) worklist.push_back(use);
+    }
+  }
+  for (Node* user : users) {
+    if (reached.count(user)) return true;
+  }
+  return false;
+}
+
+// A tagged phi over allocations (or other object phis) is scalar replaced as
+// an object of its own if the merged objects are immutable after
+// construction, are not used by any other phi and are never captured in a
+// frame state together with the phi.
+bool EscapeStatusAnalysis::IsObjectPhiCandidate(Node* node) {
+  DCHECK_EQ(IrOpcode::kPhi, node->opcode());
+  if (!FLAG_turbo_escape_loop_phis ||
+      PhiRepresentationOf(node->op()) != MachineRepresentation::kTagged) {
+    return false;
+  }
+  Node* effect_phi = FindEffectPhi(node);
+  if (effect_phi == nullptr || !HasOnlyReadUses(node, nullptr)) return false;
+  for (int i = 0; i < node->op()->ValueInputCount(); ++i) {
+    Node* input = NodeProperties::GetValueInput(node, i);
+    Node* stop = nullptr;
+    if (input->opcode() == IrOpcode::kFinishRegion) {
+      Node* allocate = NodeProperties::GetValueInput(input, 0);
+      if (allocate->opcode() != IrOpcode::kAllocate ||
+          !NumberMatcher(allocate->InputAt(0)).HasValue()) {
+        return false;
+      }
+      stop = input;
+    } else if (input->opcode() == IrOpcode::kPhi) {
+      stop = FindEffectPhi(input);
+    }
+    if (stop == nullptr || !HasOnlyReadUses(input, node) ||
+        IsObservedAfter(input, effect_phi, stop)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool EscapeStatusAnalysis::IsNotReachable(Node* node) {
   if (node->id() >= aliases_.size()) {
     return false;
@@ -1327,9 +1543,24 @@ bool EscapeAnalysis::ProcessEffectPhi(Node* node) {
     return changed;
   }
 
+  Node* control = NodeProperties::GetControlInput(node);
+  for (Node* use : control->uses()) {
+    if (status_analysis_->IsObjectPhi(use)) {
+      cache_->phi_aliases().push_back(status_analysis_->GetAlias(use->id()));
+    }
+  }
+
   changed =
       mergeState->MergeFrom(cache_, zone(), graph(), common(), node) || changed;
 
+  if (!cache_->phi_aliases().empty()) {
+    for (Node* use : control->uses()) {
+      if (status_analysis_->IsObjectPhi(use)) {
+        changed = ProcessObjectPhi(use, node, mergeState) || changed;
+      }
+    }
+  }
+
   TRACE("Merge %s the node.\n", changed ? "changed" : "did not change");
 
   if (changed) {
@@ -1338,6 +1569,33 @@ bool EscapeAnalysis::ProcessEffectPhi(Node* node) {
   return changed;
 }
 
+bool EscapeAnalysis::ProcessObjectPhi(Node* node, Node* effect_phi,
+                                      VirtualState* state) {
+  DCHECK_EQ(node->opcode(), IrOpcode::kPhi);
+  cache_->objects().clear();
+  for (int i = 0; i < effect_phi->op()->EffectInputCount(); ++i) {
+    Node* effect = NodeProperties::GetEffectInput(effect_phi, i);
+    VirtualState* input_state = virtual_states_[effect->id()];
+    if (!input_state) continue;
+    Node* input = ResolveReplacement(NodeProperties::GetValueInput(node, i));
+    VirtualObject* obj = GetVirtualObject(input_state, input);
+    if (!obj || !obj->IsTracked() || !obj->IsInitialized()) {
+      cache_->objects().clear();
+      break;
+    }
+    cache_->objects().push_back(obj);
+  }
+  Alias alias = status_analysis_->GetAlias(node->id());
+  bool changed = state->MergeObjectPhiFrom(cache_, alias, node->id(), zone(),
+                                           graph(), common(), effect_phi);
+  if (!state->VirtualObjectFromAlias(alias) &&
+      status_analysis_->SetEscaped(node)) {
+    TRACE("Setting #%d (%s) to escaped because its inputs cannot be merged\n",
+          node->id(), node->op()->mnemonic());
+  }
+  return changed;
+}
+
 void EscapeAnalysis::ProcessAllocation(Node* node) {
   DCHECK_EQ(node->opcode(), IrOpcode::kAllocate);
   ForwardVirtualState(node);
@@ -1512,7 +1770,9 @@ void EscapeAnalysis::ProcessCheckMaps(Node* node) {
   DCHECK_EQ(node->opcode(), IrOpcode::kCheckMaps);
   ForwardVirtualState(node);
   Node* checked = ResolveReplacement(NodeProperties::GetValueInput(node, 0));
-  if (FLAG_turbo_experimental) {
+  // Object phis are always map checked before use, so they cannot stay
+  // virtual unless these checks are folded.
+  if (FLAG_turbo_experimental || status_analysis_->IsObjectPhi(checked)) {
     VirtualState* state = virtual_states_[node->id()];
     if (VirtualObject* object = GetVirtualObject(state, checked)) {
       if (!object->IsTracked()) {
@@ -1668,9 +1928,10 @@ void EscapeAnalysis::ProcessStoreElement(Node* node) {
 }
 
 Node* EscapeAnalysis::GetOrCreateObjectState(Node* effect, Node* node) {
-  if ((node->opcode() == IrOpcode::kFinishRegion ||
-       node->opcode() == IrOpcode::kAllocate) &&
-      IsVirtual(node)) {
+  if (((node->opcode() == IrOpcode::kFinishRegion ||
+        node->opcode() == IrOpcode::kAllocate) &&
+       IsVirtual(node)) ||
+      IsVirtualObjectPhi(node)) {
     if (VirtualObject* vobj = GetVirtualObject(virtual_states_[effect->id()],
                                                ResolveReplacement(node))) {
       if (Node* object_state = vobj->GetObjectState()) {
@@ -1713,9 +1974,10 @@ Node* EscapeAnalysis::GetOrCreateObjectState(Node* effect, Node* node) {
 }
 
 bool EscapeAnalysis::IsCyclicObjectState(Node* effect, Node* node) {
-  if ((node->opcode() == IrOpcode::kFinishRegion ||
-       node->opcode() == IrOpcode::kAllocate) &&
-      IsVirtual(node)) {
+  if (((node->opcode() == IrOpcode::kFinishRegion ||
+        node->opcode() == IrOpcode::kAllocate) &&
+       IsVirtual(node)) ||
+      IsVirtualObjectPhi(node)) {
     if (VirtualObject* vobj = GetVirtualObject(virtual_states_[effect->id()],
                                                ResolveReplacement(node))) {
       if (cycle_detection_.find(vobj) != cycle_detection_.end()) return true;
@@ -1733,6 +1995,10 @@ bool EscapeAnalysis::IsCyclicObjectState(Node* effect, Node* node) {
   return false;
 }
 
+bool EscapeAnalysis::IsVirtualObjectPhi(Node* node) {
+  return IsVirtual(node) && status_analysis_->IsObjectPhi(node);
+}
+
 void EscapeAnalysis::DebugPrintState(VirtualState* state) {
   PrintF("Dumping virtual state %p\n", static_cast<void*>(state));
   for (Alias alias = 0; alias < status_analysis_->AliasCount(); ++alias) {
@@ -35,6 +35,7 @@ class V8_EXPORT_PRIVATE EscapeAnalysis {
   bool CompareVirtualObjects(Node* left, Node* right);
   Node* GetOrCreateObjectState(Node* effect, Node* node);
   bool IsCyclicObjectState(Node* effect, Node* node);
+  bool IsVirtualObjectPhi(Node* node);
   bool ExistsVirtualAllocate();
   bool SetReplacement(Node* node, Node* rep);
   bool AllObjectsComplete();
@@ -53,6 +54,7 @@ class V8_EXPORT_PRIVATE EscapeAnalysis {
   void ProcessCall(Node* node);
   void ProcessStart(Node* node);
   bool ProcessEffectPhi(Node* node);
+  bool ProcessObjectPhi(Node* node, Node* effect_phi, VirtualState* state);
 
   void ForwardVirtualState(Node* node);
   VirtualState* CopyForModificationAt(VirtualState* state, Node* node);
@@ -146,7 +146,8 @@ int InstructionScheduler::GetTargetInstructionFlags(
 }
 
 
-int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
+int InstructionScheduler::GetInstructionLatency(const Instruction* instr,
+                                                int model) {
   // Basic latency modeling for ia32 instructions. They have been determined
   // in an empirical way.
   switch (instr->arch_opcode()) {
@@ -215,6 +216,12 @@ int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
   }
 }
 
+int InstructionScheduler::GetIssueWidth(int model) { return 1; }
+
+int InstructionScheduler::LatencyModelCount() { return 1; }
+
+int InstructionScheduler::HostLatencyModel() { return kGenericLatencyModel; }
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
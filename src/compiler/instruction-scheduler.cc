@@ -6,6 +6,7 @@
 
 #include "src/base/adapters.h"
 #include "src/base/utils/random-number-generator.h"
+#include "src/isolate.h"
 
 namespace v8 {
 namespace internal {
@@ -61,11 +62,12 @@ InstructionScheduler::StressSchedulerQueue::PopBestCandidate(int cycle) {
 
 InstructionScheduler::ScheduleGraphNode::ScheduleGraphNode(
     Zone* zone,
-    Instruction* instr)
+    Instruction* instr,
+    int latency)
     : instr_(instr),
       successors_(zone),
       unscheduled_predecessors_count_(0),
-      latency_(GetInstructionLatency(instr)),
+      latency_(latency),
       total_latency_(-1),
       start_cycle_(-1) {
 }
@@ -86,7 +88,11 @@ InstructionScheduler::InstructionScheduler(Zone* zone,
       pending_loads_(zone),
       last_live_in_reg_marker_(nullptr),
       last_deopt_or_trap_(nullptr),
-      operands_map_(zone) {}
+      operands_map_(zone) {
+  // Snapshots must not depend on the machine that built them.
+  latency_model_ = isolate()->serializer_enabled() ? kGenericLatencyModel
+                                                   : HostLatencyModel();
+}
 
 void InstructionScheduler::StartBlock(RpoNumber rpo) {
   DCHECK(graph_.empty());
@@ -116,7 +122,9 @@ void InstructionScheduler::EndBlock(RpoNumber rpo) {
 
 
 void InstructionScheduler::AddInstruction(Instruction* instr) {
-  ScheduleGraphNode* new_node = new (zone()) ScheduleGraphNode(zone(), instr);
+  ScheduleGraphNode* new_node = new (zone())
+      ScheduleGraphNode(zone(), instr,
+                        GetInstructionLatency(instr, latency_model_));
 
   if (IsBlockTerminator(instr)) {
     // Make sure that basic block terminators are not moved by adding them
@@ -210,8 +218,11 @@ void InstructionScheduler::ScheduleBlock() {
     }
   }
 
-  // Go through the ready list and schedule the instructions.
+  // Go through the ready list and schedule the instructions. Up to
+  // |issue_width| ready instructions are issued in the same cycle.
+  const int issue_width = GetIssueWidth(latency_model_);
   int cycle = 0;
+  int issued_in_cycle = 0;
   while (!ready_list.IsEmpty()) {
     ScheduleGraphNode* candidate = ready_list.PopBestCandidate(cycle);
 
@@ -228,9 +239,12 @@ void InstructionScheduler::ScheduleBlock() {
           ready_list.AddNode(successor);
         }
       }
+
+      if (++issued_in_cycle < issue_width) continue;
     }
 
     cycle++;
+    issued_in_cycle = 0;
   }
 }
 
@@ -39,12 +39,26 @@ class InstructionScheduler final : public ZoneObject {
 
   static bool SchedulerSupported();
 
+  // Each target has LatencyModelCount() instruction latency models, which
+  // describe the latencies and issue width of families of cores. The generic
+  // model does not depend on the host and is used when building a snapshot.
+  static const int kGenericLatencyModel = 0;
+  static int LatencyModelCount();
+  // Returns the latency model that fits the host best.
+  static int HostLatencyModel();
+
+  static int GetInstructionLatency(const Instruction* instr, int model);
+
+  // Return the number of instructions the target core can start executing in
+  // the same cycle.
+  static int GetIssueWidth(int model);
+
  private:
   // A scheduling graph node.
   // Represent an instruction and their dependencies.
   class ScheduleGraphNode: public ZoneObject {
    public:
-    ScheduleGraphNode(Zone* zone, Instruction* instr);
+    ScheduleGraphNode(Zone* zone, Instruction* instr, int latency);
 
     // Mark the instruction represented by 'node' as a dependecy of this one.
     // The current instruction will be registered as an unscheduled predecessor
@@ -198,8 +212,6 @@ class InstructionScheduler final : public ZoneObject {
 
   void ComputeTotalLatencies();
 
-  static int GetInstructionLatency(const Instruction* instr);
-
   Zone* zone() { return zone_; }
   InstructionSequence* sequence() { return sequence_; }
   Isolate* isolate() { return sequence()->isolate(); }
@@ -208,6 +220,9 @@ class InstructionScheduler final : public ZoneObject {
   InstructionSequence* sequence_;
   ZoneVector<ScheduleGraphNode*> graph_;
 
+  // The latency model used for this sequence.
+  int latency_model_;
+
   // Last side effect instruction encountered while building the graph.
   ScheduleGraphNode* last_side_effect_instr_;
 
@@ -112,6 +112,7 @@ Reduction JSInliningHeuristic::Reduce(Node* node) {
     candidate.can_inline_function[i] = CanInlineFunction(shared);
     if (candidate.can_inline_function[i]) {
       can_inline = true;
+      candidate.size += shared->ast_node_count();
     }
     if (!IsSmallInlineFunction(shared)) {
       small_inline = false;
@@ -172,6 +173,10 @@ Reduction JSInliningHeuristic::Reduce(Node* node) {
   if (small_inline && cumulative_count_ <= FLAG_max_inlined_nodes_absolute) {
     TRACE("Inlining small function(s) at call site #%d:%s\n", node->id(),
           node->op()->mnemonic());
+    if (FLAG_turbo_profile_guided_inlining &&
+        FLAG_trace_turbo_inlining_decisions) {
+      PrintDecision(candidate, "inline-small");
+    }
     return InlineCandidate(candidate, true);
   }
 
@@ -189,16 +194,41 @@ void JSInliningHeuristic::Finalize() {
   // on things that aren't called very often.
   // TODO(bmeurer): Use std::priority_queue instead of std::set here.
   while (!candidates_.empty()) {
-    if (cumulative_count_ > FLAG_max_inlined_nodes_cumulative) return;
+    if (!FLAG_turbo_profile_guided_inlining &&
+        cumulative_count_ > FLAG_max_inlined_nodes_cumulative) {
+      return;
+    }
     auto i = candidates_.begin();
     Candidate candidate = *i;
     candidates_.erase(i);
     // Make sure we don't try to inline dead candidate nodes.
-    if (!candidate.node->IsDead()) {
-      Reduction const reduction = InlineCandidate(candidate, false);
-      if (reduction.Changed()) return;
+    if (candidate.node->IsDead()) continue;
+    // In profile-guided mode every candidate gets its own share of the
+    // budget, so a candidate that doesn't fit doesn't stop colder but
+    // smaller candidates from being inlined.
+    if (FLAG_turbo_profile_guided_inlining) {
+      bool const fits =
+          cumulative_count_ + candidate.size <= CumulativeBudget(candidate);
+      if (FLAG_trace_turbo_inlining_decisions) {
+        PrintDecision(candidate, fits ? "inline" : "over-budget");
+      }
+      if (!fits) continue;
     }
+    Reduction const reduction = InlineCandidate(candidate, false);
+    if (reduction.Changed()) return;
+  }
+}
+
+int JSInliningHeuristic::CumulativeBudget(Candidate const& candidate) const {
+  if (!FLAG_turbo_profile_guided_inlining || candidate.frequency.IsUnknown()) {
+    return FLAG_max_inlined_nodes_cumulative;
   }
+  // A call site that is hit once per invocation of the function gets the
+  // regular budget.
+  double const budget =
+      FLAG_max_inlined_nodes_cumulative * candidate.frequency.value();
+  return static_cast<int>(
+      std::min(budget, static_cast<double>(FLAG_max_inlined_nodes_absolute)));
 }
 
 Reduction JSInliningHeuristic::InlineCandidate(Candidate const& candidate,
@@ -296,7 +326,7 @@ Reduction JSInliningHeuristic::InlineCandidate(Candidate const& candidate,
     Node* node = calls[i];
     if (force_inline ||
         (candidate.can_inline_function[i] &&
-         cumulative_count_ < FLAG_max_inlined_nodes_cumulative)) {
+         cumulative_count_ < CumulativeBudget(candidate))) {
       Reduction const reduction = inliner_.ReduceJSCall(node);
       if (reduction.Changed()) {
         // Killing the call node is not strictly necessary, but it is safer to
@@ -322,6 +352,12 @@ bool JSInliningHeuristic::CandidateCompare::operator()(
     return true;
   } else if (left.frequency.IsUnknown()) {
     return false;
+  } else if (FLAG_turbo_profile_guided_inlining) {
+    // Prefer the candidate with the most calls per inlined AST node.
+    float const left_score = left.frequency.value() / std::max(left.size, 1);
+    float const right_score = right.frequency.value() / std::max(right.size, 1);
+    if (left_score != right_score) return left_score > right_score;
+    return left.node->id() > right.node->id();
   } else if (left.frequency.value() > right.frequency.value()) {
     return true;
   } else if (left.frequency.value() < right.frequency.value()) {
@@ -349,6 +385,37 @@ void JSInliningHeuristic::PrintCandidates() {
   }
 }
 
+void JSInliningHeuristic::PrintDecision(Candidate const& candidate,
+                                        const char* decision) {
+  OFStream os(stdout);
+  os << "{\"decision\":\"" << decision << "\",\"call_site\":"
+     << candidate.node->id() << ",\"operator\":\""
+     << candidate.node->op()->mnemonic() << "\",\"frequency\":";
+  if (candidate.frequency.IsKnown()) {
+    os << candidate.frequency.value();
+  } else {
+    os << "null";
+  }
+  os << ",\"size\":" << candidate.size << ",\"cumulative\":"
+     << cumulative_count_ << ",\"budget\":" << CumulativeBudget(candidate)
+     << ",\"targets\":[";
+  for (int i = 0; i < candidate.num_functions; ++i) {
+    Handle<SharedFunctionInfo> shared =
+        candidate.functions[i].is_null()
+            ? candidate.shared_info
+            : handle(candidate.functions[i]->shared());
+    std::unique_ptr<char[]> name = shared->DebugName()->ToCString();
+    os << (i == 0 ? "" : ",") << "{\"name\":\"";
+    for (const char* c = name.get(); *c != '\0'; ++c) {
+      if (*c == '"' || *c == '\\') os << '\\';
+      os << *c;
+    }
+    os << "\",\"size\":" << shared->ast_node_count() << ",\"inlineable\":"
+       << (candidate.can_inline_function[i] ? "true" : "false") << "}";
+  }
+  os << "]}" << std::endl;
+}
+
 Graph* JSInliningHeuristic::graph() const { return jsgraph()->graph(); }
 
 CommonOperatorBuilder* JSInliningHeuristic::common() const {
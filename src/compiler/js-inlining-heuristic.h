@@ -48,6 +48,7 @@ class JSInliningHeuristic final : public AdvancedReducer {
     int num_functions;
     Node* node = nullptr;     // The call site at which to inline.
     CallFrequency frequency;  // Relative frequency of this call site.
+    int size = 0;  // Number of AST nodes of the functions that can be inlined.
   };
 
   // Comparator for candidates.
@@ -60,8 +61,16 @@ class JSInliningHeuristic final : public AdvancedReducer {
 
   // Dumps candidates to console.
   void PrintCandidates();
+  // Prints the inlining {decision} for {candidate} as a single line of JSON.
+  void PrintDecision(Candidate const& candidate, const char* decision);
   Reduction InlineCandidate(Candidate const& candidate, bool force_inline);
 
+  // Returns the maximum cumulative number of AST nodes inlined into this
+  // function up to which {candidate} may still be inlined. In profile-guided
+  // mode this scales with the frequency of the call site, so that hot call
+  // sites get a bigger share of the budget than cold ones.
+  int CumulativeBudget(Candidate const& candidate) const;
+
   CommonOperatorBuilder* common() const;
   Graph* graph() const;
   JSGraph* jsgraph() const { return jsgraph_; }
@@ -0,0 +1,239 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/loop-invariant-code-motion.h"
+
+#include "src/compiler/common-operator.h"
+#include "src/compiler/graph.h"
+#include "src/compiler/js-graph.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/node.h"
+#include "src/compiler/types.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+#define TRACE(...)                                  \
+  do {                                              \
+    if (FLAG_trace_turbo_loop) PrintF(__VA_ARGS__); \
+  } while (false)
+
+LoopInvariantCodeMotion::LoopInvariantCodeMotion(JSGraph* jsgraph,
+                                                 LoopTree* loop_tree,
+                                                 Zone* temp_zone)
+    : jsgraph_(jsgraph), loop_tree_(loop_tree), temp_zone_(temp_zone) {}
+
+void LoopInvariantCodeMotion::Run() {
+  for (LoopTree::Loop* loop : loop_tree_->outer_loops()) VisitLoop(loop);
+}
+
+void LoopInvariantCodeMotion::VisitLoop(LoopTree::Loop* loop) {
+  // Visit inner loops first, they are the hot ones.
+  for (LoopTree::Loop* inner_loop : loop->children()) VisitLoop(inner_loop);
+  EliminateBoundsChecks(loop);
+  HoistHeaderNodes(loop);
+}
+
+void LoopInvariantCodeMotion::EliminateBoundsChecks(LoopTree::Loop* loop) {
+  for (Node* node : loop_tree_->LoopNodes(loop)) {
+    if (node->opcode() != IrOpcode::kCheckBounds) continue;
+    if (node->IsDead() || loop_tree_->ContainingLoop(node) != loop) continue;
+    Node* index = NodeProperties::GetValueInput(node, 0);
+    Node* length = NodeProperties::GetValueInput(node, 1);
+    if (!NodeProperties::IsTyped(node) || !NodeProperties::IsTyped(index)) {
+      continue;
+    }
+    // A non-negative integer {index} that is known to be less than {length}
+    // is in bounds; typically {index} is an induction variable and the check
+    // sits in the body of a loop that runs while {index} < {length}.
+    if (!NodeProperties::GetType(index)->Is(Type::Unsigned32())) continue;
+    Node* control = NodeProperties::GetControlInput(node);
+    if (!IsDominatedByLessThan(control, index, length)) continue;
+
+    TRACE("Eliminating bounds check #%d in loop of #%d\n", node->id(),
+          loop_tree_->HeaderNode(loop)->id());
+    // Keep the narrowed type of the index for representation selection.
+    Type* type = NodeProperties::GetType(node);
+    Node* guard = graph()->NewNode(common()->TypeGuard(type), index, control);
+    NodeProperties::SetType(guard, type);
+    NodeProperties::ReplaceUses(node, guard,
+                                NodeProperties::GetEffectInput(node));
+    node->Kill();
+  }
+}
+
+bool LoopInvariantCodeMotion::IsDominatedByLessThan(Node* control, Node* index,
+                                                    Node* length) {
+  // Walk up the chain of single-predecessor control nodes; anything found on
+  // the way dominates {control}.
+  while (control->op()->ControlInputCount() == 1) {
+    if (control->opcode() == IrOpcode::kIfTrue) {
+      Node* branch = NodeProperties::GetControlInput(control);
+      Node* condition = NodeProperties::GetValueInput(branch, 0);
+      switch (condition->opcode()) {
+        case IrOpcode::kNumberLessThan:
+        case IrOpcode::kSpeculativeNumberLessThan:
+          if (NodeProperties::GetValueInput(condition, 0) == index &&
+              NodeProperties::GetValueInput(condition, 1) == length) {
+            return true;
+          }
+          break;
+        default:
+          break;
+      }
+    }
+    if (control->opcode() == IrOpcode::kLoop ||
+        control->opcode() == IrOpcode::kMerge) {
+      break;
+    }
+    control = NodeProperties::GetControlInput(control);
+  }
+  return false;
+}
+
+void LoopInvariantCodeMotion::HoistHeaderNodes(LoopTree::Loop* loop) {
+  Node* loop_control = loop_tree_->GetLoopControl(loop);
+  Node* effect_phi = nullptr;
+  for (Node* use : loop_control->uses()) {
+    if (use->opcode() != IrOpcode::kEffectPhi) continue;
+    if (effect_phi != nullptr) return;
+    effect_phi = use;
+  }
+  if (effect_phi == nullptr || !HasNoMapOrFieldWrites(loop)) return;
+
+  Node* const entry_effect = effect_phi->InputAt(kAssumedLoopEntryIndex);
+  Node* const entry_control = loop_control->InputAt(kAssumedLoopEntryIndex);
+  Node* preheader_effect = nullptr;
+  ZoneSet<Node*> hoisted(temp_zone_);
+
+  Node* effect = effect_phi;
+  Node* control = loop_control;
+  while (true) {
+    // Find the unique successor of {effect} on the effect chain, ignoring the
+    // Terminate node of the loop.
+    Node* next = nullptr;
+    int count = 0;
+    for (Edge edge : effect->use_edges()) {
+      if (!NodeProperties::IsEffectEdge(edge)) continue;
+      if (edge.from()->opcode() == IrOpcode::kTerminate) continue;
+      next = edge.from();
+      count++;
+    }
+    if (count != 1) break;
+    // Stop at the first branch or call in the loop.
+    if (next->op()->ControlInputCount() != 1 ||
+        NodeProperties::GetControlInput(next) != control) {
+      break;
+    }
+    if (next->opcode() == IrOpcode::kCheckpoint) {
+      effect = next;
+      continue;
+    }
+    if (next->opcode() == IrOpcode::kJSStackCheck) {
+      // The stack check is part of every loop header; it neither writes nor
+      // guards anything, so look past it.
+      effect = control = next;
+      for (Node* use : next->uses()) {
+        if (use->opcode() == IrOpcode::kIfSuccess) control = use;
+      }
+      continue;
+    }
+    // Everything after a node that stays in the loop might depend on it
+    // (i.e. a field load on a map check), so stop there.
+    if (!CanHoist(next) || !IsInvariant(loop, next, hoisted)) break;
+
+    if (preheader_effect == nullptr) {
+      Node* frame_state = FindFrameStateBefore(entry_effect);
+      if (frame_state == nullptr) break;
+      preheader_effect = graph()->NewNode(common()->Checkpoint(), frame_state,
+                                          entry_effect, entry_control);
+    }
+
+    TRACE("Hoisting #%d:%s out of loop of #%d\n", next->id(),
+          next->op()->mnemonic(), loop_control->id());
+    // Unlink {next} from the loop header's effect chain...
+    for (Edge edge : next->use_edges()) {
+      if (NodeProperties::IsEffectEdge(edge)) edge.UpdateTo(effect);
+    }
+    // ...and append it to the effect chain of the preheader.
+    NodeProperties::ReplaceEffectInput(next, preheader_effect);
+    NodeProperties::ReplaceControlInput(next, entry_control);
+    preheader_effect = next;
+    hoisted.insert(next);
+  }
+
+  if (preheader_effect != nullptr) {
+    effect_phi->ReplaceInput(kAssumedLoopEntryIndex, preheader_effect);
+  }
+}
+
+bool LoopInvariantCodeMotion::HasNoMapOrFieldWrites(LoopTree::Loop* loop) {
+  for (Node* node : loop_tree_->LoopNodes(loop)) {
+    if (node->IsDead() || node->op()->EffectOutputCount() == 0) continue;
+    if (node->op()->HasProperty(Operator::kNoWrite)) continue;
+    switch (node->opcode()) {
+      case IrOpcode::kCheckpoint:
+      case IrOpcode::kEffectPhi:
+      case IrOpcode::kLoopExitEffect:
+      // Element stores write into backing stores only.
+      case IrOpcode::kStoreElement:
+      case IrOpcode::kStoreTypedElement:
+        continue;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+bool LoopInvariantCodeMotion::IsInvariant(LoopTree::Loop* loop, Node* node,
+                                          ZoneSet<Node*> const& hoisted) {
+  for (int i = 0; i < node->op()->ValueInputCount(); ++i) {
+    Node* input = NodeProperties::GetValueInput(node, i);
+    if (loop_tree_->Contains(loop, input) && hoisted.count(input) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// static
+bool LoopInvariantCodeMotion::CanHoist(Node* node) {
+  switch (node->opcode()) {
+    case IrOpcode::kCheckBounds:
+    case IrOpcode::kCheckHeapObject:
+    case IrOpcode::kCheckMaps:
+    case IrOpcode::kLoadField:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// static
+Node* LoopInvariantCodeMotion::FindFrameStateBefore(Node* effect) {
+  // Deoptimizing to a checkpoint is fine as long as there are no observable
+  // writes between the checkpoint and the deoptimization point.
+  while (effect->op()->EffectInputCount() == 1) {
+    if (effect->opcode() == IrOpcode::kCheckpoint) {
+      return NodeProperties::GetFrameStateInput(effect);
+    }
+    if (!effect->op()->HasProperty(Operator::kNoWrite)) break;
+    effect = NodeProperties::GetEffectInput(effect);
+  }
+  return nullptr;
+}
+
+CommonOperatorBuilder* LoopInvariantCodeMotion::common() const {
+  return jsgraph_->common();
+}
+
+Graph* LoopInvariantCodeMotion::graph() const { return jsgraph_->graph(); }
+
+#undef TRACE
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,63 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_LOOP_INVARIANT_CODE_MOTION_H_
+#define V8_COMPILER_LOOP_INVARIANT_CODE_MOTION_H_
+
+#include "src/compiler/loop-analysis.h"
+#include "src/globals.h"
+#include "src/zone/zone-containers.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+// Forward declarations.
+class CommonOperatorBuilder;
+class JSGraph;
+
+// Moves checks and field loads out of loops that cannot change maps or
+// fields, and removes bounds checks that are implied by the loop condition.
+//
+// Only nodes on the effect chain of the loop header, i.e. the nodes that are
+// executed on every entry into the loop before its first branch, are hoisted,
+// so no check is ever executed speculatively. Hoisted checks deoptimize to
+// the last checkpoint before the loop, which is re-inserted at the preheader.
+class V8_EXPORT_PRIVATE LoopInvariantCodeMotion final {
+ public:
+  LoopInvariantCodeMotion(JSGraph* jsgraph, LoopTree* loop_tree,
+                          Zone* temp_zone);
+
+  void Run();
+
+ private:
+  void VisitLoop(LoopTree::Loop* loop);
+
+  // Bounds check elimination based on dominating index < length branches.
+  void EliminateBoundsChecks(LoopTree::Loop* loop);
+  bool IsDominatedByLessThan(Node* control, Node* index, Node* length);
+
+  // Loop invariant code motion for the loop header.
+  void HoistHeaderNodes(LoopTree::Loop* loop);
+  bool HasNoMapOrFieldWrites(LoopTree::Loop* loop);
+  bool IsInvariant(LoopTree::Loop* loop, Node* node,
+                   ZoneSet<Node*> const& hoisted);
+  static bool CanHoist(Node* node);
+  static Node* FindFrameStateBefore(Node* effect);
+
+  CommonOperatorBuilder* common() const;
+  Graph* graph() const;
+
+  JSGraph* const jsgraph_;
+  LoopTree* const loop_tree_;
+  Zone* const temp_zone_;
+
+  DISALLOW_COPY_AND_ASSIGN(LoopInvariantCodeMotion);
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_LOOP_INVARIANT_CODE_MOTION_H_
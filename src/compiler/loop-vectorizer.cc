@@ -0,0 +1,656 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/loop-vectorizer.h"
+
+#include "src/compiler/common-operator.h"
+#include "src/compiler/graph.h"
+#include "src/compiler/js-graph.h"
+#include "src/compiler/linkage.h"
+#include "src/compiler/machine-operator.h"
+#include "src/compiler/node-matchers.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/node.h"
+#include "src/compiler/simplified-operator.h"
+#include "src/runtime/runtime.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+#define TRACE(...)                                  \
+  do {                                              \
+    if (FLAG_trace_turbo_loop) PrintF(__VA_ARGS__); \
+  } while (false)
+
+namespace {
+
+// Number of int32 lanes in a 128-bit vector.
+const int kLanes = kSimd128Size / kInt32Size;
+
+bool IsInt32TypedArrayAccess(Node* node) {
+  ElementAccess const& access = ElementAccessOf(node->op());
+  return access.base_is_tagged == kUntaggedBase && access.header_size == 0 &&
+         access.machine_type.representation() == MachineRepresentation::kWord32;
+}
+
+bool IsVectorizableBinop(Node* node) {
+  switch (node->opcode()) {
+    case IrOpcode::kInt32Add:
+    case IrOpcode::kInt32Sub:
+    case IrOpcode::kWord32And:
+    case IrOpcode::kWord32Or:
+    case IrOpcode::kWord32Xor:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool IsStateNode(Node* node) {
+  switch (node->opcode()) {
+    case IrOpcode::kFrameState:
+    case IrOpcode::kStateValues:
+    case IrOpcode::kTypedStateValues:
+    case IrOpcode::kObjectState:
+    case IrOpcode::kTypedObjectState:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+LoopVectorizer::LoopVectorizer(JSGraph* jsgraph, LoopTree* loop_tree,
+                               Zone* temp_zone)
+    : jsgraph_(jsgraph), loop_tree_(loop_tree), temp_zone_(temp_zone) {}
+
+void LoopVectorizer::Run() {
+  // The vector loop computes 64-bit offsets from the induction variable.
+  if (!machine()->Is64()) return;
+  for (LoopTree::Loop* loop : loop_tree_->outer_loops()) VisitLoop(loop);
+}
+
+void LoopVectorizer::VisitLoop(LoopTree::Loop* loop) {
+  if (!loop->children().empty()) {
+    for (LoopTree::Loop* inner_loop : loop->children()) VisitLoop(inner_loop);
+    return;
+  }
+  Candidate candidate(temp_zone_);
+  candidate.loop = loop;
+  if (MatchLoop(&candidate)) Vectorize(&candidate);
+}
+
+bool LoopVectorizer::MatchLoop(Candidate* candidate) {
+  LoopTree::Loop* const loop = candidate->loop;
+  Node* const loop_control = loop_tree_->GetLoopControl(loop);
+  if (loop_control->InputCount() != 2) return false;
+  for (Node* node : loop_tree_->ExitNodes(loop)) {
+    if (!node->IsDead()) return false;
+  }
+  candidate->loop_control = loop_control;
+
+  // The loop must carry exactly one effect and the induction variable.
+  for (Node* use : loop_control->uses()) {
+    if (use->opcode() == IrOpcode::kEffectPhi) {
+      if (candidate->effect_phi != nullptr) return false;
+      candidate->effect_phi = use;
+    } else if (use->opcode() == IrOpcode::kPhi) {
+      if (candidate->induction != nullptr) return false;
+      if (PhiRepresentationOf(use->op()) != MachineRepresentation::kWord32) {
+        return false;
+      }
+      candidate->induction = use;
+    }
+  }
+  if (candidate->effect_phi == nullptr || candidate->induction == nullptr) {
+    return false;
+  }
+  Node* const induction = candidate->induction;
+  Int32BinopMatcher increment(induction->InputAt(1));
+  if (increment.opcode() != IrOpcode::kInt32Add ||
+      increment.left().node() != induction || !increment.right().Is(1)) {
+    return false;
+  }
+
+  // The only way out of the loop is the i < n branch.
+  Node* exit = nullptr;
+  for (Node* node : loop_tree_->LoopNodes(loop)) {
+    for (Edge edge : node->use_edges()) {
+      if (!NodeProperties::IsControlEdge(edge)) continue;
+      Node* const user = edge.from();
+      if (user->opcode() == IrOpcode::kTerminate) continue;
+      if (loop_tree_->Contains(loop, user)) continue;
+      if (exit != nullptr || user->opcode() != IrOpcode::kIfFalse) {
+        return false;
+      }
+      exit = user;
+    }
+  }
+  if (exit == nullptr) return false;
+  Node* const branch = NodeProperties::GetControlInput(exit);
+  Int32BinopMatcher condition(NodeProperties::GetValueInput(branch, 0));
+  if (condition.opcode() != IrOpcode::kInt32LessThan ||
+      condition.left().node() != induction ||
+      !IsInvariant(candidate, condition.right().node())) {
+    return false;
+  }
+  candidate->limit = condition.right().node();
+
+  Node* if_true = nullptr;
+  for (Node* use : branch->uses()) {
+    if (use->opcode() == IrOpcode::kIfTrue) if_true = use;
+  }
+  if (if_true == nullptr) return false;
+
+  ZoneSet<Node*> body_effects(temp_zone_);
+  return MatchBody(if_true, candidate, &body_effects) &&
+         HeaderHasNoSideEffects(candidate, body_effects) &&
+         MatchStackCheck(candidate);
+}
+
+bool LoopVectorizer::MatchBody(Node* if_true, Candidate* candidate,
+                               ZoneSet<Node*>* body_effects) {
+  Node* const induction = candidate->induction;
+
+  // The body must be straight-line code, guarded only by bounds checks on
+  // the induction variable. Diamonds that cannot write anything, i.e. the
+  // stack check, are skipped.
+  ZoneSet<Node*> body_controls(temp_zone_);
+  Node* control = candidate->loop_control->InputAt(1);
+  while (control != if_true) {
+    body_controls.insert(control);
+    if (control->opcode() == IrOpcode::kMerge) {
+      Node* branch = MatchSideEffectFreeDiamond(control);
+      if (branch == nullptr) return false;
+      control = NodeProperties::GetControlInput(branch);
+      continue;
+    }
+    if (control->opcode() != IrOpcode::kDeoptimizeUnless) return false;
+    Uint32BinopMatcher check(NodeProperties::GetValueInput(control, 0));
+    if (check.opcode() != IrOpcode::kUint32LessThan ||
+        check.left().node() != induction ||
+        !IsInvariant(candidate, check.right().node())) {
+      return false;
+    }
+    candidate->lengths.push_back(check.right().node());
+    control = NodeProperties::GetControlInput(control);
+  }
+  body_controls.insert(if_true);
+
+  // Walk the effect chain of the body backwards; all loads must come before
+  // the single store.
+  Node* effect = candidate->effect_phi->InputAt(1);
+  while (effect != candidate->effect_phi) {
+    if (effect->opcode() != IrOpcode::kRetain &&
+        (effect->op()->ControlInputCount() != 1 ||
+         body_controls.count(NodeProperties::GetControlInput(effect)) == 0)) {
+      break;
+    }
+    switch (effect->opcode()) {
+      case IrOpcode::kDeoptimizeIf:
+        return false;
+      case IrOpcode::kUnsafePointerAdd:
+        if (!IsInvariant(candidate, effect->InputAt(0)) ||
+            !IsInvariant(candidate, effect->InputAt(1))) {
+          return false;
+        }
+        break;
+      case IrOpcode::kLoadElement:
+        if (candidate->store != nullptr) return false;
+        if (!MatchAccess(effect, candidate)) return false;
+        candidate->loads.push_back(effect);
+        break;
+      case IrOpcode::kStoreElement:
+        if (candidate->store != nullptr) return false;
+        if (!MatchAccess(effect, candidate)) return false;
+        candidate->store = effect;
+        break;
+      default:
+        // Bounds checks, stack checks, field loads and the like.
+        if (!effect->op()->HasProperty(Operator::kNoWrite)) return false;
+        break;
+    }
+    body_effects->insert(effect);
+    effect = NodeProperties::GetEffectInput(effect);
+  }
+  if (candidate->store == nullptr) return false;
+
+  // The stored value must be computed element-wise from the loads and loop
+  // invariant values, and none of these may be needed for anything but
+  // deoptimization of the original loop.
+  ZoneSet<Node*> values(temp_zone_);
+  if (!MatchValue(NodeProperties::GetValueInput(candidate->store, 2),
+                  candidate, &values)) {
+    return false;
+  }
+  values.insert(candidate->store);
+  for (Node* value : values) {
+    if (value == candidate->store || IsInvariant(candidate, value)) continue;
+    if (!HasOnlyDeoptimizationUses(value, values)) return false;
+  }
+  for (Node* load : candidate->loads) {
+    if (!HasOnlyDeoptimizationUses(load, values)) return false;
+  }
+  return true;
+}
+
+Node* LoopVectorizer::MatchSideEffectFreeDiamond(Node* merge) {
+  // Match the diamond of a lowered stack check, whose slow path only contains
+  // calls that don't write anything; returns the branch.
+  if (merge->InputCount() != 2) return nullptr;
+  for (Node* use : merge->uses()) {
+    if (use->opcode() == IrOpcode::kPhi) return nullptr;
+  }
+  Node* const if_true = merge->InputAt(0);
+  if (if_true->opcode() != IrOpcode::kIfTrue) return nullptr;
+  Node* const branch = NodeProperties::GetControlInput(if_true);
+  Node* control = merge->InputAt(1);
+  while (control->opcode() != IrOpcode::kIfFalse) {
+    if (control->opcode() != IrOpcode::kIfSuccess &&
+        (control->opcode() != IrOpcode::kCall ||
+         !control->op()->HasProperty(Operator::kNoWrite))) {
+      return nullptr;
+    }
+    control = NodeProperties::GetControlInput(control);
+  }
+  return NodeProperties::GetControlInput(control) == branch ? branch : nullptr;
+}
+
+bool LoopVectorizer::MatchAccess(Node* node, Candidate const* candidate) {
+  if (!IsInt32TypedArrayAccess(node)) return false;
+  if (NodeProperties::GetValueInput(node, 1) != candidate->induction) {
+    return false;
+  }
+  Node* const storage = NodeProperties::GetValueInput(node, 0);
+  return storage->opcode() == IrOpcode::kUnsafePointerAdd ||
+         IsInvariant(candidate, storage);
+}
+
+bool LoopVectorizer::MatchValue(Node* node, Candidate const* candidate,
+                                ZoneSet<Node*>* visited) {
+  if (!visited->insert(node).second) return true;
+  if (IsInvariant(candidate, node)) return true;
+  if (node->opcode() == IrOpcode::kLoadElement) {
+    return std::find(candidate->loads.begin(), candidate->loads.end(), node) !=
+           candidate->loads.end();
+  }
+  if (!IsVectorizableBinop(node)) return false;
+  return MatchValue(node->InputAt(0), candidate, visited) &&
+         MatchValue(node->InputAt(1), candidate, visited);
+}
+
+bool LoopVectorizer::MatchStackCheck(Candidate* candidate) {
+  // Find the runtime call of the lowered JSStackCheck, so that the vector loop
+  // can check for interrupts the same way.
+  ExternalReference const stack_guard(Runtime::kStackGuard,
+                                      jsgraph()->isolate());
+  for (Node* node : loop_tree_->LoopNodes(candidate->loop)) {
+    if (node->opcode() != IrOpcode::kCall) continue;
+    if (!ExternalReferenceMatcher(node->InputAt(1)).Is(stack_guard)) continue;
+    if (candidate->stack_check != nullptr) return false;
+    candidate->stack_check = node;
+  }
+  Node* const call = candidate->stack_check;
+  if (call == nullptr) return true;
+  // The runtime call takes the context as its last argument and the frame
+  // state right behind it.
+  CallDescriptor const* const descriptor = CallDescriptorOf(call->op());
+  if (!descriptor->NeedsFrameState()) return false;
+  int const frame_state_index = static_cast<int>(descriptor->InputCount());
+  Node* const context = call->InputAt(frame_state_index - 1);
+  if (loop_tree_->Contains(candidate->loop, context)) return false;
+  return MatchState(candidate, call->InputAt(frame_state_index));
+}
+
+bool LoopVectorizer::MatchState(Candidate const* candidate, Node* node) {
+  // The frame state of the stack check may only depend on the induction
+  // variable and on values defined outside of the loop.
+  if (node == candidate->induction) return true;
+  if (!loop_tree_->Contains(candidate->loop, node)) return true;
+  if (node->op()->EffectInputCount() != 0 ||
+      node->op()->ControlInputCount() != 0) {
+    return false;
+  }
+  for (Node* input : node->inputs()) {
+    if (!MatchState(candidate, input)) return false;
+  }
+  return true;
+}
+
+bool LoopVectorizer::IsInvariant(Candidate const* candidate, Node* node) {
+  if (!loop_tree_->Contains(candidate->loop, node)) return true;
+  if (node->opcode() == IrOpcode::kLoadField) {
+    // Nothing in a vectorizable loop writes to fields, so loading a field of
+    // an invariant object yields the same value in every iteration.
+    return IsInvariant(candidate, NodeProperties::GetValueInput(node, 0));
+  }
+  if (node->op()->EffectInputCount() != 0 ||
+      node->op()->ControlInputCount() != 0) {
+    return false;
+  }
+  for (Node* input : node->inputs()) {
+    if (!IsInvariant(candidate, input)) return false;
+  }
+  return true;
+}
+
+bool LoopVectorizer::HasOnlyDeoptimizationUses(Node* node,
+                                               ZoneSet<Node*> const& values) {
+  for (Edge edge : node->use_edges()) {
+    if (!NodeProperties::IsValueEdge(edge)) continue;
+    Node* const use = edge.from();
+    if (values.count(use) != 0 || IsStateNode(use)) continue;
+    // Allow conversions that only feed into frame states.
+    if (use->op()->EffectOutputCount() != 0 ||
+        use->op()->ControlOutputCount() != 0) {
+      return false;
+    }
+    for (Node* state : use->uses()) {
+      if (!IsStateNode(state)) return false;
+    }
+  }
+  return true;
+}
+
+bool LoopVectorizer::HeaderHasNoSideEffects(
+    Candidate const* candidate, ZoneSet<Node*> const& body_effects) {
+  // The vector loop skips everything in the loop besides the body, i.e. the
+  // stack check; that is only fine if none of it can be observed.
+  for (Node* node : loop_tree_->LoopNodes(candidate->loop)) {
+    if (node->op()->EffectOutputCount() == 0) continue;
+    if (body_effects.count(node) != 0) continue;
+    switch (node->opcode()) {
+      case IrOpcode::kDeoptimizeIf:
+      case IrOpcode::kDeoptimizeUnless:
+        return false;
+      default:
+        if (!node->op()->HasProperty(Operator::kNoWrite)) return false;
+        break;
+    }
+  }
+  return true;
+}
+
+void LoopVectorizer::Vectorize(Candidate* candidate) {
+  TRACE("Vectorizing loop of #%d\n", candidate->loop_control->id());
+  Node* const loop = candidate->loop_control;
+  Node* const effect_phi = candidate->effect_phi;
+  Node* const induction = candidate->induction;
+  Node* const entry_control = loop->InputAt(0);
+
+  // Load the invariant fields the vector loop needs before entering it.
+  Node* effect = effect_phi->InputAt(0);
+  Node* const limit =
+      CopyInvariant(candidate, candidate->limit, &effect, entry_control);
+  ZoneVector<Node*> lengths(temp_zone_);
+  for (Node* length : candidate->lengths) {
+    lengths.push_back(CopyInvariant(candidate, length, &effect, entry_control));
+  }
+  ZoneVector<Node*> accesses(candidate->loads);
+  accesses.push_back(candidate->store);
+  for (Node* access : accesses) {
+    Node* storage = NodeProperties::GetValueInput(access, 0);
+    if (storage->opcode() == IrOpcode::kUnsafePointerAdd) {
+      CopyInvariant(candidate, storage->InputAt(0), &effect, entry_control);
+      CopyInvariant(candidate, storage->InputAt(1), &effect, entry_control);
+    } else {
+      CopyInvariant(candidate, storage, &effect, entry_control);
+    }
+  }
+
+  Node* vector_loop =
+      graph()->NewNode(common()->Loop(2), entry_control, entry_control);
+  Node* vector_effect_phi =
+      graph()->NewNode(common()->EffectPhi(2), effect, effect, vector_loop);
+  Node* vector_induction = graph()->NewNode(
+      common()->Phi(MachineRepresentation::kWord32, 2), induction->InputAt(0),
+      induction->InputAt(0), vector_loop);
+
+  // Check for interrupts first, then compute the storage pointers in the loop
+  // header, so that nothing can move the underlying arrays before they are
+  // used.
+  effect = vector_effect_phi;
+  Node* const header =
+      BuildStackCheck(candidate, vector_induction, &effect, vector_loop);
+  Node* store_storage =
+      VectorStorage(candidate, candidate->store, &effect, header);
+
+  // Run an iteration only if the original loop would run the next {kLanes}
+  // iterations without deoptimizing, i.e. if 0 <= i, i + 3 < n and i + 3 is
+  // less than all the lengths it checks against (unsigned).
+  Node* const i = vector_induction;
+  Node* const last = jsgraph()->Int32Constant(kLanes - 1);
+  Node* check = graph()->NewNode(
+      machine()->Word32And(),
+      graph()->NewNode(machine()->Int32LessThanOrEqual(),
+                       jsgraph()->Int32Constant(0), i),
+      graph()->NewNode(machine()->Int32LessThan(), i, limit));
+  check = graph()->NewNode(
+      machine()->Word32And(), check,
+      graph()->NewNode(machine()->Int32LessThan(), last,
+                       graph()->NewNode(machine()->Int32Sub(), limit, i)));
+  for (Node* length : lengths) {
+    check = graph()->NewNode(
+        machine()->Word32And(), check,
+        graph()->NewNode(machine()->Uint32LessThan(), i, length));
+    check = graph()->NewNode(
+        machine()->Word32And(), check,
+        graph()->NewNode(machine()->Uint32LessThan(), last,
+                         graph()->NewNode(machine()->Int32Sub(), length, i)));
+  }
+
+  // Also make sure that storing a vector cannot change the elements loaded
+  // for it, i.e. the store either starts at or before the loads, or behind
+  // the loaded vectors.
+  for (Node* load : candidate->loads) {
+    Node* load_storage = VectorStorage(candidate, load, &effect, header);
+    if (load_storage == store_storage) continue;
+    Node* distance =
+        graph()->NewNode(machine()->IntSub(), store_storage, load_storage);
+    check = graph()->NewNode(
+        machine()->Word32And(), check,
+        graph()->NewNode(
+            machine()->Word32Or(),
+            graph()->NewNode(machine()->IntLessThanOrEqual(), distance,
+                             jsgraph()->IntPtrConstant(0)),
+            graph()->NewNode(machine()->IntLessThanOrEqual(),
+                             jsgraph()->IntPtrConstant(kSimd128Size),
+                             distance)));
+  }
+  Node* const exit_effect = effect;
+
+  Node* branch = graph()->NewNode(common()->Branch(), check, header);
+  Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+  Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+
+  // Compute the stored vector and store it.
+  Node* offset = graph()->NewNode(
+      machine()->Word64Shl(),
+      graph()->NewNode(machine()->ChangeUint32ToUint64(), i),
+      jsgraph()->Int64Constant(
+          ElementSizeLog2Of(MachineRepresentation::kWord32)));
+  Node* value = VectorizeValue(
+      candidate, NodeProperties::GetValueInput(candidate->store, 2), offset,
+      &effect, if_true);
+  effect = graph()->NewNode(
+      machine()->Store(StoreRepresentation(MachineRepresentation::kSimd128,
+                                           kNoWriteBarrier)),
+      store_storage, offset, value, effect, if_true);
+
+  vector_loop->ReplaceInput(1, if_true);
+  vector_effect_phi->ReplaceInput(1, effect);
+  vector_induction->ReplaceInput(
+      1, graph()->NewNode(machine()->Int32Add(), i,
+                          jsgraph()->Int32Constant(kLanes)));
+
+  // The original loop handles the remaining iterations.
+  loop->ReplaceInput(0, if_false);
+  effect_phi->ReplaceInput(0, exit_effect);
+  induction->ReplaceInput(0, vector_induction);
+}
+
+Node* LoopVectorizer::BuildStackCheck(Candidate* candidate, Node* induction,
+                                      Node** effect, Node* control) {
+  Node* const call = candidate->stack_check;
+  if (call == nullptr) return control;
+
+  // Same as the lowering of JSStackCheck, with the runtime call of the
+  // original loop copied into the slow path.
+  Node* limit = *effect = graph()->NewNode(
+      machine()->Load(MachineType::Pointer()),
+      jsgraph()->ExternalConstant(
+          ExternalReference::address_of_stack_limit(jsgraph()->isolate())),
+      jsgraph()->IntPtrConstant(0), *effect, control);
+  Node* pointer = graph()->NewNode(machine()->LoadStackPointer());
+
+  Node* check = graph()->NewNode(machine()->UintLessThan(), limit, pointer);
+  Node* branch =
+      graph()->NewNode(common()->Branch(BranchHint::kTrue), check, control);
+
+  Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+  Node* etrue = *effect;
+
+  Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+  NodeVector inputs(temp_zone_);
+  for (Node* input : call->inputs()) inputs.push_back(input);
+  int const frame_state_index =
+      static_cast<int>(CallDescriptorOf(call->op())->InputCount());
+  inputs[frame_state_index] =
+      CopyState(candidate, inputs[frame_state_index], induction);
+  inputs[NodeProperties::FirstEffectIndex(call)] = *effect;
+  inputs[NodeProperties::FirstControlIndex(call)] = if_false;
+  Node* efalse = if_false = graph()->NewNode(
+      call->op(), static_cast<int>(inputs.size()), inputs.data());
+
+  Node* merge = graph()->NewNode(common()->Merge(2), if_true, if_false);
+  *effect = graph()->NewNode(common()->EffectPhi(2), etrue, efalse, merge);
+  return merge;
+}
+
+Node* LoopVectorizer::CopyState(Candidate* candidate, Node* node,
+                                Node* induction) {
+  if (node == candidate->induction) return induction;
+  if (!loop_tree_->Contains(candidate->loop, node)) return node;
+  NodeVector inputs(temp_zone_);
+  bool changed = false;
+  for (Node* input : node->inputs()) {
+    Node* copy = CopyState(candidate, input, induction);
+    changed |= copy != input;
+    inputs.push_back(copy);
+  }
+  if (!changed) return node;
+  return graph()->NewNode(node->op(), static_cast<int>(inputs.size()),
+                          inputs.data());
+}
+
+Node* LoopVectorizer::CopyInvariant(Candidate* candidate, Node* node,
+                                    Node** effect, Node* control) {
+  if (!loop_tree_->Contains(candidate->loop, node)) return node;
+  auto it = candidate->copies.find(node);
+  if (it != candidate->copies.end()) return it->second;
+
+  Node* copy;
+  if (node->opcode() == IrOpcode::kLoadField) {
+    Node* object = CopyInvariant(
+        candidate, NodeProperties::GetValueInput(node, 0), effect, control);
+    copy = *effect = graph()->NewNode(node->op(), object, *effect, control);
+  } else {
+    NodeVector inputs(temp_zone_);
+    for (Node* input : node->inputs()) {
+      inputs.push_back(CopyInvariant(candidate, input, effect, control));
+    }
+    copy = graph()->NewNode(node->op(), static_cast<int>(inputs.size()),
+                            inputs.data());
+  }
+  candidate->copies.insert(std::make_pair(node, copy));
+  return copy;
+}
+
+Node* LoopVectorizer::VectorizeValue(Candidate* candidate, Node* node,
+                                     Node* offset, Node** effect,
+                                     Node* control) {
+  auto it = candidate->vectors.find(node);
+  if (it != candidate->vectors.end()) return it->second;
+
+  Node* result;
+  if (std::find(candidate->loads.begin(), candidate->loads.end(), node) !=
+      candidate->loads.end()) {
+    Node* storage = VectorStorage(candidate, node, effect, control);
+    result = *effect =
+        graph()->NewNode(machine()->Load(MachineType::Simd128()), storage,
+                         offset, *effect, control);
+  } else if (IsVectorizableBinop(node) && !IsInvariant(candidate, node)) {
+    Node* left =
+        VectorizeValue(candidate, node->InputAt(0), offset, effect, control);
+    Node* right =
+        VectorizeValue(candidate, node->InputAt(1), offset, effect, control);
+    const Operator* op = nullptr;
+    switch (node->opcode()) {
+      case IrOpcode::kInt32Add:
+        op = machine()->I32x4Add();
+        break;
+      case IrOpcode::kInt32Sub:
+        op = machine()->I32x4Sub();
+        break;
+      case IrOpcode::kWord32And:
+        op = machine()->S128And();
+        break;
+      case IrOpcode::kWord32Or:
+        op = machine()->S128Or();
+        break;
+      case IrOpcode::kWord32Xor:
+        op = machine()->S128Xor();
+        break;
+      default:
+        UNREACHABLE();
+    }
+    result = graph()->NewNode(op, left, right);
+  } else {
+    // Loop invariant values are broadcast to all lanes.
+    result = graph()->NewNode(machine()->I32x4Splat(),
+                              CopyInvariant(candidate, node, effect, control));
+  }
+  candidate->vectors.insert(std::make_pair(node, result));
+  return result;
+}
+
+Node* LoopVectorizer::VectorStorage(Candidate* candidate, Node* access,
+                                    Node** effect, Node* control) {
+  Node* const storage = NodeProperties::GetValueInput(access, 0);
+  auto it = candidate->storages.find(storage);
+  if (it != candidate->storages.end()) return it->second;
+
+  Node* result;
+  if (storage->opcode() == IrOpcode::kUnsafePointerAdd) {
+    // The {base} of on-heap typed arrays is a tagged pointer; derive the
+    // storage pointer again right before it is used.
+    Node* base = CopyInvariant(candidate, storage->InputAt(0), effect, control);
+    Node* external =
+        CopyInvariant(candidate, storage->InputAt(1), effect, control);
+    result = *effect = graph()->NewNode(machine()->UnsafePointerAdd(), base,
+                                        external, *effect, control);
+  } else {
+    result = CopyInvariant(candidate, storage, effect, control);
+  }
+  candidate->storages.insert(std::make_pair(storage, result));
+  return result;
+}
+
+CommonOperatorBuilder* LoopVectorizer::common() const {
+  return jsgraph_->common();
+}
+
+MachineOperatorBuilder* LoopVectorizer::machine() const {
+  return jsgraph_->machine();
+}
+
+Graph* LoopVectorizer::graph() const { return jsgraph_->graph(); }
+
+#undef TRACE
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
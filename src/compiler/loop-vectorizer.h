@@ -0,0 +1,114 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_LOOP_VECTORIZER_H_
+#define V8_COMPILER_LOOP_VECTORIZER_H_
+
+#include "src/compiler/loop-analysis.h"
+#include "src/globals.h"
+#include "src/zone/zone-containers.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+// Forward declarations.
+class CommonOperatorBuilder;
+class JSGraph;
+class MachineOperatorBuilder;
+
+// Vectorizes innermost loops of the form
+//
+//   for (i = init; i < n; ++i) c[i] = a[i] op b[i] op ...
+//
+// over Int32Arrays, where op is +, -, &, | or ^ and the operands are element
+// loads at index i or values that are invariant in the loop. Runs on the
+// machine-level graph after effect/control linearization, before memory
+// optimization.
+//
+// The vector loop processes four elements per iteration using the I32x4
+// machine operators and is placed in front of the original loop, which then
+// handles the remaining iterations. The vector loop only runs an iteration
+// when the original loop would run all four of them without deoptimizing,
+// and only if the stored array cannot overlap the loaded ones within those
+// four elements, so its result is always the same as the scalar one.
+//
+// The vector loop header gets a copy of the stack check of the original loop,
+// whose frame state resumes the original loop at the current index.
+class V8_EXPORT_PRIVATE LoopVectorizer final {
+ public:
+  LoopVectorizer(JSGraph* jsgraph, LoopTree* loop_tree, Zone* temp_zone);
+
+  void Run();
+
+ private:
+  // Description of a loop that can be vectorized, along with the nodes that
+  // were created for its vector loop.
+  struct Candidate {
+    explicit Candidate(Zone* zone)
+        : lengths(zone),
+          loads(zone),
+          copies(zone),
+          storages(zone),
+          vectors(zone) {}
+
+    LoopTree::Loop* loop = nullptr;
+    Node* loop_control = nullptr;
+    Node* effect_phi = nullptr;
+    Node* induction = nullptr;
+    Node* limit = nullptr;
+    Node* stack_check = nullptr;  // The lowered stack check call, if any.
+    ZoneVector<Node*> lengths;  // Lengths the induction is checked against.
+    ZoneVector<Node*> loads;
+    Node* store = nullptr;
+
+    ZoneMap<Node*, Node*> copies;    // Copies of loop invariant values.
+    ZoneMap<Node*, Node*> storages;  // Storage pointers in the vector loop.
+    ZoneMap<Node*, Node*> vectors;   // Vector values of the stored value.
+  };
+
+  void VisitLoop(LoopTree::Loop* loop);
+
+  bool MatchLoop(Candidate* candidate);
+  bool MatchBody(Node* if_true, Candidate* candidate,
+                 ZoneSet<Node*>* body_effects);
+  Node* MatchSideEffectFreeDiamond(Node* merge);
+  bool MatchAccess(Node* node, Candidate const* candidate);
+  bool MatchValue(Node* node, Candidate const* candidate,
+                  ZoneSet<Node*>* visited);
+  bool MatchStackCheck(Candidate* candidate);
+  bool MatchState(Candidate const* candidate, Node* node);
+  bool IsInvariant(Candidate const* candidate, Node* node);
+  bool HasOnlyDeoptimizationUses(Node* node, ZoneSet<Node*> const& values);
+  bool HeaderHasNoSideEffects(Candidate const* candidate,
+                              ZoneSet<Node*> const& body_effects);
+
+  void Vectorize(Candidate* candidate);
+  Node* BuildStackCheck(Candidate* candidate, Node* induction, Node** effect,
+                        Node* control);
+  Node* CopyState(Candidate* candidate, Node* node, Node* induction);
+  Node* CopyInvariant(Candidate* candidate, Node* node, Node** effect,
+                      Node* control);
+  Node* VectorizeValue(Candidate* candidate, Node* node, Node* offset,
+                       Node** effect, Node* control);
+  Node* VectorStorage(Candidate* candidate, Node* access, Node** effect,
+                      Node* control);
+
+  CommonOperatorBuilder* common() const;
+  MachineOperatorBuilder* machine() const;
+  Graph* graph() const;
+  JSGraph* jsgraph() const { return jsgraph_; }
+
+  JSGraph* const jsgraph_;
+  LoopTree* const loop_tree_;
+  Zone* const temp_zone_;
+
+  DISALLOW_COPY_AND_ASSIGN(LoopVectorizer);
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_LOOP_VECTORIZER_H_
@@ -17,10 +17,18 @@ int InstructionScheduler::GetTargetInstructionFlags(
 }
 
 
-int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
+int InstructionScheduler::GetInstructionLatency(const Instruction* instr,
+                                                int model) {
   UNIMPLEMENTED();
 }
 
+
+int InstructionScheduler::GetIssueWidth(int model) { UNIMPLEMENTED(); }
+
+int InstructionScheduler::LatencyModelCount() { UNIMPLEMENTED(); }
+
+int InstructionScheduler::HostLatencyModel() { UNIMPLEMENTED(); }
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
@@ -44,8 +44,10 @@
 #include "src/compiler/live-range-separator.h"
 #include "src/compiler/load-elimination.h"
 #include "src/compiler/loop-analysis.h"
+#include "src/compiler/loop-invariant-code-motion.h"
 #include "src/compiler/loop-peeling.h"
 #include "src/compiler/loop-variable-optimizer.h"
+#include "src/compiler/loop-vectorizer.h"
 #include "src/compiler/machine-graph-verifier.h"
 #include "src/compiler/machine-operator-reducer.h"
 #include "src/compiler/memory-optimizer.h"
@@ -554,6 +556,16 @@ PipelineStatistics* CreatePipelineStatistics(CompilationInfo* info,
   return pipeline_statistics;
 }
 
+// Functions entered through on-stack replacement spend their time in a loop,
+// others have to keep accumulating profiler ticks well past the point where
+// they were first considered for optimization. The ticks on the function
+// itself are already reset at this point, so use the ones recorded on
+// |info|.
+bool IsVeryHot(CompilationInfo* info) {
+  if (info->is_osr()) return true;
+  return info->profiler_ticks() >= FLAG_turbo_loop_aware_regalloc_ticks;
+}
+
 }  // namespace
 
 class PipelineCompilationJob final : public CompilationJob {
@@ -618,6 +630,9 @@ PipelineCompilationJob::Status PipelineCompilationJob::PrepareJobImpl() {
   } else if (FLAG_turbo_inlining) {
     info()->MarkAsInliningEnabled();
   }
+  if (FLAG_turbo_loop_aware_regalloc && IsVeryHot(info())) {
+    info()->MarkAsLoopAwareRegisterAllocation();
+  }
 
   linkage_ = new (info()->zone())
       Linkage(Linkage::ComputeIncoming(info()->zone(), info()));
@@ -1036,6 +1051,28 @@ struct LoopPeelingPhase {
   }
 };
 
+struct LoopInvariantCodeMotionPhase {
+  static const char* phase_name() { return "loop invariant code motion"; }
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    LoopTree* loop_tree =
+        LoopFinder::BuildLoopTree(data->jsgraph()->graph(), temp_zone);
+    LoopInvariantCodeMotion licm(data->jsgraph(), loop_tree, temp_zone);
+    licm.Run();
+  }
+};
+
+struct LoopVectorizationPhase {
+  static const char* phase_name() { return "loop vectorization"; }
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    LoopTree* loop_tree =
+        LoopFinder::BuildLoopTree(data->jsgraph()->graph(), temp_zone);
+    LoopVectorizer vectorizer(data->jsgraph(), loop_tree, temp_zone);
+    vectorizer.Run();
+  }
+};
+
 struct LoopExitEliminationPhase {
   static const char* phase_name() { return "loop exit elimination"; }
 
@@ -1621,6 +1658,11 @@ bool PipelineImpl::OptimizeGraph(Linkage* linkage) {
       RunPrintAndVerify("Load eliminated");
     }
 
+    if (FLAG_turbo_loop_invariant_code_motion) {
+      Run<LoopInvariantCodeMotionPhase>();
+      RunPrintAndVerify("Loop invariant code moved");
+    }
+
     if (FLAG_turbo_escape) {
       Run<EscapeAnalysisPhase>();
       if (data->compilation_failed()) {
@@ -1677,6 +1719,12 @@ bool PipelineImpl::OptimizeGraph(Linkage* linkage) {
     RunPrintAndVerify("Control flow optimized", true);
   }
 
+  // Vectorize simple typed array loops.
+  if (FLAG_turbo_loop_vectorization && !data->is_asm()) {
+    Run<LoopVectorizationPhase>();
+    RunPrintAndVerify("Loops vectorized", true);
+  }
+
   // Optimize memory access and allocation operations.
   Run<MemoryOptimizationPhase>();
   // TODO(jarin, rossberg): Remove UNTYPED once machine typing works.
@@ -1814,9 +1862,10 @@ CompilationJob* Pipeline::NewWasmCompilationJob(
 
 bool Pipeline::AllocateRegistersForTesting(const RegisterConfiguration* config,
                                            InstructionSequence* sequence,
-                                           bool run_verifier) {
+                                           bool run_verifier, bool loop_aware) {
   CompilationInfo info(ArrayVector("testing"), sequence->isolate(),
                        sequence->zone(), Code::ComputeFlags(Code::STUB));
+  if (loop_aware) info.MarkAsLoopAwareRegisterAllocation();
   ZoneStats zone_stats(sequence->isolate()->allocator());
   PipelineData data(&zone_stats, &info, sequence);
   PipelineImpl pipeline(&data);
@@ -2029,8 +2078,13 @@ void PipelineImpl::AllocateRegisters(const RegisterConfiguration* config,
     Run<SplinterLiveRangesPhase>();
   }
 
-  Run<AllocateGeneralRegistersPhase<LinearScanAllocator>>();
-  Run<AllocateFPRegistersPhase<LinearScanAllocator>>();
+  if (info()->is_loop_aware_register_allocation()) {
+    Run<AllocateGeneralRegistersPhase<LoopAwareLinearScanAllocator>>();
+    Run<AllocateFPRegistersPhase<LoopAwareLinearScanAllocator>>();
+  } else {
+    Run<AllocateGeneralRegistersPhase<LinearScanAllocator>>();
+    Run<AllocateFPRegistersPhase<LinearScanAllocator>>();
+  }
 
   if (FLAG_turbo_preprocess_ranges) {
     Run<MergeSplintersPhase>();
@@ -2731,10 +2731,17 @@ const char* RegisterAllocator::RegisterName(int register_code) const {
 
 LinearScanAllocator::LinearScanAllocator(RegisterAllocationData* data,
                                          RegisterKind kind, Zone* local_zone)
+    : LinearScanAllocator(data, kind, local_zone, false) {}
+
+
+LinearScanAllocator::LinearScanAllocator(RegisterAllocationData* data,
+                                         RegisterKind kind, Zone* local_zone,
+                                         bool split_around_loops)
     : RegisterAllocator(data, kind),
       unhandled_live_ranges_(local_zone),
       active_live_ranges_(local_zone),
-      inactive_live_ranges_(local_zone) {
+      inactive_live_ranges_(local_zone),
+      split_around_loops_(split_around_loops) {
   unhandled_live_ranges().reserve(
       static_cast<size_t>(code()->VirtualRegisterCount() * 2));
   active_live_ranges().reserve(8);
@@ -2752,6 +2759,7 @@ void LinearScanAllocator::AllocateRegisters() {
   DCHECK(inactive_live_ranges().empty());
 
   SplitAndSpillRangesDefinedByMemoryOperand();
+  if (split_around_loops_) SplitAndSpillRangesLiveThroughLoops();
 
   for (TopLevelLiveRange* range : data()->live_ranges()) {
     if (!CanProcessRange(range)) continue;
@@ -2826,6 +2834,77 @@ void LinearScanAllocator::AllocateRegisters() {
   }
 }
 
+void LinearScanAllocator::SplitAndSpillRangesLiveThroughLoops() {
+  // Outer loops come first in RPO, so ranges spilled across an outer loop no
+  // longer count towards the register pressure of the loops nested in it.
+  for (const InstructionBlock* block : code()->instruction_blocks()) {
+    if (block->IsLoopHeader()) SplitAndSpillRangesLiveThroughLoop(block);
+  }
+}
+
+
+void LinearScanAllocator::SplitAndSpillRangesLiveThroughLoop(
+    const InstructionBlock* header) {
+  LifetimePosition loop_start = LifetimePosition::GapFromInstructionIndex(
+      header->first_instruction_index());
+  LifetimePosition loop_end = LifetimePosition::GapFromInstructionIndex(
+                                  code()->LastLoopInstructionIndex(header))
+                                  .NextFullStart();
+
+  struct Candidate {
+    LiveRange* range;
+    const UsePosition* next_use;
+  };
+  ZoneVector<Candidate> candidates(allocation_zone());
+  int live_at_header = 0;
+  for (TopLevelLiveRange* top : data()->live_ranges()) {
+    if (!CanProcessRange(top)) continue;
+    for (LiveRange* range = top; range != nullptr; range = range->next()) {
+      if (range->spilled() || !range->Covers(loop_start)) continue;
+      ++live_at_header;
+      // Phis of this loop and ranges ending inside it have to stay.
+      if (range->Start() >= loop_start || range->End() <= loop_end) break;
+      const UsePosition* next_use =
+          range->NextUsePositionRegisterIsBeneficial(loop_start);
+      if (next_use == nullptr || next_use->pos() > loop_end.NextStart()) {
+        candidates.push_back({range, next_use});
+      }
+      break;
+    }
+  }
+
+  int excess = live_at_header - num_allocatable_registers();
+  if (excess <= 0 || candidates.empty()) return;
+
+  // Spill the ranges whose next use is furthest away first.
+  std::sort(candidates.begin(), candidates.end(),
+            [](const Candidate& a, const Candidate& b) {
+              if (b.next_use == nullptr) return false;
+              if (a.next_use == nullptr) return true;
+              return a.next_use->pos() > b.next_use->pos();
+            });
+  if (candidates.size() > static_cast<size_t>(excess)) {
+    candidates.resize(static_cast<size_t>(excess));
+  }
+
+  for (const Candidate& candidate : candidates) {
+    TRACE("Spilling live range %d:%d around loop B%d\n",
+          candidate.range->TopLevel()->vreg(), candidate.range->relative_id(),
+          header->rpo_number().ToInt());
+    LiveRange* middle = SplitRangeAt(candidate.range, loop_start);
+    if (candidate.next_use != nullptr) {
+      // Reload before the next use, but not in a later loop.
+      LifetimePosition end = candidate.next_use->pos();
+      LifetimePosition reload_end = end.PrevStart().End();
+      if (data()->IsBlockBoundary(end.Start())) reload_end = end.Start();
+      DCHECK(loop_end < reload_end);
+      SplitBetween(middle, loop_end, reload_end);
+    }
+    Spill(middle);
+  }
+}
+
+
 bool LinearScanAllocator::TrySplitAndSpillSplinter(LiveRange* range) {
   DCHECK(range->TopLevel()->IsSplinter());
   // If we can spill the whole range, great. Otherwise, split above the
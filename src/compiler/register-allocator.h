@@ -1043,7 +1043,7 @@ class RegisterAllocator : public ZoneObject {
 };
 
 
-class LinearScanAllocator final : public RegisterAllocator {
+class LinearScanAllocator : public RegisterAllocator {
  public:
   LinearScanAllocator(RegisterAllocationData* data, RegisterKind kind,
                       Zone* local_zone);
@@ -1051,6 +1051,10 @@ class LinearScanAllocator final : public RegisterAllocator {
   // Phase 4: compute register assignments.
   void AllocateRegisters();
 
+ protected:
+  LinearScanAllocator(RegisterAllocationData* data, RegisterKind kind,
+                      Zone* local_zone, bool split_around_loops);
+
  private:
   ZoneVector<LiveRange*>& unhandled_live_ranges() {
     return unhandled_live_ranges_;
@@ -1102,9 +1106,16 @@ class LinearScanAllocator final : public RegisterAllocator {
 
   void SplitAndSpillIntersecting(LiveRange* range);
 
+  // Spill the parts of live ranges that are live throughout a loop without
+  // being used inside it, as long as more ranges are live at the loop header
+  // than there are registers.
+  void SplitAndSpillRangesLiveThroughLoops();
+  void SplitAndSpillRangesLiveThroughLoop(const InstructionBlock* header);
+
   ZoneVector<LiveRange*> unhandled_live_ranges_;
   ZoneVector<LiveRange*> active_live_ranges_;
   ZoneVector<LiveRange*> inactive_live_ranges_;
+  const bool split_around_loops_;
 
 #ifdef DEBUG
   LifetimePosition allocation_finger_;
@@ -1114,6 +1125,21 @@ class LinearScanAllocator final : public RegisterAllocator {
 };
 
 
+// A more expensive variant of the linear scan allocator for hot, loop-heavy
+// code. Ranges that only pass through a loop under register pressure are
+// spilled before allocation starts, which keeps their spill and reload moves
+// outside of the loop instead of on its back edges.
+class LoopAwareLinearScanAllocator final : public LinearScanAllocator {
+ public:
+  LoopAwareLinearScanAllocator(RegisterAllocationData* data, RegisterKind kind,
+                               Zone* local_zone)
+      : LinearScanAllocator(data, kind, local_zone, true) {}
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(LoopAwareLinearScanAllocator);
+};
+
+
 class SpillSlotLocator final : public ZoneObject {
  public:
   explicit SpillSlotLocator(RegisterAllocationData* data);
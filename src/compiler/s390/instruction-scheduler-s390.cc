@@ -176,11 +176,18 @@ int InstructionScheduler::GetTargetInstructionFlags(
   UNREACHABLE();
 }
 
-int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
+int InstructionScheduler::GetInstructionLatency(const Instruction* instr,
+                                                int model) {
   // TODO(all): Add instruction cost modeling.
   return 1;
 }
 
+int InstructionScheduler::GetIssueWidth(int model) { return 1; }
+
+int InstructionScheduler::LatencyModelCount() { return 1; }
+
+int InstructionScheduler::HostLatencyModel() { return kGenericLatencyModel; }
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
@@ -4,6 +4,11 @@
 
 #include "src/compiler/instruction-scheduler.h"
 
+#include <string.h>
+
+#include "src/base/cpu.h"
+#include "src/base/once.h"
+
 namespace v8 {
 namespace internal {
 namespace compiler {
@@ -242,9 +247,91 @@ int InstructionScheduler::GetTargetInstructionFlags(
 }
 
 
-int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
-  // Basic latency modeling for x64 instructions. They have been determined
-  // in an empirical way.
+namespace {
+
+// Latency model of an x64 core. All values are in cycles. They are rounded
+// from the vendors' optimization manuals and published instruction tables
+// and are meant to rank instructions, not to predict exact timings.
+struct X64LatencyModel {
+  int issue_width;
+  int load;            // Load-to-use latency of an L1 hit.
+  int memory_operand;  // Added for other instructions reading from memory.
+  int checked_memory;  // Bounds-checked load or store.
+  int imul;
+  int idiv;
+  int idiv32;
+  int udiv;
+  int udiv32;
+  int float_add;  // Also covers sub, cmp, abs, neg, min and max.
+  int float32_mul;
+  int float64_mul;
+  int float_div;  // Also covers sqrt.
+  int float_convert;
+  int float_to_int64;
+  int float64_mod;
+  int truncate_double;
+  bool avx;  // Whether AVX operations cost as much as their SSE versions.
+};
+
+const X64LatencyModel kModels[] = {
+    // The generic model keeps the empirical values that were used before
+    // per-core models existed.
+    {1, 1, 0, 5, 3, 49, 35, 38, 26, 3, 4, 5, 13, 4, 10, 50, 6, false},
+    // Intel Core microarchitectures since Haswell.
+    {4, 5, 5, 6, 3, 42, 26, 35, 26, 4, 4, 4, 14, 5, 6, 50, 6, true},
+    // Intel low-power cores (Silvermont, Goldmont).
+    {2, 3, 3, 4, 5, 70, 30, 60, 26, 3, 4, 5, 34, 4, 5, 60, 8, true},
+    // AMD Zen.
+    {4, 4, 4, 5, 3, 45, 30, 45, 30, 3, 3, 4, 13, 4, 5, 50, 6, true},
+};
+const int kIntelCoreModel = 1;
+const int kIntelAtomModel = 2;
+const int kAmdZenModel = 3;
+
+int host_latency_model = InstructionScheduler::kGenericLatencyModel;
+base::OnceType init_host_latency_model_once = V8_ONCE_INIT;
+
+void InitHostLatencyModel() {
+  base::CPU cpu;
+  if (strcmp(cpu.vendor(), "GenuineIntel") == 0) {
+    if (cpu.is_atom()) {
+      host_latency_model = kIntelAtomModel;
+    } else if (cpu.family() == 6) {
+      host_latency_model = kIntelCoreModel;
+    }
+  } else if (strcmp(cpu.vendor(), "AuthenticAMD") == 0) {
+    // Zen reports family 0xf with extended family 0x8 (i.e. family 0x17).
+    if (cpu.family() == 0xf && cpu.ext_family() >= 0x8) {
+      host_latency_model = kAmdZenModel;
+    }
+  }
+}
+
+const X64LatencyModel* GetLatencyModel(int model) {
+  DCHECK_LE(0, model);
+  DCHECK_LT(model, static_cast<int>(arraysize(kModels)));
+  return &kModels[model];
+}
+
+}  // namespace
+
+int InstructionScheduler::LatencyModelCount() {
+  return static_cast<int>(arraysize(kModels));
+}
+
+int InstructionScheduler::HostLatencyModel() {
+  base::CallOnce(&init_host_latency_model_once, &InitHostLatencyModel);
+  return host_latency_model;
+}
+
+int InstructionScheduler::GetIssueWidth(int model) {
+  return GetLatencyModel(model)->issue_width;
+}
+
+int InstructionScheduler::GetInstructionLatency(const Instruction* instr,
+                                                int model_index) {
+  const X64LatencyModel* model = GetLatencyModel(model_index);
+  int latency;
   switch (instr->arch_opcode()) {
     case kCheckedLoadInt8:
     case kCheckedLoadUint8:
@@ -260,12 +347,32 @@ int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
     case kCheckedStoreWord64:
     case kCheckedStoreFloat32:
     case kCheckedStoreFloat64:
-    case kSSEFloat64Mul:
-      return 5;
+      return model->checked_memory;
+    case kX64Movsxbl:
+    case kX64Movzxbl:
+    case kX64Movsxbq:
+    case kX64Movzxbq:
+    case kX64Movsxwl:
+    case kX64Movzxwl:
+    case kX64Movsxwq:
+    case kX64Movzxwq:
+    case kX64Movsxlq:
+    case kX64Movl:
+    case kX64Movq:
+    case kX64Movsd:
+    case kX64Movss:
+    case kX64Movdqu:
+      // Plain moves only cost a load when they read from memory.
+      if (instr->addressing_mode() != kMode_None && instr->HasOutput()) {
+        return model->load;
+      }
+      return 1;
     case kX64Imul:
     case kX64Imul32:
     case kX64ImulHigh32:
     case kX64UmulHigh32:
+      latency = model->imul;
+      break;
     case kSSEFloat32Cmp:
     case kSSEFloat32Add:
     case kSSEFloat32Sub:
@@ -278,8 +385,32 @@ int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
     case kSSEFloat64Min:
     case kSSEFloat64Abs:
     case kSSEFloat64Neg:
-      return 3;
+      latency = model->float_add;
+      break;
+    case kAVXFloat32Cmp:
+    case kAVXFloat32Add:
+    case kAVXFloat32Sub:
+    case kAVXFloat32Abs:
+    case kAVXFloat32Neg:
+    case kAVXFloat64Cmp:
+    case kAVXFloat64Add:
+    case kAVXFloat64Sub:
+    case kAVXFloat64Abs:
+    case kAVXFloat64Neg:
+      latency = model->avx ? model->float_add : 1;
+      break;
     case kSSEFloat32Mul:
+      latency = model->float32_mul;
+      break;
+    case kAVXFloat32Mul:
+      latency = model->avx ? model->float32_mul : 1;
+      break;
+    case kSSEFloat64Mul:
+      latency = model->float64_mul;
+      break;
+    case kAVXFloat64Mul:
+      latency = model->avx ? model->float64_mul : 1;
+      break;
     case kSSEFloat32ToFloat64:
     case kSSEFloat64ToFloat32:
     case kSSEFloat32Round:
@@ -288,32 +419,50 @@ int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
     case kSSEFloat32ToUint32:
     case kSSEFloat64ToInt32:
     case kSSEFloat64ToUint32:
-      return 4;
+      latency = model->float_convert;
+      break;
     case kX64Idiv:
-      return 49;
+      latency = model->idiv;
+      break;
     case kX64Idiv32:
-      return 35;
+      latency = model->idiv32;
+      break;
     case kX64Udiv:
-      return 38;
+      latency = model->udiv;
+      break;
     case kX64Udiv32:
-      return 26;
+      latency = model->udiv32;
+      break;
     case kSSEFloat32Div:
     case kSSEFloat64Div:
     case kSSEFloat32Sqrt:
     case kSSEFloat64Sqrt:
-      return 13;
+      latency = model->float_div;
+      break;
+    case kAVXFloat32Div:
+    case kAVXFloat64Div:
+      latency = model->avx ? model->float_div : 1;
+      break;
     case kSSEFloat32ToInt64:
     case kSSEFloat64ToInt64:
     case kSSEFloat32ToUint64:
     case kSSEFloat64ToUint64:
-      return 10;
+      latency = model->float_to_int64;
+      break;
     case kSSEFloat64Mod:
-      return 50;
+      return model->float64_mod;
     case kArchTruncateDoubleToI:
-      return 6;
+      return model->truncate_double;
     default:
-      return 1;
+      latency = 1;
+      break;
+  }
+  // Instructions with a memory operand that produce a value have to wait for
+  // the load first.
+  if (instr->addressing_mode() != kMode_None && instr->HasOutput()) {
+    latency += model->memory_operand;
   }
+  return latency;
 }
 
 }  // namespace compiler
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "src/compiler/zone-stats.h"
+#include "src/zone/accounting-allocator.h"
 
 namespace v8 {
 namespace internal {
@@ -61,11 +62,19 @@ void ZoneStats::StatsScope::ZoneReturned(Zone* zone) {
 }
 
 ZoneStats::ZoneStats(AccountingAllocator* allocator)
-    : max_allocated_bytes_(0), total_deleted_bytes_(0), allocator_(allocator) {}
+    : max_allocated_bytes_(0),
+      max_zone_segment_bytes_(0),
+      total_deleted_bytes_(0),
+      allocator_(allocator) {}
 
 ZoneStats::~ZoneStats() {
   DCHECK(zones_.empty());
   DCHECK(stats_.empty());
+  // The segments of big zones end up in the segment pool once the zones are
+  // returned. Don't keep them around after the compilation is done.
+  if (max_zone_segment_bytes_ > kLargeZoneSize) {
+    allocator_->TrimPool(kTrimmedPoolSize);
+  }
 }
 
 size_t ZoneStats::GetMaxAllocatedBytes() {
@@ -80,6 +89,14 @@ size_t ZoneStats::GetCurrentAllocatedBytes() {
   return total;
 }
 
+size_t ZoneStats::GetMaxZoneSegmentBytes() {
+  size_t max = max_zone_segment_bytes_;
+  for (Zone* zone : zones_) {
+    max = std::max(max, zone->segment_bytes_allocated());
+  }
+  return max;
+}
+
 size_t ZoneStats::GetTotalAllocatedBytes() {
   return total_deleted_bytes_ + GetCurrentAllocatedBytes();
 }
@@ -94,6 +111,8 @@ void ZoneStats::ReturnZone(Zone* zone) {
   size_t current_total = GetCurrentAllocatedBytes();
   // Update max.
   max_allocated_bytes_ = std::max(max_allocated_bytes_, current_total);
+  max_zone_segment_bytes_ =
+      std::max(max_zone_segment_bytes_, zone->segment_bytes_allocated());
   // Update stats.
   for (StatsScope* stat_scope : stats_) {
     stat_scope->ZoneReturned(zone);
@@ -70,6 +70,15 @@ class V8_EXPORT_PRIVATE ZoneStats final {
   size_t GetTotalAllocatedBytes();
   size_t GetCurrentAllocatedBytes();
 
+  // Returns the largest number of segment bytes held by any single zone, i.e.
+  // the high-water mark of the biggest zone.
+  size_t GetMaxZoneSegmentBytes();
+
+  // Zones that grew beyond this size make the segment pool of the allocator
+  // get trimmed back to kTrimmedPoolSize once all zones are returned.
+  static const size_t kLargeZoneSize = 4 * MB;
+  static const size_t kTrimmedPoolSize = 1 * MB;
+
  private:
   Zone* NewEmptyZone(const char* zone_name);
   void ReturnZone(Zone* zone);
@@ -81,6 +90,7 @@ class V8_EXPORT_PRIVATE ZoneStats final {
   Zones zones_;
   Stats stats_;
   size_t max_allocated_bytes_;
+  size_t max_zone_segment_bytes_;
   size_t total_deleted_bytes_;
   AccountingAllocator* allocator_;
 
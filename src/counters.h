@@ -1111,6 +1111,8 @@ class RuntimeCallTimerScope {
   SC(total_parse_size, V8.TotalParseSize)                           \
   /* Amount of source code skipped over using preparsing. */        \
   SC(total_preparse_skipped, V8.TotalPreparseSkipped)               \
+  /* Functions whose background preparse was used. */               \
+  SC(parallel_preparsed_functions, V8.ParallelPreparsedFunctions)   \
   /* Amount of compiled source code. */                             \
   SC(total_compile_size, V8.TotalCompileSize)                       \
   /* Amount of source code compiled with the full codegen. */       \
@@ -535,6 +535,7 @@ Deoptimizer::Deoptimizer(Isolate* isolate, JSFunction* function,
       // Soft deopts shouldn't count against the overall deoptimization count
       // that can eventually lead to disabling optimization for a function.
       isolate->counters()->soft_deopts_executed()->Increment();
+      function->shared()->set_has_optimization_hint(false);
     } else {
       function->shared()->increment_deopt_count();
     }
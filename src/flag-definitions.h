@@ -371,6 +371,9 @@ DEFINE_INT(max_inlined_nodes_cumulative, 400,
 DEFINE_INT(max_inlined_nodes_small, 10,
            "maximum number of AST nodes considered for small function inlining")
 DEFINE_FLOAT(min_inlining_frequency, 0.15, "minimum frequency for inlining")
+DEFINE_BOOL(turbo_profile_guided_inlining, false,
+            "rank inlining candidates by call frequency per AST node and scale "
+            "the cumulative inlining budget by call frequency")
 DEFINE_BOOL(loop_invariant_code_motion, true, "loop invariant code motion")
 DEFINE_BOOL(fast_math, true, "faster (but maybe less accurate) math functions")
 DEFINE_BOOL(hydrogen_stats, false, "print statistics for hydrogen")
@@ -443,8 +446,10 @@ DEFINE_BOOL(concurrent_recompilation, true,
             "optimizing hot functions asynchronously on a separate thread")
 DEFINE_BOOL(trace_concurrent_recompilation, false,
             "track concurrent recompilation")
-DEFINE_INT(concurrent_recompilation_queue_length, 8,
-           "the length of the concurrent compilation queue")
+DEFINE_INT(concurrent_recompilation_queue_length, 64,
+           "the maximum length of the concurrent compilation queue")
+DEFINE_INT(concurrent_recompilation_max_threads, 4,
+           "the maximum number of background threads compiling concurrently")
 DEFINE_INT(concurrent_recompilation_delay, 0,
            "artificial compilation delay in ms")
 DEFINE_BOOL(block_concurrent_recompilation, false,
@@ -466,6 +471,11 @@ DEFINE_BOOL(turbo_sp_frame_access, false,
             "use stack pointer-relative access to frame wherever possible")
 DEFINE_BOOL(turbo_preprocess_ranges, true,
             "run pre-register allocation heuristics")
+DEFINE_BOOL(turbo_loop_aware_regalloc, true,
+            "use the loop-aware register allocator for very hot functions")
+DEFINE_INT(turbo_loop_aware_regalloc_ticks, 16,
+           "profiler ticks after which a function counts as very hot for "
+           "register allocation")
 DEFINE_STRING(turbo_filter, "~~", "optimization filter for TurboFan compiler")
 DEFINE_BOOL(trace_turbo, false, "trace generated TurboFan IR")
 DEFINE_BOOL(trace_turbo_graph, false, "trace generated TurboFan graphs")
@@ -504,6 +514,8 @@ DEFINE_BOOL(function_context_specialization, false,
             "enable function context specialization in TurboFan")
 DEFINE_BOOL(turbo_inlining, true, "enable inlining in TurboFan")
 DEFINE_BOOL(trace_turbo_inlining, false, "trace TurboFan inlining")
+DEFINE_BOOL(trace_turbo_inlining_decisions, false,
+            "trace profile-guided inlining decisions as JSON, one per line")
 DEFINE_BOOL(turbo_inline_array_builtins, true,
             "inline array builtins in TurboFan code")
 DEFINE_BOOL(turbo_load_elimination, true, "enable load elimination in TurboFan")
@@ -517,11 +529,30 @@ DEFINE_BOOL(turbo_move_optimization, true, "optimize gap moves in TurboFan")
 DEFINE_BOOL(turbo_jt, true, "enable jump threading in TurboFan")
 DEFINE_BOOL(turbo_loop_peeling, true, "Turbofan loop peeling")
 DEFINE_BOOL(turbo_loop_variable, true, "Turbofan loop variable optimization")
+DEFINE_BOOL(turbo_loop_invariant_code_motion, true,
+            "hoist loop invariant checks and eliminate bounds checks implied "
+            "by loop conditions in TurboFan")
+#if V8_TARGET_ARCH_X64
+#define TURBO_LOOP_VECTORIZATION_BOOL true
+#else
+#define TURBO_LOOP_VECTORIZATION_BOOL false
+#endif
+DEFINE_BOOL(turbo_loop_vectorization, TURBO_LOOP_VECTORIZATION_BOOL,
+            "vectorize element-wise Int32Array loops in TurboFan (x64 only)")
+#undef TURBO_LOOP_VECTORIZATION_BOOL
 DEFINE_BOOL(turbo_cf_optimization, true, "optimize control flow in TurboFan")
 DEFINE_BOOL(turbo_frame_elision, true, "elide frames in TurboFan")
 DEFINE_BOOL(turbo_escape, true, "enable escape analysis")
-DEFINE_BOOL(turbo_instruction_scheduling, false,
+DEFINE_BOOL(turbo_escape_loop_phis, false,
+            "scalar replace objects carried across loop iterations")
+#if V8_TARGET_ARCH_X64 || V8_TARGET_ARCH_ARM64
+#define TURBO_INSTRUCTION_SCHEDULING_BOOL true
+#else
+#define TURBO_INSTRUCTION_SCHEDULING_BOOL false
+#endif
+DEFINE_BOOL(turbo_instruction_scheduling, TURBO_INSTRUCTION_SCHEDULING_BOOL,
             "enable instruction scheduling in TurboFan")
+#undef TURBO_INSTRUCTION_SCHEDULING_BOOL
 DEFINE_BOOL(turbo_stress_instruction_scheduling, false,
             "randomly schedule instructions to stress dependency tracking")
 DEFINE_BOOL(turbo_store_elimination, true,
@@ -670,6 +701,8 @@ DEFINE_BOOL(trace_mutator_utilization, false,
 DEFINE_BOOL(flush_regexp_code, true,
             "flush regexp code that we expect not to use again")
 DEFINE_BOOL(age_code, true, "track un-executed functions to age code")
+DEFINE_BOOL(flush_bytecode, false,
+            "flush bytecode of functions that were not executed recently")
 DEFINE_BOOL(incremental_marking, true, "use incremental marking")
 DEFINE_BOOL(incremental_marking_wrappers, true,
             "use incremental marking for marking wrappers")
@@ -691,11 +724,20 @@ DEFINE_INT(min_progress_during_incremental_marking_finalization, 32,
 DEFINE_INT(max_incremental_marking_finalization_rounds, 3,
            "at most try this many times to finalize incremental marking")
 DEFINE_BOOL(minor_mc, false, "perform young generation mark compact GCs")
+DEFINE_BOOL(young_generation_large_objects, false,
+            "allocate large objects in the young generation and promote "
+            "surviving ones without copying")
+// The young generation mark compactor does not know about young large objects.
+DEFINE_NEG_IMPLICATION(young_generation_large_objects, minor_mc)
 DEFINE_BOOL(black_allocation, true, "use black allocation")
 DEFINE_BOOL(concurrent_store_buffer, true,
             "use concurrent store buffer processing")
 DEFINE_BOOL(concurrent_sweeping, true, "use concurrent sweeping")
+DEFINE_BOOL(discard_free_memory, false,
+            "return free memory of swept pages to the operating system")
 DEFINE_BOOL(parallel_compaction, true, "use parallel compaction")
+DEFINE_BOOL(parallel_scavenge, false, "use parallel scavenging")
+DEFINE_BOOL(trace_parallel_scavenge, false, "trace parallel scavenging")
 DEFINE_BOOL(parallel_pointer_update, true,
             "use parallel pointer update during compaction")
 DEFINE_BOOL(trace_incremental_marking, false,
@@ -727,9 +769,6 @@ DEFINE_INT(v8_os_page_size, 0, "override OS page size (in KBytes)")
 DEFINE_BOOL(always_compact, false, "Perform compaction on every full GC")
 DEFINE_BOOL(never_compact, false,
             "Never perform compaction on full GC - testing only")
-// TODO(ulan): enable compaction for concurrent marking when it correctly
-// records slots to evacuation candidates.
-DEFINE_IMPLICATION(concurrent_marking, never_compact)
 DEFINE_BOOL(compact_code_space, true, "Compact code space on full collections")
 DEFINE_BOOL(cleanup_code_caches_at_gc, true,
             "Flush code caches in maps during mark compact cycle.")
@@ -840,6 +879,9 @@ DEFINE_BOOL(serialize_toplevel, true, "enable caching of toplevel scripts")
 DEFINE_BOOL(serialize_eager, false, "compile eagerly when caching scripts")
 DEFINE_BOOL(serialize_age_code, false, "pre age code in the code cache")
 DEFINE_BOOL(trace_serializer, false, "print code serializer trace")
+DEFINE_BOOL(cache_optimization_hints, false,
+            "record optimized functions in code caches created after "
+            "execution and optimize them early when consuming the cache")
 #ifdef DEBUG
 DEFINE_BOOL(external_reference_stats, false,
             "print statistics on external references used during serialization")
@@ -859,6 +901,12 @@ DEFINE_BOOL(cache_prototype_transitions, true, "cache prototype transitions")
 DEFINE_BOOL(compiler_dispatcher, false, "enable compiler dispatcher")
 DEFINE_BOOL(compiler_dispatcher_eager_inner, false,
             "enable background compilation of eager inner functions")
+DEFINE_BOOL(compiler_dispatcher_precompile, false,
+            "parse and compile lazy functions that are called from top-level "
+            "code in the background")
+DEFINE_IMPLICATION(compiler_dispatcher_precompile, compiler_dispatcher)
+DEFINE_IMPLICATION(compiler_dispatcher_precompile,
+                   compiler_dispatcher_eager_inner)
 DEFINE_BOOL(trace_compiler_dispatcher, false,
             "trace compiler dispatcher activity")
 
@@ -970,6 +1018,14 @@ DEFINE_BOOL(experimental_preparser_scope_analysis, false,
             "perform scope analysis for preparsed inner functions")
 DEFINE_IMPLICATION(experimental_preparser_scope_analysis,
                    aggressive_lazy_inner_functions)
+DEFINE_BOOL(parallel_preparse, false,
+            "preparse top-level functions of large scripts on background "
+            "threads")
+DEFINE_INT(parallel_preparse_min_size, 1 * MB,
+           "minimum source length in characters for parallel preparsing")
+DEFINE_BOOL(parallel_preparse_on_main_thread, false,
+            "do the parallel preparse on the main thread before parsing "
+            "(for testing)")
 
 // simulator-arm.cc, simulator-arm64.cc and simulator-mips.cc
 DEFINE_BOOL(trace_sim, false, "Trace simulator execution")
@@ -1320,6 +1376,7 @@ DEFINE_NEG_IMPLICATION(single_threaded, concurrent_marking)
 DEFINE_NEG_IMPLICATION(single_threaded, concurrent_sweeping)
 DEFINE_NEG_IMPLICATION(single_threaded, minor_mc_parallel_marking)
 DEFINE_NEG_IMPLICATION(single_threaded, parallel_compaction)
+DEFINE_NEG_IMPLICATION(single_threaded, parallel_scavenge)
 DEFINE_NEG_IMPLICATION(single_threaded, parallel_pointer_update)
 DEFINE_NEG_IMPLICATION(single_threaded, concurrent_store_buffer)
 DEFINE_NEG_IMPLICATION(single_threaded, compiler_dispatcher)
@@ -470,6 +470,7 @@ class MacroAssembler;
 class Map;
 class MapSpace;
 class MarkCompactCollector;
+class NewLargeObjectSpace;
 class NewSpace;
 class Object;
 class OldSpace;
@@ -3,6 +3,9 @@
 // found in the LICENSE file.
 
 #include "src/heap/array-buffer-tracker.h"
+
+#include <algorithm>
+
 #include "src/heap/array-buffer-tracker-inl.h"
 #include "src/heap/heap.h"
 #include "src/heap/spaces.h"
@@ -39,58 +42,83 @@ void LocalArrayBufferTracker::Free(Callback should_free) {
 }
 
 template <typename Callback>
-void LocalArrayBufferTracker::Process(Callback callback) {
+size_t LocalArrayBufferTracker::Process(Callback callback) {
   JSArrayBuffer* new_buffer = nullptr;
-  JSArrayBuffer* old_buffer = nullptr;
   size_t freed_memory = 0;
   size_t retained_size = 0;
-  for (TrackingData::iterator it = array_buffers_.begin();
-       it != array_buffers_.end();) {
-    old_buffer = reinterpret_cast<JSArrayBuffer*>(*it);
+  // Moved buffers are collected first and then added to the trackers of their
+  // target pages, so that every target page is locked only once.
+  std::vector<std::pair<Page*, JSArrayBuffer*>> moved;
+  // Entries are not erased one by one. Pages are usually evacuated completely,
+  // in which case the set is simply cleared.
+  std::vector<JSArrayBuffer*> kept;
+  for (JSArrayBuffer* old_buffer : array_buffers_) {
     const size_t length = old_buffer->allocation_length();
     const CallbackResult result = callback(old_buffer, &new_buffer);
     if (result == kKeepEntry) {
       retained_size += length;
-      ++it;
+      kept.push_back(old_buffer);
     } else if (result == kUpdateEntry) {
       DCHECK_NOT_NULL(new_buffer);
-      Page* target_page = Page::FromAddress(new_buffer->address());
-      // We need to lock the target page because we cannot guarantee
-      // exclusive access to new space pages.
-      if (target_page->InNewSpace()) target_page->mutex()->Lock();
-      LocalArrayBufferTracker* tracker = target_page->local_tracker();
-      if (tracker == nullptr) {
-        target_page->AllocateLocalTracker();
-        tracker = target_page->local_tracker();
-      }
-      DCHECK_NOT_NULL(tracker);
       DCHECK_EQ(length, new_buffer->allocation_length());
-      tracker->Add(new_buffer, length);
-      if (target_page->InNewSpace()) target_page->mutex()->Unlock();
-      it = array_buffers_.erase(it);
+      moved.push_back(
+          std::make_pair(Page::FromAddress(new_buffer->address()), new_buffer));
     } else if (result == kRemoveEntry) {
       freed_memory += length;
       old_buffer->FreeBackingStore();
-      it = array_buffers_.erase(it);
     } else {
       UNREACHABLE();
     }
   }
+  if (kept.size() != array_buffers_.size()) {
+    array_buffers_.clear();
+    array_buffers_.insert(kept.begin(), kept.end());
+  }
   retained_size_ = retained_size;
   if (freed_memory > 0) {
     heap_->update_external_memory_concurrently_freed(
         static_cast<intptr_t>(freed_memory));
   }
+  if (!moved.empty()) AddMovedBuffers(&moved);
+  return moved.size();
+}
+
+void LocalArrayBufferTracker::AddMovedBuffers(
+    std::vector<std::pair<Page*, JSArrayBuffer*>>* moved) {
+  std::sort(moved->begin(), moved->end());
+  auto it = moved->begin();
+  while (it != moved->end()) {
+    Page* target_page = it->first;
+    // We need to lock the target page because we cannot guarantee
+    // exclusive access to new space pages.
+    if (target_page->InNewSpace()) target_page->mutex()->Lock();
+    LocalArrayBufferTracker* tracker = target_page->local_tracker();
+    if (tracker == nullptr) {
+      target_page->AllocateLocalTracker();
+      tracker = target_page->local_tracker();
+    }
+    DCHECK_NOT_NULL(tracker);
+    for (; it != moved->end() && it->first == target_page; ++it) {
+      tracker->Add(it->second, it->second->allocation_length());
+    }
+    if (target_page->InNewSpace()) target_page->mutex()->Unlock();
+  }
 }
 
 void ArrayBufferTracker::FreeDeadInNewSpace(Heap* heap) {
   DCHECK_EQ(heap->gc_state(), Heap::HeapState::SCAVENGE);
+  size_t scavenged = 0;
+  size_t survived = 0;
   for (Page* page : PageRange(heap->new_space()->FromSpaceStart(),
                               heap->new_space()->FromSpaceEnd())) {
-    bool empty = ProcessBuffers(page, kUpdateForwardedRemoveOthers);
+    LocalArrayBufferTracker* tracker = page->local_tracker();
+    if (tracker == nullptr) continue;
+    scavenged += tracker->size();
+    bool empty = ProcessBuffers(page, kUpdateForwardedRemoveOthers, &survived);
     CHECK(empty);
   }
   heap->account_external_memory_concurrently_freed();
+  if (scavenged > 0) heap->RecordArrayBufferSurvival(scavenged, survived);
 }
 
 size_t ArrayBufferTracker::RetainedInNewSpace(Heap* heap) {
@@ -126,12 +154,13 @@ void ArrayBufferTracker::FreeAll(Page* page) {
   }
 }
 
-bool ArrayBufferTracker::ProcessBuffers(Page* page, ProcessingMode mode) {
+bool ArrayBufferTracker::ProcessBuffers(Page* page, ProcessingMode mode,
+                                        size_t* moved) {
   LocalArrayBufferTracker* tracker = page->local_tracker();
   if (tracker == nullptr) return true;
 
   DCHECK(page->SweepingDone());
-  tracker->Process(
+  size_t moved_buffers = tracker->Process(
       [mode](JSArrayBuffer* old_buffer, JSArrayBuffer** new_buffer) {
         MapWord map_word = old_buffer->map_word();
         if (map_word.IsForwardingAddress()) {
@@ -142,6 +171,7 @@ bool ArrayBufferTracker::ProcessBuffers(Page* page, ProcessingMode mode) {
                    ? LocalArrayBufferTracker::kKeepEntry
                    : LocalArrayBufferTracker::kRemoveEntry;
       });
+  if (moved != nullptr) *moved += moved_buffers;
   return tracker->IsEmpty();
 }
 
@@ -6,6 +6,8 @@
 #define V8_HEAP_ARRAY_BUFFER_TRACKER_H_
 
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "src/allocation.h"
 #include "src/base/platform/mutex.h"
@@ -34,7 +36,8 @@ class ArrayBufferTracker : public AllStatic {
   inline static void RegisterNew(Heap* heap, JSArrayBuffer* buffer);
   inline static void Unregister(Heap* heap, JSArrayBuffer* buffer);
 
-  // Frees all backing store pointers for dead JSArrayBuffers in new space.
+  // Frees all backing store pointers for dead JSArrayBuffers in new space and
+  // reports their survival rate to the heap for pretenuring.
   // Does not take any locks and can only be called during Scavenge.
   static void FreeDeadInNewSpace(Heap* heap);
 
@@ -52,7 +55,10 @@ class ArrayBufferTracker : public AllStatic {
 
   // Processes all array buffers on a given page. |mode| specifies the action
   // to perform on the buffers. Returns whether the tracker is empty or not.
-  static bool ProcessBuffers(Page* page, ProcessingMode mode);
+  // If |moved| is given, the number of buffers that were moved to another
+  // page is added to it.
+  static bool ProcessBuffers(Page* page, ProcessingMode mode,
+                             size_t* moved = nullptr);
 
   // Returns whether a buffer is currently tracked.
   static bool IsTracked(JSArrayBuffer* buffer);
@@ -84,14 +90,17 @@ class LocalArrayBufferTracker {
   void Free(Callback should_free);
 
   // Processes buffers one by one. The CallbackResult of the callback decides
-  // what action to take on the buffer.
+  // what action to take on the buffer. Updated entries are handed over to the
+  // trackers of their new pages in batches, one batch per target page.
+  // Returns the number of updated entries.
   //
   // Callback should be of type:
   //   CallbackResult fn(JSArrayBuffer* buffer, JSArrayBuffer** new_buffer);
   template <typename Callback>
-  void Process(Callback callback);
+  size_t Process(Callback callback);
 
   bool IsEmpty() const { return array_buffers_.empty(); }
+  size_t size() const { return array_buffers_.size(); }
 
   bool IsTracked(JSArrayBuffer* buffer) const {
     return array_buffers_.find(buffer) != array_buffers_.end();
@@ -102,6 +111,11 @@ class LocalArrayBufferTracker {
  private:
   typedef std::unordered_set<JSArrayBuffer*> TrackingData;
 
+  // Adds buffers that were moved away from this tracker's page to the
+  // trackers of their target pages.
+  static void AddMovedBuffers(
+      std::vector<std::pair<Page*, JSArrayBuffer*>>* moved);
+
   Heap* heap_;
   // The set contains raw heap pointers which are removed by the GC upon
   // processing the tracker through its owning page.
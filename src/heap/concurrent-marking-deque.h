@@ -6,8 +6,12 @@
 #define V8_HEAP_CONCURRENT_MARKING_DEQUE_
 
 #include <deque>
+#include <vector>
 
+#include "src/base/logging.h"
+#include "src/base/macros.h"
 #include "src/base/platform/mutex.h"
+#include "src/heap/workstealing-marking-deque.h"
 
 namespace v8 {
 namespace internal {
@@ -20,36 +24,55 @@ enum class MarkingThread { kMain, kConcurrent };
 
 enum class TargetDeque { kShared, kBailout };
 
-// The concurrent marking deque supports deque operations for two threads:
-// main and concurrent. It is implemented using two deques: shared and bailout.
+// The concurrent marking deque supports deque operations for the main thread
+// and for up to kMaxTasks concurrent marking tasks. It is implemented using
+// two deques: shared and bailout.
 //
-// The concurrent thread can use the push and pop operations with the
-// MarkingThread::kConcurrent argument. All other operations are intended
-// to be used by the main thread only.
+// The concurrent tasks can use the push and pop operations with the
+// MarkingThread::kConcurrent argument and their task id. All other operations
+// are intended to be used by the main thread only.
 //
 // The interface of the concurrent marking deque for the main thread matches
 // that of the sequential marking deque, so they can be easily switched
 // at compile time without updating the main thread call-sites.
 //
-// The shared deque is shared between the main thread and the concurrent
-// thread, so both threads can push to and pop from the shared deque.
+// The shared deque is a pool of fixed-size segments that is shared between
+// the main thread and the concurrent tasks. The main thread pushes to and pops
+// from the pool directly. Each concurrent task owns a private segment that it
+// accesses without synchronization. A full private segment is published to
+// the pool and an empty private segment is refilled by stealing a segment
+// from the pool. Tasks must publish their private segment with FlushLocal
+// before they finish.
 // The bailout deque stores objects that cannot be processed by the concurrent
-// thread. Only the concurrent thread can push to it and only the main thread
+// tasks. Only the concurrent tasks can push to it and only the main thread
 // can pop from it.
 class ConcurrentMarkingDeque {
  public:
+  // The maximum number of concurrent tasks that can use the deque.
+  static const int kMaxTasks = 4;
+
   // The heap parameter is needed to match the interface
   // of the sequential marking deque.
-  explicit ConcurrentMarkingDeque(Heap* heap) {}
+  explicit ConcurrentMarkingDeque(Heap* heap) {
+    for (int i = 0; i < kMaxTasks; i++) {
+      local_[i].segment = nullptr;
+    }
+  }
+
+  ~ConcurrentMarkingDeque() { Clear(); }
 
   // Pushes the object into the specified deque assuming that the function is
   // called on the specified thread. The main thread can push only to the shared
-  // deque. The concurrent thread can push to both deques.
+  // deque. The concurrent tasks can push to both deques.
   bool Push(HeapObject* object, MarkingThread thread = MarkingThread::kMain,
-            TargetDeque target = TargetDeque::kShared) {
+            TargetDeque target = TargetDeque::kShared, int task_id = 0) {
     switch (target) {
       case TargetDeque::kShared:
-        shared_deque_.Push(object);
+        if (thread == MarkingThread::kMain) {
+          shared_deque_.Push(object);
+        } else {
+          PushLocal(task_id, object);
+        }
         break;
       case TargetDeque::kBailout:
         bailout_deque_.Push(object);
@@ -62,30 +85,62 @@ class ConcurrentMarkingDeque {
   // is called on the specified thread. The main thread first tries to pop the
   // bailout deque. If the deque is empty then it tries the shared deque.
   // If the shared deque is also empty, then the function returns nullptr.
-  // The concurrent thread pops only from the shared deque.
-  HeapObject* Pop(MarkingThread thread = MarkingThread::kMain) {
+  // The concurrent tasks pop from their private segment and steal from the
+  // shared deque when the private segment is empty.
+  HeapObject* Pop(MarkingThread thread = MarkingThread::kMain,
+                  int task_id = 0) {
     if (thread == MarkingThread::kMain) {
       HeapObject* result = bailout_deque_.Pop();
       if (result != nullptr) return result;
+      return shared_deque_.Pop();
+    }
+    return PopLocal(task_id);
+  }
+
+  // Publishes the private segment of the given concurrent task, so that the
+  // remaining objects are visible to the main thread and to other tasks.
+  void FlushLocal(int task_id) {
+    DCHECK_LT(task_id, kMaxTasks);
+    StackSegment* segment = local_[task_id].segment;
+    if (segment != nullptr && !segment->IsEmpty()) {
+      shared_deque_.PushSegment(segment);
+      local_[task_id].segment = nullptr;
     }
-    return shared_deque_.Pop();
   }
 
+  // Returns true if there are no objects that concurrent tasks could
+  // process. Private segments of running tasks are not taken into account.
+  bool IsSharedEmpty() { return shared_deque_.IsEmpty(); }
+
   // All the following operations can used only by the main thread.
+  // Operations that look at private segments require that no concurrent
+  // tasks are running.
   void Clear() {
     bailout_deque_.Clear();
     shared_deque_.Clear();
+    for (int i = 0; i < kMaxTasks; i++) {
+      delete local_[i].segment;
+      local_[i].segment = nullptr;
+    }
   }
 
   bool IsFull() { return false; }
 
   bool IsEmpty() { return bailout_deque_.IsEmpty() && shared_deque_.IsEmpty(); }
 
-  int Size() { return bailout_deque_.Size() + shared_deque_.Size(); }
+  int Size() {
+    int size = bailout_deque_.Size() + shared_deque_.Size();
+    for (int i = 0; i < kMaxTasks; i++) {
+      if (local_[i].segment != nullptr) {
+        size += static_cast<int>(local_[i].segment->Size());
+      }
+    }
+    return size;
+  }
 
   // This is used for a large array with a progress bar.
-  // For simpicity, unshift to the bailout deque so that the concurrent thread
-  // does not see such objects.
+  // For simpicity, unshift to the bailout deque so that the concurrent tasks
+  // do not see such objects.
   bool Unshift(HeapObject* object) {
     bailout_deque_.Unshift(object);
     return true;
@@ -99,12 +154,17 @@ class ConcurrentMarkingDeque {
   void Update(Callback callback) {
     bailout_deque_.Update(callback);
     shared_deque_.Update(callback);
+    for (int i = 0; i < kMaxTasks; i++) {
+      if (local_[i].segment != nullptr) {
+        local_[i].segment->Update(callback);
+      }
+    }
   }
 
   // These empty functions are needed to match the interface
   // of the sequential marking deque.
   void SetUp() {}
-  void TearDown() {}
+  void TearDown() { Clear(); }
   void StartUsing() {}
   void StopUsing() {}
   void ClearOverflowed() {}
@@ -112,6 +172,9 @@ class ConcurrentMarkingDeque {
   bool overflowed() const { return false; }
 
  private:
+  // Ensure that data of different threads does not share the same cache line.
+  static int const kCachePadding = 64;
+
   // Simple, slow, and thread-safe deque that forwards all operations to
   // a lock-protected std::deque.
   class Deque {
@@ -160,12 +223,119 @@ class ConcurrentMarkingDeque {
    private:
     base::Mutex mutex_;
     std::deque<HeapObject*> deque_;
-    // Ensure that two deques do not share the same cache line.
-    static int const kCachePadding = 64;
     char cache_padding_[kCachePadding];
   };
+
+  // Lock-protected pool of segments. The main thread pushes and pops single
+  // objects using the last segment, the concurrent tasks exchange whole
+  // segments.
+  class SegmentPool {
+   public:
+    SegmentPool() { cache_padding_[0] = 0; }
+    ~SegmentPool() { Clear(); }
+    void Clear() {
+      base::LockGuard<base::Mutex> guard(&mutex_);
+      for (StackSegment* segment : segments_) delete segment;
+      segments_.clear();
+    }
+    bool IsEmpty() {
+      base::LockGuard<base::Mutex> guard(&mutex_);
+      return segments_.empty();
+    }
+    int Size() {
+      base::LockGuard<base::Mutex> guard(&mutex_);
+      size_t size = 0;
+      for (StackSegment* segment : segments_) size += segment->Size();
+      return static_cast<int>(size);
+    }
+    void Push(HeapObject* object) {
+      base::LockGuard<base::Mutex> guard(&mutex_);
+      if (segments_.empty() || segments_.back()->IsFull()) {
+        segments_.push_back(new StackSegment(nullptr, nullptr));
+      }
+      segments_.back()->Push(object);
+    }
+    HeapObject* Pop() {
+      base::LockGuard<base::Mutex> guard(&mutex_);
+      if (segments_.empty()) return nullptr;
+      HeapObject* result = nullptr;
+      bool success = segments_.back()->Pop(&result);
+      DCHECK(success);
+      USE(success);
+      if (segments_.back()->IsEmpty()) {
+        delete segments_.back();
+        segments_.pop_back();
+      }
+      return result;
+    }
+    void PushSegment(StackSegment* segment) {
+      DCHECK(!segment->IsEmpty());
+      base::LockGuard<base::Mutex> guard(&mutex_);
+      segments_.push_back(segment);
+    }
+    StackSegment* PopSegment() {
+      base::LockGuard<base::Mutex> guard(&mutex_);
+      if (segments_.empty()) return nullptr;
+      StackSegment* result = segments_.back();
+      segments_.pop_back();
+      return result;
+    }
+    template <typename Callback>
+    void Update(Callback callback) {
+      base::LockGuard<base::Mutex> guard(&mutex_);
+      std::vector<StackSegment*> new_segments;
+      for (StackSegment* segment : segments_) {
+        segment->Update(callback);
+        if (segment->IsEmpty()) {
+          delete segment;
+        } else {
+          new_segments.push_back(segment);
+        }
+      }
+      segments_.swap(new_segments);
+    }
+
+   private:
+    base::Mutex mutex_;
+    std::vector<StackSegment*> segments_;
+    char cache_padding_[kCachePadding];
+  };
+
+  struct LocalSegment {
+    StackSegment* segment;
+    char cache_padding[kCachePadding];
+  };
+
+  void PushLocal(int task_id, HeapObject* object) {
+    DCHECK_LT(task_id, kMaxTasks);
+    StackSegment* segment = local_[task_id].segment;
+    if (segment == nullptr) {
+      segment = local_[task_id].segment = new StackSegment(nullptr, nullptr);
+    } else if (segment->IsFull()) {
+      shared_deque_.PushSegment(segment);
+      segment = local_[task_id].segment = new StackSegment(nullptr, nullptr);
+    }
+    segment->Push(object);
+  }
+
+  HeapObject* PopLocal(int task_id) {
+    DCHECK_LT(task_id, kMaxTasks);
+    StackSegment* segment = local_[task_id].segment;
+    HeapObject* result = nullptr;
+    if (segment != nullptr && segment->Pop(&result)) return result;
+    StackSegment* stolen = shared_deque_.PopSegment();
+    if (stolen == nullptr) return nullptr;
+    delete segment;
+    local_[task_id].segment = stolen;
+    bool success = stolen->Pop(&result);
+    DCHECK(success);
+    USE(success);
+    return result;
+  }
+
   Deque bailout_deque_;
-  Deque shared_deque_;
+  SegmentPool shared_deque_;
+  LocalSegment local_[kMaxTasks];
   DISALLOW_COPY_AND_ASSIGN(ConcurrentMarkingDeque);
 };
 
@@ -8,8 +8,11 @@
 #include <unordered_map>
 
 #include "src/heap/concurrent-marking-deque.h"
+#include "src/heap/gc-tracer.h"
 #include "src/heap/heap-inl.h"
 #include "src/heap/heap.h"
+#include "src/heap/mark-compact-inl.h"
+#include "src/heap/mark-compact.h"
 #include "src/heap/marking.h"
 #include "src/heap/objects-visiting-inl.h"
 #include "src/heap/objects-visiting.h"
@@ -48,12 +51,14 @@ class ConcurrentMarkingVisitor final
  public:
   using BaseClass = HeapVisitor<int, ConcurrentMarkingVisitor>;
 
-  explicit ConcurrentMarkingVisitor(ConcurrentMarkingDeque* deque)
-      : deque_(deque) {}
+  ConcurrentMarkingVisitor(ConcurrentMarkingDeque* deque, int task_id)
+      : deque_(deque), task_id_(task_id) {}
 
+  // Live bytes are accounted by the task that owns the visitor, so the mark
+  // bits are updated without touching the live byte counters of the page.
   bool ShouldVisit(HeapObject* object) override {
-    return ObjectMarking::GreyToBlack<MarkBit::AccessMode::ATOMIC>(
-        object, marking_state(object));
+    return Marking::GreyToBlack<MarkBit::AccessMode::ATOMIC>(
+        ObjectMarking::MarkBitFrom(object, marking_state(object)));
   }
 
   void VisitPointers(HeapObject* host, Object** start, Object** end) override {
@@ -62,14 +67,17 @@ class ConcurrentMarkingVisitor final
           base::Relaxed_Load(reinterpret_cast<const base::AtomicWord*>(p)));
       if (!object->IsHeapObject()) continue;
       MarkObject(HeapObject::cast(object));
+      MarkCompactCollector::RecordSlot(host, p, object);
     }
   }
 
-  void VisitPointersInSnapshot(const SlotSnapshot& snapshot) {
+  void VisitPointersInSnapshot(HeapObject* host, const SlotSnapshot& snapshot) {
     for (int i = 0; i < snapshot.number_of_slots(); i++) {
+      Object** slot = snapshot.slot(i);
       Object* object = snapshot.value(i);
       if (!object->IsHeapObject()) continue;
       MarkObject(HeapObject::cast(object));
+      MarkCompactCollector::RecordSlot(host, slot, object);
     }
   }
 
@@ -81,7 +89,7 @@ class ConcurrentMarkingVisitor final
     int size = JSObject::BodyDescriptor::SizeOf(map, object);
     const SlotSnapshot& snapshot = MakeSlotSnapshot(map, object, size);
     if (!ShouldVisit(object)) return 0;
-    VisitPointersInSnapshot(snapshot);
+    VisitPointersInSnapshot(object, snapshot);
     return size;
   }
 
@@ -111,7 +119,8 @@ class ConcurrentMarkingVisitor final
   // ===========================================================================
 
   int VisitCode(Map* map, Code* object) override {
-    deque_->Push(object, MarkingThread::kConcurrent, TargetDeque::kBailout);
+    deque_->Push(object, MarkingThread::kConcurrent, TargetDeque::kBailout,
+                 task_id_);
     return 0;
   }
 
@@ -121,56 +130,65 @@ class ConcurrentMarkingVisitor final
 
   int VisitBytecodeArray(Map* map, BytecodeArray* object) override {
     // TODO(ulan): implement iteration of strong fields.
-    deque_->Push(object, MarkingThread::kConcurrent, TargetDeque::kBailout);
+    deque_->Push(object, MarkingThread::kConcurrent, TargetDeque::kBailout,
+                 task_id_);
     return 0;
   }
 
   int VisitJSFunction(Map* map, JSFunction* object) override {
     // TODO(ulan): implement iteration of strong fields.
-    deque_->Push(object, MarkingThread::kConcurrent, TargetDeque::kBailout);
+    deque_->Push(object, MarkingThread::kConcurrent, TargetDeque::kBailout,
+                 task_id_);
     return 0;
   }
 
   int VisitMap(Map* map, Map* object) override {
     // TODO(ulan): implement iteration of strong fields.
-    deque_->Push(object, MarkingThread::kConcurrent, TargetDeque::kBailout);
+    deque_->Push(object, MarkingThread::kConcurrent, TargetDeque::kBailout,
+                 task_id_);
     return 0;
   }
 
   int VisitNativeContext(Map* map, Context* object) override {
     // TODO(ulan): implement iteration of strong fields.
-    deque_->Push(object, MarkingThread::kConcurrent, TargetDeque::kBailout);
+    deque_->Push(object, MarkingThread::kConcurrent, TargetDeque::kBailout,
+                 task_id_);
     return 0;
   }
 
   int VisitSharedFunctionInfo(Map* map, SharedFunctionInfo* object) override {
     // TODO(ulan): implement iteration of strong fields.
-    deque_->Push(object, MarkingThread::kConcurrent, TargetDeque::kBailout);
+    deque_->Push(object, MarkingThread::kConcurrent, TargetDeque::kBailout,
+                 task_id_);
     return 0;
   }
 
   int VisitTransitionArray(Map* map, TransitionArray* object) override {
     // TODO(ulan): implement iteration of strong fields.
-    deque_->Push(object, MarkingThread::kConcurrent, TargetDeque::kBailout);
+    deque_->Push(object, MarkingThread::kConcurrent, TargetDeque::kBailout,
+                 task_id_);
     return 0;
   }
 
   int VisitWeakCell(Map* map, WeakCell* object) override {
     // TODO(ulan): implement iteration of strong fields.
-    deque_->Push(object, MarkingThread::kConcurrent, TargetDeque::kBailout);
+    deque_->Push(object, MarkingThread::kConcurrent, TargetDeque::kBailout,
+                 task_id_);
     return 0;
   }
 
   int VisitJSWeakCollection(Map* map, JSWeakCollection* object) override {
     // TODO(ulan): implement iteration of strong fields.
-    deque_->Push(object, MarkingThread::kConcurrent, TargetDeque::kBailout);
+    deque_->Push(object, MarkingThread::kConcurrent, TargetDeque::kBailout,
+                 task_id_);
     return 0;
   }
 
   void MarkObject(HeapObject* object) {
     if (ObjectMarking::WhiteToGrey<MarkBit::AccessMode::ATOMIC>(
             object, marking_state(object))) {
-      deque_->Push(object, MarkingThread::kConcurrent, TargetDeque::kShared);
+      deque_->Push(object, MarkingThread::kConcurrent, TargetDeque::kShared,
+                   task_id_);
     }
   }
 
@@ -211,90 +229,177 @@ class ConcurrentMarkingVisitor final
   }
 
   ConcurrentMarkingDeque* deque_;
+  int task_id_;
   SlotSnapshot slot_snapshot_;
 };
 
 class ConcurrentMarking::Task : public CancelableTask {
  public:
   Task(Isolate* isolate, ConcurrentMarking* concurrent_marking,
-       base::Semaphore* on_finish)
+       TaskState* task_state, int task_id)
       : CancelableTask(isolate),
         concurrent_marking_(concurrent_marking),
-        on_finish_(on_finish) {}
+        task_state_(task_state),
+        task_id_(task_id) {}
 
   virtual ~Task() {}
 
  private:
   // v8::internal::CancelableTask overrides.
   void RunInternal() override {
-    concurrent_marking_->Run();
-    on_finish_->Signal();
+    concurrent_marking_->Run(task_id_, task_state_);
   }
 
   ConcurrentMarking* concurrent_marking_;
-  base::Semaphore* on_finish_;
+  TaskState* task_state_;
+  int task_id_;
   DISALLOW_COPY_AND_ASSIGN(Task);
 };
 
 ConcurrentMarking::ConcurrentMarking(Heap* heap, ConcurrentMarkingDeque* deque)
     : heap_(heap),
-      pending_task_semaphore_(0),
       deque_(deque),
-      visitor_(new ConcurrentMarkingVisitor(deque_)),
-      is_task_pending_(false) {
+      pending_task_count_(0),
+      task_count_(0) {
+  preemption_request_.SetValue(false);
+  for (int i = 0; i < kMaxTasks; i++) {
+    is_pending_[i] = false;
+    cancelable_id_[i] = 0;
+  }
   // The runtime flag should be set only if the compile time flag was set.
 #ifndef V8_CONCURRENT_MARKING
   CHECK(!FLAG_concurrent_marking);
 #endif
 }
 
-ConcurrentMarking::~ConcurrentMarking() { delete visitor_; }
-
-void ConcurrentMarking::Run() {
+void ConcurrentMarking::Run(int task_id, TaskState* task_state) {
+  // The preemption request is checked once per object, so a large object
+  // can delay the preemption by at most its visitation time.
+  LiveBytesMap* live_bytes = &task_state->live_bytes;
+  ConcurrentMarkingVisitor visitor(deque_, task_id);
   double time_ms = heap_->MonotonicallyIncreasingTimeInMs();
   size_t bytes_marked = 0;
   base::Mutex* relocation_mutex = heap_->relocation_mutex();
   {
     TimedScope scope(&time_ms);
-    HeapObject* object;
-    while ((object = deque_->Pop(MarkingThread::kConcurrent)) != nullptr) {
+    while (!preemption_request_.Value()) {
+      HeapObject* object = deque_->Pop(MarkingThread::kConcurrent, task_id);
+      if (object == nullptr) break;
       base::LockGuard<base::Mutex> guard(relocation_mutex);
       Address new_space_top = heap_->new_space()->original_top();
       Address new_space_limit = heap_->new_space()->original_limit();
       Address addr = object->address();
       if (new_space_top <= addr && addr < new_space_limit) {
-        deque_->Push(object, MarkingThread::kConcurrent, TargetDeque::kBailout);
+        deque_->Push(object, MarkingThread::kConcurrent, TargetDeque::kBailout,
+                     task_id);
       } else {
-        bytes_marked += visitor_->Visit(object);
+        int size = visitor.Visit(object);
+        if (size > 0) {
+          (*live_bytes)[Page::FromAddress(addr)] += size;
+          bytes_marked += size;
+        }
       }
     }
+    // Make the remaining work visible to the main thread and other tasks.
+    deque_->FlushLocal(task_id);
   }
+  heap_->tracer()->AddBackgroundScopeSample(
+      GCTracer::BackgroundScope::MC_BACKGROUND_MARKING, time_ms);
   if (FLAG_trace_concurrent_marking) {
-    heap_->isolate()->PrintWithTimestamp("concurrently marked %dKB in %.2fms\n",
-                                         static_cast<int>(bytes_marked / KB),
-                                         time_ms);
+    heap_->isolate()->PrintWithTimestamp(
+        "Task %d concurrently marked %dKB in %.2fms\n", task_id,
+        static_cast<int>(bytes_marked / KB), time_ms);
+  }
+  {
+    base::LockGuard<base::Mutex> guard(&pending_lock_);
+    is_pending_[task_id] = false;
+    --pending_task_count_;
+    pending_condition_.NotifyAll();
   }
 }
 
-void ConcurrentMarking::StartTask() {
+void ConcurrentMarking::ScheduleTasks() {
   if (!FLAG_concurrent_marking) return;
-  is_task_pending_ = true;
-  V8::GetCurrentPlatform()->CallOnBackgroundThread(
-      new Task(heap_->isolate(), this, &pending_task_semaphore_),
-      v8::Platform::kShortRunningTask);
+  base::LockGuard<base::Mutex> guard(&pending_lock_);
+  if (task_count_ == 0) {
+    // TODO(ulan): Increase the number of tasks for platforms that benefit
+    // from that.
+    task_count_ = static_cast<int>(
+        V8::GetCurrentPlatform()->NumberOfAvailableBackgroundThreads());
+    task_count_ = Max(Min(task_count_, kMaxTasks), 1);
+  }
+  for (int i = 0; i < task_count_; i++) {
+    if (!is_pending_[i]) {
+      if (FLAG_trace_concurrent_marking) {
+        heap_->isolate()->PrintWithTimestamp(
+            "Scheduling concurrent marking task %d\n", i);
+      }
+      is_pending_[i] = true;
+      ++pending_task_count_;
+      Task* task = new Task(heap_->isolate(), this, &task_state_[i], i);
+      cancelable_id_[i] = task->id();
+      V8::GetCurrentPlatform()->CallOnBackgroundThread(
+          task, v8::Platform::kShortRunningTask);
+    }
+  }
+}
+
+void ConcurrentMarking::RescheduleTasksIfNeeded() {
+  if (!FLAG_concurrent_marking) return;
+  {
+    base::LockGuard<base::Mutex> guard(&pending_lock_);
+    if (pending_task_count_ > 0) return;
+  }
+  if (!deque_->IsSharedEmpty()) {
+    ScheduleTasks();
+  }
 }
 
-void ConcurrentMarking::WaitForTaskToComplete() {
+void ConcurrentMarking::EnsureCompleted() {
   if (!FLAG_concurrent_marking) return;
-  pending_task_semaphore_.Wait();
-  is_task_pending_ = false;
+  {
+    base::LockGuard<base::Mutex> guard(&pending_lock_);
+    CancelableTaskManager* cancelable_task_manager =
+        heap_->isolate()->cancelable_task_manager();
+    for (int i = 0; i < task_count_; i++) {
+      if (is_pending_[i] &&
+          cancelable_task_manager->TryAbort(cancelable_id_[i]) ==
+              CancelableTaskManager::kTaskAborted) {
+        // The task did not start, so it will not notify us.
+        is_pending_[i] = false;
+        --pending_task_count_;
+      }
+    }
+    while (pending_task_count_ > 0) {
+      pending_condition_.Wait(&pending_lock_);
+    }
+  }
+  FlushLiveBytes();
 }
 
-void ConcurrentMarking::EnsureTaskCompleted() {
-  if (IsTaskPending()) {
-    WaitForTaskToComplete();
+void ConcurrentMarking::FlushLiveBytes() {
+  DCHECK_EQ(pending_task_count_, 0);
+  for (int i = 0; i < task_count_; i++) {
+    for (auto pair : task_state_[i].live_bytes) {
+      MarkingState::Internal(pair.first)
+          .IncrementLiveBytes<MarkBit::ATOMIC>(pair.second);
+    }
+    task_state_[i].live_bytes.clear();
   }
 }
 
+ConcurrentMarking::PauseScope::PauseScope(ConcurrentMarking* concurrent_marking)
+    : concurrent_marking_(concurrent_marking) {
+  if (!FLAG_concurrent_marking) return;
+  concurrent_marking_->preemption_request_.SetValue(true);
+  concurrent_marking_->EnsureCompleted();
+}
+
+ConcurrentMarking::PauseScope::~PauseScope() {
+  if (!FLAG_concurrent_marking) return;
+  concurrent_marking_->preemption_request_.SetValue(false);
+  concurrent_marking_->RescheduleTasksIfNeeded();
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -5,40 +5,79 @@
 #ifndef V8_HEAP_CONCURRENT_MARKING_
 #define V8_HEAP_CONCURRENT_MARKING_
 
+#include <unordered_map>
+
 #include "src/allocation.h"
+#include "src/base/atomic-utils.h"
+#include "src/base/platform/condition-variable.h"
+#include "src/base/platform/mutex.h"
 #include "src/cancelable-task.h"
+#include "src/heap/concurrent-marking-deque.h"
+#include "src/heap/spaces.h"
 #include "src/utils.h"
 #include "src/v8.h"
 
 namespace v8 {
 namespace internal {
 
-class ConcurrentMarkingDeque;
-class ConcurrentMarkingVisitor;
 class Heap;
 class Isolate;
 
 class ConcurrentMarking {
  public:
-  ConcurrentMarking(Heap* heap, ConcurrentMarkingDeque* deque_);
-  ~ConcurrentMarking();
+  // When the scope is entered, the concurrent marking tasks are preempted and
+  // publish their private work. The tasks are rescheduled when the scope is
+  // exited.
+  class PauseScope {
+   public:
+    explicit PauseScope(ConcurrentMarking* concurrent_marking);
+    ~PauseScope();
+
+   private:
+    ConcurrentMarking* concurrent_marking_;
+    DISALLOW_COPY_AND_ASSIGN(PauseScope);
+  };
+
+  static const int kMaxTasks = ConcurrentMarkingDeque::kMaxTasks;
+
+  ConcurrentMarking(Heap* heap, ConcurrentMarkingDeque* deque);
 
-  void StartTask();
-  void WaitForTaskToComplete();
-  bool IsTaskPending() { return is_task_pending_; }
-  void EnsureTaskCompleted();
+  // Schedules tasks that are not pending yet. The number of tasks is
+  // limited by kMaxTasks and the number of available background threads.
+  void ScheduleTasks();
+  // Schedules tasks if all tasks have finished, but there is still work
+  // in the shared deque.
+  void RescheduleTasksIfNeeded();
+  // Waits for scheduled tasks to finish and merges their live bytes.
+  void EnsureCompleted();
+
+  int TaskCount() const { return task_count_; }
 
  private:
+  typedef std::unordered_map<Page*, intptr_t, Page::Hasher> LiveBytesMap;
+
+  struct TaskState {
+    LiveBytesMap live_bytes;
+    char cache_line_padding[64];
+  };
   class Task;
-  void Run();
+  void Run(int task_id, TaskState* task_state);
+  void FlushLiveBytes();
+
   Heap* heap_;
-  base::Semaphore pending_task_semaphore_;
   ConcurrentMarkingDeque* deque_;
-  ConcurrentMarkingVisitor* visitor_;
-  bool is_task_pending_;
+  // Set by PauseScope to request running tasks to finish early.
+  base::AtomicValue<bool> preemption_request_;
+  TaskState task_state_[kMaxTasks];
+  base::Mutex pending_lock_;
+  base::ConditionVariable pending_condition_;
+  int pending_task_count_;
+  bool is_pending_[kMaxTasks];
+  uint32_t cancelable_id_[kMaxTasks];
+  int task_count_;
 };
 
 }  // namespace internal
 }  // namespace v8
 
-#endif  // V8_HEAP_PAGE_PARALLEL_JOB_
+#endif  // V8_HEAP_CONCURRENT_MARKING_
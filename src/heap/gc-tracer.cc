@@ -48,6 +48,48 @@ GCTracer::Scope::~Scope() {
   }
 }
 
+GCTracer::BackgroundScope::BackgroundScope(GCTracer* tracer, ScopeId scope)
+    : tracer_(tracer), scope_(scope) {
+  start_time_ = tracer_->heap_->MonotonicallyIncreasingTimeInMs();
+}
+
+GCTracer::BackgroundScope::~BackgroundScope() {
+  tracer_->AddBackgroundScopeSample(
+      scope_, tracer_->heap_->MonotonicallyIncreasingTimeInMs() - start_time_);
+}
+
+const double GCTracer::PauseHistogram::kBucketUpperBounds[] = {
+    0.1, 0.25, 0.5, 1, 2.5, 5, 10, 25, 50, 100, 250};
+
+GCTracer::PauseHistogram::PauseHistogram()
+    : count_(0), total_ms_(0.0), max_ms_(0.0) {
+  for (int i = 0; i < kNumberOfBuckets; i++) {
+    bucket_counts_[i] = 0;
+  }
+}
+
+void GCTracer::PauseHistogram::Add(double duration_ms) {
+  int bucket = 0;
+  while (bucket < kNumberOfBuckets - 1 &&
+         duration_ms >= kBucketUpperBounds[bucket]) {
+    bucket++;
+  }
+  bucket_counts_[bucket]++;
+  count_++;
+  total_ms_ += duration_ms;
+  max_ms_ = Max(max_ms_, duration_ms);
+}
+
+GCTracer::Telemetry::Telemetry()
+    : bytes_promoted(0), bytes_survived_new_space(0) {
+  for (int i = 0; i < BackgroundScope::NUMBER_OF_SCOPES; i++) {
+    background_time_ms[i] = 0.0;
+  }
+  for (int i = FIRST_SPACE; i <= LAST_SPACE; i++) {
+    bytes_freed[i] = 0;
+  }
+}
+
 const char* GCTracer::Scope::Name(ScopeId id) {
 #define CASE(scope)  \
   case Scope::scope: \
@@ -82,6 +124,9 @@ GCTracer::Event::Event(Type type, GarbageCollectionReason gc_reason,
   for (int i = 0; i < Scope::NUMBER_OF_SCOPES; i++) {
     scopes[i] = 0;
   }
+  for (int i = FIRST_SPACE; i <= LAST_SPACE; i++) {
+    start_space_object_size[i] = 0;
+  }
 }
 
 const char* GCTracer::Event::TypeName(bool short_name) const {
@@ -139,6 +184,7 @@ void GCTracer::ResetForTesting() {
   recorded_old_generation_allocations_.Reset();
   recorded_context_disposal_times_.Reset();
   recorded_survival_ratios_.Reset();
+  telemetry_ = Telemetry();
   start_counter_ = 0;
 }
 
@@ -184,6 +230,9 @@ void GCTracer::Start(GarbageCollector collector,
   current_.start_memory_size = heap_->memory_allocator()->Size();
   current_.start_holes_size = CountTotalHolesSize(heap_);
   current_.new_space_object_size = heap_->new_space()->Size();
+  for (int i = FIRST_SPACE; i <= LAST_SPACE; i++) {
+    current_.start_space_object_size[i] = heap_->space(i)->SizeOfObjects();
+  }
 
   current_.incremental_marking_bytes = 0;
   current_.incremental_marking_duration = 0;
@@ -288,6 +337,7 @@ void GCTracer::Stop(GarbageCollector collector) {
       UNREACHABLE();
   }
 
+  RecordTelemetry(duration);
   heap_->UpdateTotalGCTime(duration);
 
   if ((current_.type == Event::SCAVENGER ||
@@ -376,6 +426,70 @@ void GCTracer::AddIncrementalMarkingStep(double duration, size_t bytes) {
     incremental_marking_bytes_ += bytes;
     incremental_marking_duration_ += duration;
   }
+  telemetry_.pauses[Telemetry::kIncrementalMarkingStep].Add(duration);
+}
+
+void GCTracer::AddBackgroundScopeSample(BackgroundScope::ScopeId scope,
+                                        double duration) {
+  DCHECK_LT(scope, BackgroundScope::NUMBER_OF_SCOPES);
+  base::LockGuard<base::Mutex> guard(&background_time_mutex_);
+  telemetry_.background_time_ms[scope] += duration;
+}
+
+void GCTracer::GetTelemetry(Telemetry* telemetry) {
+  base::LockGuard<base::Mutex> guard(&background_time_mutex_);
+  *telemetry = telemetry_;
+}
+
+void GCTracer::RecordTelemetry(double duration) {
+  switch (current_.type) {
+    case Event::SCAVENGER:
+      telemetry_.pauses[Telemetry::kScavenge].Add(duration);
+      break;
+    case Event::MINOR_MARK_COMPACTOR:
+      telemetry_.pauses[Telemetry::kMinorMarkCompact].Add(duration);
+      break;
+    case Event::MARK_COMPACTOR:
+    case Event::INCREMENTAL_MARK_COMPACTOR:
+      telemetry_.pauses[Telemetry::kMarkCompact].Add(duration);
+      break;
+    case Event::START:
+      UNREACHABLE();
+  }
+
+  // Phases that did not run in this pause are not recorded.
+  const double* scopes = current_.scopes;
+  const double phases[] = {
+      scopes[Scope::MC_MARK] + scopes[Scope::MINOR_MC_MARK],
+      scopes[Scope::MC_SWEEP] + scopes[Scope::MINOR_MC_SWEEPING],
+      scopes[Scope::MC_EVACUATE_COPY] + scopes[Scope::MINOR_MC_EVACUATE_COPY],
+      scopes[Scope::MC_EVACUATE_UPDATE_POINTERS] +
+          scopes[Scope::MINOR_MC_EVACUATE_UPDATE_POINTERS],
+      scopes[Scope::HEAP_EXTERNAL_WEAK_GLOBAL_HANDLES]};
+  STATIC_ASSERT(arraysize(phases) ==
+                Telemetry::kNumberOfPauses - Telemetry::kMark);
+  for (size_t i = 0; i < arraysize(phases); i++) {
+    if (phases[i] > 0) telemetry_.pauses[Telemetry::kMark + i].Add(phases[i]);
+  }
+
+  const size_t promoted = heap_->promoted_objects_size();
+  const size_t survived = heap_->semi_space_copied_object_size();
+  telemetry_.bytes_promoted += promoted;
+  telemetry_.bytes_survived_new_space += survived;
+  for (int i = FIRST_SPACE; i <= LAST_SPACE; i++) {
+    size_t start_size = current_.start_space_object_size[i];
+    size_t end_size = heap_->space(i)->SizeOfObjects();
+    if (i == NEW_SPACE) {
+      // Everything in new space that was neither copied nor promoted died.
+      end_size = promoted + survived;
+    } else if (i == OLD_SPACE) {
+      // Promoted objects were not in old space when the pause started.
+      start_size += promoted;
+    }
+    if (start_size > end_size) {
+      telemetry_.bytes_freed[i] += start_size - end_size;
+    }
+  }
 }
 
 void GCTracer::Output(const char* format, ...) const {
@@ -465,6 +579,7 @@ void GCTracer::PrintNVP() const {
           "weak=%.2f "
           "roots=%.2f "
           "semispace=%.2f "
+          "parallel=%.2f "
           "steps_count=%d "
           "steps_took=%.1f "
           "scavenge_throughput=%.f "
@@ -504,6 +619,7 @@ void GCTracer::PrintNVP() const {
           current_.scopes[Scope::SCAVENGER_WEAK],
           current_.scopes[Scope::SCAVENGER_ROOTS],
           current_.scopes[Scope::SCAVENGER_SEMISPACE],
+          current_.scopes[Scope::SCAVENGER_SCAVENGE_PARALLEL],
           current_.incremental_marking_scopes[GCTracer::Scope::MC_INCREMENTAL]
               .steps,
           current_.scopes[Scope::MC_INCREMENTAL],
@@ -6,6 +6,7 @@
 #define V8_HEAP_GC_TRACER_H_
 
 #include "src/base/compiler-specific.h"
+#include "src/base/platform/mutex.h"
 #include "src/base/platform/platform.h"
 #include "src/base/ring-buffer.h"
 #include "src/counters.h"
@@ -106,9 +107,15 @@ enum ScavengeSpeedMode { kForAllObjects, kForSurvivedObjects };
   F(SCAVENGER_OLD_TO_NEW_POINTERS)                  \
   F(SCAVENGER_ROOTS)                                \
   F(SCAVENGER_SCAVENGE)                             \
+  F(SCAVENGER_SCAVENGE_PARALLEL)                    \
   F(SCAVENGER_SEMISPACE)                            \
   F(SCAVENGER_WEAK)
 
+#define TRACER_BACKGROUND_SCOPES(F) \
+  F(MC_BACKGROUND_MARKING)          \
+  F(MC_BACKGROUND_SWEEPING)         \
+  F(BACKGROUND_UNMAPPER)
+
 #define TRACE_GC(tracer, scope_id)                             \
   GCTracer::Scope::ScopeId gc_tracer_scope_id(scope_id);       \
   GCTracer::Scope gc_tracer_scope(tracer, gc_tracer_scope_id); \
@@ -168,6 +175,81 @@ class V8_EXPORT_PRIVATE GCTracer {
     DISALLOW_COPY_AND_ASSIGN(Scope);
   };
 
+  // Measures time spent in garbage collection work on background threads.
+  // Can be used from any thread.
+  class BackgroundScope {
+   public:
+    enum ScopeId {
+#define DEFINE_SCOPE(scope) scope,
+      TRACER_BACKGROUND_SCOPES(DEFINE_SCOPE)
+#undef DEFINE_SCOPE
+          NUMBER_OF_SCOPES
+    };
+
+    BackgroundScope(GCTracer* tracer, ScopeId scope);
+    ~BackgroundScope();
+
+   private:
+    GCTracer* tracer_;
+    ScopeId scope_;
+    double start_time_;
+
+    DISALLOW_COPY_AND_ASSIGN(BackgroundScope);
+  };
+
+  // Histogram of pause times with exponentially growing buckets.
+  class PauseHistogram {
+   public:
+    static const int kNumberOfBuckets = 12;
+    // Exclusive upper bounds of the buckets in milliseconds. The last bucket
+    // is unbounded.
+    static const double kBucketUpperBounds[kNumberOfBuckets - 1];
+
+    PauseHistogram();
+
+    void Add(double duration_ms);
+
+    size_t bucket_count(int index) const { return bucket_counts_[index]; }
+    size_t count() const { return count_; }
+    double total_ms() const { return total_ms_; }
+    double max_ms() const { return max_ms_; }
+
+   private:
+    size_t bucket_counts_[kNumberOfBuckets];
+    size_t count_;
+    double total_ms_;
+    double max_ms_;
+  };
+
+  // Cumulative pause histograms and byte counts since the creation of the
+  // heap. They are updated at the end of every garbage collection and are
+  // cheap enough to be always on.
+  struct Telemetry {
+    enum Pause {
+      // Whole atomic pauses of the different collectors.
+      kScavenge,
+      kMinorMarkCompact,
+      kMarkCompact,
+      kIncrementalMarkingStep,
+      // Phases of the (minor) mark-compact pauses.
+      kMark,
+      kSweep,
+      kEvacuate,
+      kUpdatePointers,
+      // Phase of all pauses.
+      kExternalWeakHandles,
+      kNumberOfPauses
+    };
+
+    Telemetry();
+
+    PauseHistogram pauses[kNumberOfPauses];
+    double background_time_ms[BackgroundScope::NUMBER_OF_SCOPES];
+    size_t bytes_promoted;
+    size_t bytes_survived_new_space;
+    size_t bytes_freed[LAST_SPACE + 1];
+  };
+
 
   class Event {
    public:
@@ -235,6 +317,9 @@ class V8_EXPORT_PRIVATE GCTracer {
     // Amounts of time spent in different scopes during GC.
     double scopes[Scope::NUMBER_OF_SCOPES];
 
+    // Size of objects in each space at the start of the GC, set in Start().
+    size_t start_space_object_size[LAST_SPACE + 1];
+
     // Holds details for incremental marking scopes.
     IncrementalMarkingInfos
         incremental_marking_scopes[Scope::NUMBER_OF_INCREMENTAL_SCOPES];
@@ -341,6 +426,13 @@ class V8_EXPORT_PRIVATE GCTracer {
 
   void NotifyIncrementalMarkingStart();
 
+  // Thread-safe.
+  void AddBackgroundScopeSample(BackgroundScope::ScopeId scope,
+                                double duration);
+
+  // Copies the cumulative telemetry into |telemetry|.
+  void GetTelemetry(Telemetry* telemetry);
+
   V8_INLINE void AddScopeSample(Scope::ScopeId scope, double duration) {
     DCHECK(scope < Scope::NUMBER_OF_SCOPES);
     if (scope >= Scope::FIRST_INCREMENTAL_SCOPE &&
@@ -373,6 +465,7 @@ class V8_EXPORT_PRIVATE GCTracer {
   void ResetForTesting();
   void ResetIncrementalMarkingCounters();
   void RecordIncrementalMarkingSpeed(size_t bytes, double duration);
+  void RecordTelemetry(double duration);
 
   // Print one detailed trace line in name=value format.
   // TODO(ernstm): Move to Heap.
@@ -450,6 +543,10 @@ class V8_EXPORT_PRIVATE GCTracer {
   base::RingBuffer<double> recorded_context_disposal_times_;
   base::RingBuffer<double> recorded_survival_ratios_;
 
+  Telemetry telemetry_;
+  // Guards telemetry_.background_time_ms.
+  base::Mutex background_time_mutex_;
+
   DISALLOW_COPY_AND_ASSIGN(GCTracer);
 };
 }  // namespace internal
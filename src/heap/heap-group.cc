@@ -0,0 +1,123 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/heap-group.h"
+
+#include <algorithm>
+
+#include "src/heap/heap.h"
+
+namespace v8 {
+namespace internal {
+
+HeapGroup::HeapGroup(size_t old_generation_budget)
+    : old_generation_budget_(old_generation_budget) {}
+
+HeapGroup::~HeapGroup() { DCHECK(members_.empty()); }
+
+void HeapGroup::AddHeap(Heap* heap, size_t old_generation_size,
+                        size_t limit) {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  DCHECK_NULL(FindMember(heap));
+  members_.push_back({heap, old_generation_size, limit, 0, false});
+}
+
+void HeapGroup::RemoveHeap(Heap* heap) {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  auto it = std::find_if(members_.begin(), members_.end(),
+                         [heap](const Member& m) { return m.heap == heap; });
+  DCHECK(it != members_.end());
+  members_.erase(it);
+}
+
+size_t HeapGroup::UpdateHeap(Heap* heap, size_t old_generation_size,
+                             size_t limit, size_t min_limit, bool full_gc) {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  Member* member = FindMember(heap);
+  DCHECK_NOT_NULL(member);
+  member->old_generation_size = old_generation_size;
+  if (full_gc) member->memory_pressure_pending = false;
+
+  size_t others = TotalOldGenerationSizeLocked() - old_generation_size;
+  size_t available =
+      old_generation_budget_ > others ? old_generation_budget_ - others : 0;
+  limit = Min(limit, Max(available, min_limit));
+  member->old_generation_allocation_limit = limit;
+
+  // The notifications are sent under the lock so that RemoveHeap cannot tear
+  // down a member in the meantime. For a heap whose isolate is not locked
+  // the notification only requests an interrupt and posts a task, so it does
+  // not report back to the group.
+  std::vector<Heap*> heaps_to_notify;
+  SelectMembersToNotify(&heaps_to_notify);
+  for (Heap* member_heap : heaps_to_notify) {
+    member_heap->MemoryPressureNotification(MemoryPressureLevel::kCritical,
+                                            false);
+  }
+  return limit;
+}
+
+size_t HeapGroup::NumberOfMembers() {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  return members_.size();
+}
+
+size_t HeapGroup::TotalOldGenerationSize() {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  return TotalOldGenerationSizeLocked();
+}
+
+bool HeapGroup::GetMemberStatistics(size_t index, MemberStatistics* stats) {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  if (index >= members_.size()) return false;
+  const Member& member = members_[index];
+  stats->heap = member.heap;
+  stats->old_generation_size = member.old_generation_size;
+  stats->old_generation_allocation_limit =
+      member.old_generation_allocation_limit;
+  stats->memory_pressure_notifications = member.memory_pressure_notifications;
+  return true;
+}
+
+HeapGroup::Member* HeapGroup::FindMember(Heap* heap) {
+  for (Member& member : members_) {
+    if (member.heap == heap) return &member;
+  }
+  return nullptr;
+}
+
+size_t HeapGroup::TotalOldGenerationSizeLocked() {
+  size_t total = 0;
+  for (const Member& member : members_) total += member.old_generation_size;
+  return total;
+}
+
+void HeapGroup::SelectMembersToNotify(std::vector<Heap*>* heaps) {
+  size_t total = TotalOldGenerationSizeLocked();
+  if (total <= old_generation_budget_) return;
+  size_t overshoot = total - old_generation_budget_;
+
+  std::vector<Member*> by_size;
+  by_size.reserve(members_.size());
+  for (Member& member : members_) by_size.push_back(&member);
+  std::sort(by_size.begin(), by_size.end(), [](Member* a, Member* b) {
+    return a->old_generation_size > b->old_generation_size;
+  });
+
+  // Members that were already notified and did not perform a full garbage
+  // collection since count towards the memory that is being reclaimed.
+  size_t covered = 0;
+  for (Member* member : by_size) {
+    if (covered >= overshoot) break;
+    if (!member->memory_pressure_pending) {
+      member->memory_pressure_pending = true;
+      member->memory_pressure_notifications++;
+      heaps->push_back(member->heap);
+    }
+    covered += member->old_generation_size;
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
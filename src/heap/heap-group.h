@@ -0,0 +1,84 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_HEAP_GROUP_H_
+#define V8_HEAP_HEAP_GROUP_H_
+
+#include <vector>
+
+#include "src/base/macros.h"
+#include "src/base/platform/mutex.h"
+#include "src/globals.h"
+
+namespace v8 {
+namespace internal {
+
+class Heap;
+
+// A HeapGroup distributes a single old generation budget between the heaps of
+// several isolates living in the same process.
+//
+// Members report their old generation size after every garbage collection.
+// The group caps the allocation limit of the reporting member to the part of
+// the budget that is not used by the other members, so that a member triggers
+// its own garbage collections before it pushes the group over budget. When the
+// group is over budget nevertheless, the largest members receive a critical
+// memory pressure notification first.
+//
+// All methods are thread-safe.
+class V8_EXPORT_PRIVATE HeapGroup {
+ public:
+  struct MemberStatistics {
+    Heap* heap;
+    size_t old_generation_size;
+    size_t old_generation_allocation_limit;
+    size_t memory_pressure_notifications;
+  };
+
+  explicit HeapGroup(size_t old_generation_budget);
+  ~HeapGroup();
+
+  void AddHeap(Heap* heap, size_t old_generation_size, size_t limit);
+  void RemoveHeap(Heap* heap);
+
+  // Records the old generation size of |heap| after a garbage collection and
+  // returns its new allocation limit, which is |limit| capped to the share of
+  // the budget left by the other members but not lower than |min_limit|.
+  size_t UpdateHeap(Heap* heap, size_t old_generation_size, size_t limit,
+                    size_t min_limit, bool full_gc);
+
+  size_t old_generation_budget() const { return old_generation_budget_; }
+  size_t NumberOfMembers();
+  size_t TotalOldGenerationSize();
+  bool GetMemberStatistics(size_t index, MemberStatistics* stats);
+
+ private:
+  struct Member {
+    Heap* heap;
+    size_t old_generation_size;
+    size_t old_generation_allocation_limit;
+    size_t memory_pressure_notifications;
+    // Set when the member was asked to free memory and cleared by its next
+    // full garbage collection, so that members are not notified repeatedly.
+    bool memory_pressure_pending;
+  };
+
+  // The following methods require |mutex_| to be held.
+  Member* FindMember(Heap* heap);
+  size_t TotalOldGenerationSizeLocked();
+  // Marks the largest members that have to free memory for the group to get
+  // back under budget and appends their heaps to |heaps|.
+  void SelectMembersToNotify(std::vector<Heap*>* heaps);
+
+  const size_t old_generation_budget_;
+  base::Mutex mutex_;
+  std::vector<Member> members_;
+
+  DISALLOW_COPY_AND_ASSIGN(HeapGroup);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_HEAP_GROUP_H_
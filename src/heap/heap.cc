@@ -29,6 +29,7 @@
 #include "src/heap/embedder-tracing.h"
 #include "src/heap/gc-idle-time-handler.h"
 #include "src/heap/gc-tracer.h"
+#include "src/heap/heap-group.h"
 #include "src/heap/incremental-marking.h"
 #include "src/heap/mark-compact-inl.h"
 #include "src/heap/mark-compact.h"
@@ -101,6 +102,7 @@ Heap::Heap()
       survived_last_scavenge_(0),
       always_allocate_scope_count_(0),
       memory_pressure_level_(MemoryPressureLevel::kNone),
+      heap_group_(nullptr),
       out_of_memory_callback_(nullptr),
       out_of_memory_callback_data_(nullptr),
       contexts_disposed_(0),
@@ -111,6 +113,7 @@ Heap::Heap()
       code_space_(NULL),
       map_space_(NULL),
       lo_space_(NULL),
+      new_lo_space_(NULL),
       gc_state_(NOT_IN_GC),
       gc_post_processing_depth_(0),
       allocations_count_(0),
@@ -153,6 +156,9 @@ Heap::Heap()
       old_generation_size_at_last_gc_(0),
       gcs_since_last_deopt_(0),
       global_pretenuring_feedback_(nullptr),
+      array_buffers_scavenged_(0),
+      array_buffers_survived_(0),
+      pretenure_array_buffers_(false),
       ring_buffer_full_(false),
       ring_buffer_end_(0),
       promotion_queue_(this),
@@ -213,7 +219,8 @@ size_t Heap::CommittedOldGenerationMemory() {
 size_t Heap::CommittedMemory() {
   if (!HasBeenSetUp()) return 0;
 
-  return new_space_->CommittedMemory() + CommittedOldGenerationMemory();
+  return new_space_->CommittedMemory() + new_lo_space_->Size() +
+         CommittedOldGenerationMemory();
 }
 
 
@@ -224,7 +231,8 @@ size_t Heap::CommittedPhysicalMemory() {
          old_space_->CommittedPhysicalMemory() +
          code_space_->CommittedPhysicalMemory() +
          map_space_->CommittedPhysicalMemory() +
-         lo_space_->CommittedPhysicalMemory();
+         lo_space_->CommittedPhysicalMemory() +
+         new_lo_space_->CommittedPhysicalMemory();
 }
 
 size_t Heap::CommittedMemoryExecutable() {
@@ -257,7 +265,7 @@ size_t Heap::Available() {
 
 bool Heap::HasBeenSetUp() {
   return old_space_ != NULL && code_space_ != NULL && map_space_ != NULL &&
-         lo_space_ != NULL;
+         lo_space_ != NULL && new_lo_space_ != NULL;
 }
 
 
@@ -1415,6 +1423,12 @@ bool Heap::PerformGarbageCollection(
              old_generation_size_configured_) {
     DampenOldGenerationAllocationLimit(old_gen_size, gc_speed, mutator_speed);
   }
+  if (heap_group_ != nullptr) {
+    old_generation_allocation_limit_ = heap_group_->UpdateHeap(
+        this, old_gen_size, old_generation_allocation_limit_,
+        old_gen_size + MinimumAllocationLimitGrowingStep(),
+        collector == MARK_COMPACTOR);
+  }
 
   {
     GCCallbacksScope scope(this);
@@ -1507,6 +1521,7 @@ void Heap::MinorMarkCompact() {
   LOG(isolate_, ResourceEvent("MinorMarkCompact", "begin"));
 
   TRACE_GC(tracer(), GCTracer::Scope::MINOR_MC);
+  ConcurrentMarking::PauseScope pause_concurrent_marking(concurrent_marking());
   AlwaysAllocateScope always_allocate(isolate());
   PauseAllocationObserversScope pause_observers(this);
   IncrementalMarking::PauseBlackAllocationScope pause_black_allocation(
@@ -1568,7 +1583,7 @@ void Heap::CheckNewSpaceExpansionCriteria() {
 }
 
 
-static bool IsUnscavengedHeapObject(Heap* heap, Object** p) {
+bool Heap::IsUnscavengedHeapObject(Heap* heap, Object** p) {
   return heap->InNewSpace(*p) &&
          !HeapObject::cast(*p)->map_word().IsForwardingAddress();
 }
@@ -1680,6 +1695,9 @@ void Heap::EvacuateYoungGeneration() {
 
 void Heap::Scavenge() {
   TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_SCAVENGE);
+  // The marking deque is updated after scavenging, which requires the
+  // concurrent marking tasks to publish their private work first.
+  ConcurrentMarking::PauseScope pause_concurrent_marking(concurrent_marking());
   base::LockGuard<base::Mutex> guard(relocation_mutex());
   // There are soft limits in the allocation code, designed to trigger a mark
   // sweep collection by failing allocations. There is no sense in trying to
@@ -1709,7 +1727,48 @@ void Heap::Scavenge() {
   // live objects.
   new_space_->Flip();
   new_space_->ResetAllocationInfo();
+  new_lo_space_->Flip();
+
+  isolate()->global_handles()->IdentifyWeakUnmodifiedObjects(
+      &JSObject::IsUnmodifiedApiObject);
+
+  if (FLAG_parallel_scavenge && scavenge_collector_->CanScavengeInParallel()) {
+    scavenge_collector_->ScavengeInParallel();
+  } else {
+    ScavengeSequentially();
+  }
+
+  UpdateNewSpaceReferencesInExternalStringTable(
+      &UpdateNewSpaceReferenceInExternalStringTableEntry);
+
+  incremental_marking()->UpdateMarkingDequeAfterScavenge();
+
+  ScavengeWeakObjectRetainer weak_object_retainer(this);
+  ProcessYoungWeakReferences(&weak_object_retainer);
+
+  // Set age mark.
+  new_space_->set_age_mark(new_space_->top());
+
+  ArrayBufferTracker::FreeDeadInNewSpace(this);
+
+  // Surviving young large objects have been promoted during scavenging.
+  new_lo_space_->FreeDeadObjects();
+
+  // Update how much has survived scavenge.
+  DCHECK_GE(PromotedSpaceSizeOfObjects(), survived_watermark);
+  IncrementYoungSurvivorsCounter(PromotedSpaceSizeOfObjects() +
+                                 new_space_->Size() - survived_watermark);
+
+  // Scavenger may find new wrappers by iterating objects promoted onto a black
+  // page.
+  local_embedder_heap_tracer()->RegisterWrappersWithRemoteTracer();
+
+  LOG(isolate_, ResourceEvent("scavenge", "end"));
+
+  SetGCState(NOT_IN_GC);
+}
 
+void Heap::ScavengeSequentially() {
   // We need to sweep newly copied objects which can be either in the
   // to space or promoted to the old generation.  For to-space
   // objects, we treat the bottom of the to space as a queue.  Newly
@@ -1732,9 +1791,6 @@ void Heap::Scavenge() {
 
   RootScavengeVisitor root_scavenge_visitor(this);
 
-  isolate()->global_handles()->IdentifyWeakUnmodifiedObjects(
-      &JSObject::IsUnmodifiedApiObject);
-
   {
     // Copy roots.
     TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_ROOTS);
@@ -1780,35 +1836,9 @@ void Heap::Scavenge() {
       &root_scavenge_visitor);
   new_space_front = DoScavenge(new_space_front);
 
-  UpdateNewSpaceReferencesInExternalStringTable(
-      &UpdateNewSpaceReferenceInExternalStringTableEntry);
-
   promotion_queue_.Destroy();
 
-  incremental_marking()->UpdateMarkingDequeAfterScavenge();
-
-  ScavengeWeakObjectRetainer weak_object_retainer(this);
-  ProcessYoungWeakReferences(&weak_object_retainer);
-
   DCHECK(new_space_front == new_space_->top());
-
-  // Set age mark.
-  new_space_->set_age_mark(new_space_->top());
-
-  ArrayBufferTracker::FreeDeadInNewSpace(this);
-
-  // Update how much has survived scavenge.
-  DCHECK_GE(PromotedSpaceSizeOfObjects(), survived_watermark);
-  IncrementYoungSurvivorsCounter(PromotedSpaceSizeOfObjects() +
-                                 new_space_->Size() - survived_watermark);
-
-  // Scavenger may find new wrappers by iterating objects promoted onto a black
-  // page.
-  local_embedder_heap_tracer()->RegisterWrappersWithRemoteTracer();
-
-  LOG(isolate_, ResourceEvent("scavenge", "end"));
-
-  SetGCState(NOT_IN_GC);
 }
 
 void Heap::ComputeFastPromotionMode(double survival_rate) {
@@ -1938,6 +1968,29 @@ void Heap::ResetAllAllocationSitesDependentCode(PretenureFlag flag) {
   if (marked) isolate_->stack_guard()->RequestDeoptMarkedAllocationSites();
 }
 
+void Heap::RecordArrayBufferSurvival(size_t scavenged, size_t survived) {
+  if (!FLAG_allocation_site_pretenuring) return;
+  DCHECK_LE(survived, scavenged);
+  array_buffers_scavenged_ += scavenged;
+  array_buffers_survived_ += survived;
+  if (array_buffers_scavenged_ <
+      static_cast<size_t>(AllocationSite::kPretenureMinimumCreated)) {
+    return;
+  }
+  double ratio = static_cast<double>(array_buffers_survived_) /
+                 static_cast<double>(array_buffers_scavenged_);
+  bool pretenure = ratio >= AllocationSite::kPretenureRatio;
+  if (FLAG_trace_pretenuring && pretenure != pretenure_array_buffers_) {
+    PrintIsolate(isolate(),
+                 "pretenuring: array buffers %s (survived %" PRIuS
+                 " of %" PRIuS ")\n",
+                 pretenure ? "tenured" : "not tenured", array_buffers_survived_,
+                 array_buffers_scavenged_);
+  }
+  pretenure_array_buffers_ = pretenure;
+  array_buffers_scavenged_ = 0;
+  array_buffers_survived_ = 0;
+}
 
 void Heap::EvaluateOldSpaceLocalPretenuring(
     uint64_t size_of_objects_before_gc) {
@@ -1952,6 +2005,7 @@ void Heap::EvaluateOldSpaceLocalPretenuring(
     // dependent code registered in the allocation sites to re-evaluate
     // our pretenuring decisions.
     ResetAllAllocationSitesDependentCode(TENURED);
+    pretenure_array_buffers_ = false;
     if (FLAG_trace_pretenuring) {
       PrintF(
           "Deopt all allocation sites dependent code due to low survival "
@@ -3156,7 +3210,9 @@ bool Heap::CanMoveObjectStart(HeapObject* object) {
 
   Address address = object->address();
 
-  if (lo_space()->Contains(object)) return false;
+  if (lo_space()->Contains(object) || new_lo_space()->Contains(object)) {
+    return false;
+  }
 
   // We can move the object start if the page was already swept.
   return Page::FromAddress(address)->SweepingDone();
@@ -3174,6 +3230,8 @@ void Heap::AdjustLiveBytes(HeapObject* object, int by) {
   // marking the whole object graph, without updating live bytes.
   if (lo_space()->Contains(object)) {
     lo_space()->AdjustLiveBytes(by);
+  } else if (new_lo_space()->Contains(object)) {
+    new_lo_space()->AdjustLiveBytes(by);
   } else if (!in_heap_iterator() &&
              !mark_compact_collector()->sweeping_in_progress() &&
              ObjectMarking::IsBlack(object, MarkingState::Internal(object))) {
@@ -3201,6 +3259,7 @@ FixedArrayBase* Heap::LeftTrimFixedArray(FixedArrayBase* object,
   // In large object space the object's start must coincide with chunk
   // and thus the trick is just not applicable.
   DCHECK(!lo_space()->Contains(object));
+  DCHECK(!new_lo_space()->Contains(object));
   DCHECK(object->map() != fixed_cow_array_map());
 
   STATIC_ASSERT(FixedArrayBase::kMapOffset == 0);
@@ -3289,7 +3348,7 @@ void Heap::RightTrimFixedArray(FixedArrayBase* object, int elements_to_trim) {
   // We do not create a filler for objects in large object space.
   // TODO(hpayer): We should shrink the large object page if the size
   // of the object changed significantly.
-  if (!lo_space()->Contains(object)) {
+  if (!lo_space()->Contains(object) && !new_lo_space()->Contains(object)) {
     HeapObject* filler =
         CreateFillerObjectAt(new_end, bytes_to_trim, ClearRecordedSlots::kYes);
     DCHECK_NOT_NULL(filler);
@@ -4288,6 +4347,12 @@ void Heap::NotifyObjectLayoutChange(HeapObject* object,
                                     const DisallowHeapAllocation&) {
   if (FLAG_incremental_marking && incremental_marking()->IsMarking()) {
     incremental_marking()->MarkBlackAndPush(object);
+    if (incremental_marking()->IsCompacting() && !InNewSpace(object)) {
+      // The concurrent marker might have recorded slots for the object
+      // with the old layout. They are filtered out when pointers are updated.
+      MemoryChunk::FromAddress(object->address())
+          ->RegisterObjectWithInvalidatedSlots(object, object->Size());
+    }
   }
 #ifdef VERIFY_HEAP
   DCHECK(pending_layout_change_object_ == nullptr);
@@ -4584,6 +4649,23 @@ void Heap::MemoryPressureNotification(MemoryPressureLevel level,
   }
 }
 
+void Heap::SetHeapMemoryTarget(size_t committed_bytes) {
+  memory_reducer_->SetTargetCommittedMemory(committed_bytes);
+}
+
+void Heap::MemoryReducerIdleNotification(double idle_time_in_ms) {
+  memory_reducer_->NotifyIdle(idle_time_in_ms);
+}
+
+void Heap::SetHeapGroup(HeapGroup* group) {
+  if (heap_group_ != nullptr) heap_group_->RemoveHeap(this);
+  heap_group_ = group;
+  if (heap_group_ != nullptr) {
+    heap_group_->AddHeap(this, PromotedSpaceSizeOfObjects(),
+                         old_generation_allocation_limit_);
+  }
+}
+
 void Heap::SetOutOfMemoryCallback(v8::debug::OutOfMemoryCallback callback,
                                   void* data) {
   out_of_memory_callback_ = callback;
@@ -4714,7 +4796,7 @@ bool Heap::Contains(HeapObject* value) {
   return HasBeenSetUp() &&
          (new_space_->ToSpaceContains(value) || old_space_->Contains(value) ||
           code_space_->Contains(value) || map_space_->Contains(value) ||
-          lo_space_->Contains(value));
+          lo_space_->Contains(value) || new_lo_space_->Contains(value));
 }
 
 bool Heap::ContainsSlow(Address addr) {
@@ -4724,7 +4806,8 @@ bool Heap::ContainsSlow(Address addr) {
   return HasBeenSetUp() &&
          (new_space_->ToSpaceContainsSlow(addr) ||
           old_space_->ContainsSlow(addr) || code_space_->ContainsSlow(addr) ||
-          map_space_->ContainsSlow(addr) || lo_space_->ContainsSlow(addr));
+          map_space_->ContainsSlow(addr) || lo_space_->ContainsSlow(addr) ||
+          new_lo_space_->ContainsSlow(addr));
 }
 
 bool Heap::InSpace(HeapObject* value, AllocationSpace space) {
@@ -4735,7 +4818,8 @@ bool Heap::InSpace(HeapObject* value, AllocationSpace space) {
 
   switch (space) {
     case NEW_SPACE:
-      return new_space_->ToSpaceContains(value);
+      return new_space_->ToSpaceContains(value) ||
+             new_lo_space_->Contains(value);
     case OLD_SPACE:
       return old_space_->Contains(value);
     case CODE_SPACE:
@@ -4756,7 +4840,8 @@ bool Heap::InSpaceSlow(Address addr, AllocationSpace space) {
 
   switch (space) {
     case NEW_SPACE:
-      return new_space_->ToSpaceContainsSlow(addr);
+      return new_space_->ToSpaceContainsSlow(addr) ||
+             new_lo_space_->ContainsSlow(addr);
     case OLD_SPACE:
       return old_space_->ContainsSlow(addr);
     case CODE_SPACE:
@@ -4824,6 +4909,7 @@ void Heap::Verify() {
   code_space_->Verify(&no_dirty_regions_visitor);
 
   lo_space_->Verify();
+  new_lo_space_->Verify();
 
   mark_compact_collector()->VerifyWeakEmbeddedObjectsInCode();
   if (FLAG_omit_map_checks_for_leaf_maps) {
@@ -4983,7 +5069,9 @@ class IterateAndScavengePromotedObjectsVisitor final : public ObjectVisitor {
   inline void VisitPointers(HeapObject* host, Object** start,
                             Object** end) override {
     Address slot_address = reinterpret_cast<Address>(start);
-    Page* page = Page::FromAddress(slot_address);
+    // The chunk is computed from the host as slots of promoted large objects
+    // may lie beyond the first page of the chunk.
+    MemoryChunk* chunk = MemoryChunk::FromAddress(host->address());
 
     while (slot_address < reinterpret_cast<Address>(end)) {
       Object** slot = reinterpret_cast<Object**>(slot_address);
@@ -4997,7 +5085,7 @@ class IterateAndScavengePromotedObjectsVisitor final : public ObjectVisitor {
           if (heap_->InNewSpace(target)) {
             SLOW_DCHECK(heap_->InToSpace(target));
             SLOW_DCHECK(target->IsHeapObject());
-            RememberedSet<OLD_TO_NEW>::Insert(page, slot_address);
+            RememberedSet<OLD_TO_NEW>::Insert(chunk, slot_address);
           }
           SLOW_DCHECK(!MarkCompactCollector::IsOnEvacuationCandidate(
               HeapObject::cast(target)));
@@ -5694,6 +5782,9 @@ bool Heap::SetUp() {
   space_[LO_SPACE] = lo_space_ = new LargeObjectSpace(this, LO_SPACE);
   if (!lo_space_->SetUp()) return false;
 
+  new_lo_space_ = new NewLargeObjectSpace(this);
+  if (!new_lo_space_->SetUp()) return false;
+
   // Set up the seed that is used to randomize the string hash function.
   DCHECK(hash_seed() == 0);
   if (FLAG_randomize_hashes) {
@@ -5854,6 +5945,8 @@ void Heap::TearDown() {
     PrintAllocationsHash();
   }
 
+  SetHeapGroup(nullptr);
+
   new_space()->RemoveAllocationObserver(idle_scavenge_observer_);
   delete idle_scavenge_observer_;
   idle_scavenge_observer_ = nullptr;
@@ -5908,9 +6001,6 @@ void Heap::TearDown() {
 
   external_string_table_.TearDown();
 
-  delete tracer_;
-  tracer_ = nullptr;
-
   new_space_->TearDown();
   delete new_space_;
   new_space_ = nullptr;
@@ -5936,10 +6026,21 @@ void Heap::TearDown() {
     lo_space_ = NULL;
   }
 
+  if (new_lo_space_ != NULL) {
+    new_lo_space_->TearDown();
+    delete new_lo_space_;
+    new_lo_space_ = NULL;
+  }
+
   store_buffer()->TearDown();
 
   memory_allocator()->TearDown();
 
+  // Background unmapper tasks report to the tracer, so it is only deleted
+  // after the memory allocator waited for them.
+  delete tracer_;
+  tracer_ = nullptr;
+
   StrongRootsList* next = NULL;
   for (StrongRootsList* list = strong_roots_list_; list; list = next) {
     next = list->next;
@@ -6167,8 +6268,10 @@ void Heap::ClearRecordedSlotRange(Address start, Address end) {
   if (!page->InNewSpace()) {
     DCHECK_EQ(page->owner()->identity(), OLD_SPACE);
     store_buffer()->DeleteEntry(start, end);
+    // Buckets are kept because the concurrent marker may be inserting
+    // slots into them.
     RememberedSet<OLD_TO_OLD>::RemoveRange(page, start, end,
-                                           SlotSet::FREE_EMPTY_BUCKETS);
+                                           SlotSet::KEEP_EMPTY_BUCKETS);
   }
 }
 
@@ -6211,6 +6314,8 @@ Space* AllSpaces::next() {
       return heap_->map_space();
     case LO_SPACE:
       return heap_->lo_space();
+    case LAST_SPACE + 1:
+      return heap_->new_lo_space();
     default:
       return NULL;
   }
@@ -6249,13 +6354,15 @@ SpaceIterator::~SpaceIterator() {
 
 
 bool SpaceIterator::has_next() {
-  // Iterate until no more spaces.
-  return current_space_ != LAST_SPACE;
+  // Iterate until no more spaces. The young generation large object space is
+  // not part of the AllocationSpace enumeration and comes last.
+  return current_space_ != LAST_SPACE + 1;
 }
 
 Space* SpaceIterator::next() {
   DCHECK(has_next());
-  return heap_->space(++current_space_);
+  if (++current_space_ > LAST_SPACE) return heap_->new_lo_space();
+  return heap_->space(current_space_);
 }
 
 
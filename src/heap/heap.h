@@ -356,6 +356,7 @@ class GCIdleTimeAction;
 class GCIdleTimeHandler;
 class GCIdleTimeHeapState;
 class GCTracer;
+class HeapGroup;
 class HeapObjectsFilter;
 class HeapStats;
 class HistogramTimer;
@@ -835,6 +836,11 @@ class Heap {
   // return NULL;
   template <FindMementoMode mode>
   inline AllocationMemento* FindAllocationMemento(HeapObject* object);
+  // Same as above but takes the map of {object} explicitly. Used when the map
+  // word of {object} may be overwritten concurrently.
+  template <FindMementoMode mode>
+  inline AllocationMemento* FindAllocationMemento(Map* map,
+                                                  HeapObject* object);
 
   // Returns false if not able to reserve.
   bool ReserveSpace(Reservation* reservations, List<Address>* maps);
@@ -853,6 +859,15 @@ class Heap {
                                   bool is_isolate_locked);
   void CheckMemoryPressure();
 
+  // Implement the corresponding V8 API functions.
+  void SetHeapMemoryTarget(size_t committed_bytes);
+  void MemoryReducerIdleNotification(double idle_time_in_ms);
+
+  // Makes this heap a member of |group|, leaving its previous group if any.
+  // Passing nullptr only leaves the current group.
+  void SetHeapGroup(HeapGroup* group);
+  HeapGroup* heap_group() const { return heap_group_; }
+
   void SetOutOfMemoryCallback(v8::debug::OutOfMemoryCallback callback,
                               void* data);
 
@@ -919,6 +934,21 @@ class Heap {
 
   inline bool DeoptMaybeTenuredAllocationSites();
 
+  // JSArrayBuffers are not created through allocation sites. Instead, a single
+  // pretenuring decision for the whole heap is derived from the survival rate
+  // of array buffers with external backing stores in scavenges. It applies to
+  // buffers created by the ArrayBuffer constructors and the API, including the
+  // buffers of typed arrays with off-heap storage. The buffers of typed arrays
+  // with on-heap storage are allocated inline in new space by the
+  // TypedArrayInitialize builtin and do not follow the decision.
+  PretenureFlag GetArrayBufferPretenureMode() const {
+    return pretenure_array_buffers_ ? TENURED : NOT_TENURED;
+  }
+
+  // Records that |survived| out of |scavenged| tracked array buffers survived
+  // a scavenge.
+  void RecordArrayBufferSurvival(size_t scavenged, size_t survived);
+
   void AddWeakNewSpaceObjectToCodeDependency(Handle<HeapObject> obj,
                                              Handle<WeakCell> code);
 
@@ -1027,6 +1057,7 @@ class Heap {
   OldSpace* code_space() { return code_space_; }
   MapSpace* map_space() { return map_space_; }
   LargeObjectSpace* lo_space() { return lo_space_; }
+  NewLargeObjectSpace* new_lo_space() { return new_lo_space_; }
 
   inline PagedSpace* paged_space(int idx);
   inline Space* space(int idx);
@@ -1531,6 +1562,9 @@ class Heap {
   template <UpdateAllocationSiteMode mode>
   inline void UpdateAllocationSite(HeapObject* object,
                                    base::HashMap* pretenuring_feedback);
+  template <UpdateAllocationSiteMode mode>
+  inline void UpdateAllocationSite(Map* map, HeapObject* object,
+                                   base::HashMap* pretenuring_feedback);
 
   // Removes an entry from the global pretenuring storage.
   inline void RemoveAllocationSitePretenuringFeedback(AllocationSite* site);
@@ -1666,6 +1700,10 @@ class Heap {
 
   Heap();
 
+  // Returns true if {p} points to a new space object that has not been copied
+  // (yet) during a scavenge.
+  static bool IsUnscavengedHeapObject(Heap* heap, Object** p);
+
   static String* UpdateNewSpaceReferenceInExternalStringTableEntry(
       Heap* heap, Object** pointer);
 
@@ -1861,6 +1899,8 @@ class Heap {
 
   // Performs a minor collection in new generation.
   void Scavenge();
+  // Copies live young objects using Cheney's algorithm on the main thread.
+  void ScavengeSequentially();
   void EvacuateYoungGeneration();
 
   Address DoScavenge(Address new_space_front);
@@ -2219,6 +2259,9 @@ class Heap {
   // and reset by a mark-compact garbage collection.
   base::AtomicValue<MemoryPressureLevel> memory_pressure_level_;
 
+  // The group sharing an old generation budget with this heap, if any.
+  HeapGroup* heap_group_;
+
   v8::debug::OutOfMemoryCallback out_of_memory_callback_;
   void* out_of_memory_callback_data_;
 
@@ -2237,6 +2280,8 @@ class Heap {
   OldSpace* code_space_;
   MapSpace* map_space_;
   LargeObjectSpace* lo_space_;
+  // Young large objects. Not part of space_ as it shares the LO_SPACE id.
+  NewLargeObjectSpace* new_lo_space_;
   // Map from the space id to the space.
   Space* space_[LAST_SPACE + 1];
   HeapState gc_state_;
@@ -2375,6 +2420,12 @@ class Heap {
   // forwarding pointers.
   base::HashMap* global_pretenuring_feedback_;
 
+  // Array buffer survival counts since the last array buffer pretenuring
+  // decision, and the decision itself.
+  size_t array_buffers_scavenged_;
+  size_t array_buffers_survived_;
+  bool pretenure_array_buffers_;
+
   char trace_ring_buffer_[kTraceRingBufferSize];
   // If it's not full then the data is from 0 to ring_buffer_end_.  If it's
   // full then the data is from ring_buffer_end_ to the end of the buffer and
@@ -2433,10 +2484,12 @@ class Heap {
   friend class MarkCompactCollectorBase;
   friend class MinorMarkCompactCollector;
   friend class MarkCompactMarkingVisitor;
+  friend class NewLargeObjectSpace;
   friend class NewSpace;
   friend class ObjectStatsCollector;
   friend class Page;
   friend class PagedSpace;
+  friend class LocalScavenger;
   friend class Scavenger;
   friend class StoreBuffer;
   friend class TestMemoryAllocatorScope;
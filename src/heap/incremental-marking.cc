@@ -414,6 +414,10 @@ void IncrementalMarking::DeactivateIncrementalWriteBarrier() {
   for (LargePage* lop : *heap_->lo_space()) {
     SetOldSpacePageFlags(lop, false, false);
   }
+
+  for (LargePage* lop : *heap_->new_lo_space()) {
+    SetNewSpacePageFlags(lop, false);
+  }
 }
 
 
@@ -440,6 +444,10 @@ void IncrementalMarking::ActivateIncrementalWriteBarrier() {
   for (LargePage* lop : *heap_->lo_space()) {
     SetOldSpacePageFlags(lop, true, is_compacting_);
   }
+
+  for (LargePage* lop : *heap_->new_lo_space()) {
+    SetNewSpacePageFlags(lop, true);
+  }
 }
 
 
@@ -607,8 +615,7 @@ void IncrementalMarking::StartMarking() {
   heap_->IterateStrongRoots(&visitor, VISIT_ONLY_STRONG);
 
   if (FLAG_concurrent_marking) {
-    ConcurrentMarking* concurrent_marking = heap_->concurrent_marking();
-    concurrent_marking->StartTask();
+    heap_->concurrent_marking()->ScheduleTasks();
   }
 
   // Ready to start incremental marking.
@@ -1196,6 +1203,9 @@ size_t IncrementalMarking::Step(size_t bytes_to_process,
 
   size_t bytes_processed = 0;
   if (state_ == MARKING) {
+    if (FLAG_concurrent_marking) {
+      heap_->concurrent_marking()->RescheduleTasksIfNeeded();
+    }
     bytes_processed = ProcessMarkingDeque(bytes_to_process);
     if (step_origin == StepOrigin::kTask) {
       bytes_marked_ahead_of_schedule_ += bytes_processed;
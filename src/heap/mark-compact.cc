@@ -20,6 +20,7 @@
 #include "src/heap/concurrent-marking.h"
 #include "src/heap/gc-tracer.h"
 #include "src/heap/incremental-marking.h"
+#include "src/heap/invalidated-slots-inl.h"
 #include "src/heap/item-parallel-job.h"
 #include "src/heap/mark-compact-inl.h"
 #include "src/heap/object-stats.h"
@@ -81,6 +82,7 @@ class MarkingVerifier : public ObjectVisitor, public RootVisitor {
                            Address start, Address end);
   void VerifyMarking(NewSpace* new_space);
   void VerifyMarking(PagedSpace* paged_space);
+  void VerifyMarking(LargeObjectSpace* lo_space);
 
   Heap* heap_;
 };
@@ -140,6 +142,15 @@ void MarkingVerifier::VerifyMarking(PagedSpace* space) {
   }
 }
 
+void MarkingVerifier::VerifyMarking(LargeObjectSpace* lo_space) {
+  for (LargePage* p : *lo_space) {
+    HeapObject* obj = p->GetObject();
+    if (ObjectMarking::IsBlackOrGrey(obj, marking_state(p))) {
+      obj->Iterate(this);
+    }
+  }
+}
+
 class FullMarkingVerifier : public MarkingVerifier {
  public:
   explicit FullMarkingVerifier(Heap* heap) : MarkingVerifier(heap) {}
@@ -150,13 +161,8 @@ class FullMarkingVerifier : public MarkingVerifier {
     VerifyMarking(heap_->old_space());
     VerifyMarking(heap_->code_space());
     VerifyMarking(heap_->map_space());
-
-    LargeObjectIterator it(heap_->lo_space());
-    for (HeapObject* obj = it.Next(); obj != NULL; obj = it.Next()) {
-      if (ObjectMarking::IsBlackOrGrey(obj, marking_state(obj))) {
-        obj->Iterate(this);
-      }
-    }
+    VerifyMarking(heap_->lo_space());
+    VerifyMarking(heap_->new_lo_space());
   }
 
  protected:
@@ -405,6 +411,7 @@ MarkCompactCollector::MarkCompactCollector(Heap* heap)
       compacting_(false),
       black_allocation_(false),
       have_code_to_deoptimize_(false),
+      bytecode_flushing_enabled_(false),
       marking_deque_(heap),
       sweeper_(heap) {
   old_to_new_slots_ = -1;
@@ -524,6 +531,13 @@ void MarkCompactCollector::VerifyMarkbitsAreClean() {
     CHECK(ObjectMarking::IsWhite(obj, MarkingState::Internal(obj)));
     CHECK_EQ(0, MarkingState::Internal(obj).live_bytes());
   }
+
+  LargeObjectIterator new_lo_it(heap_->new_lo_space());
+  for (HeapObject* obj = new_lo_it.Next(); obj != NULL;
+       obj = new_lo_it.Next()) {
+    CHECK(ObjectMarking::IsWhite(obj, MarkingState::Internal(obj)));
+    CHECK_EQ(0, MarkingState::Internal(obj).live_bytes());
+  }
 }
 
 void MarkCompactCollector::VerifyWeakEmbeddedObjectsInCode() {
@@ -568,6 +582,7 @@ void MarkCompactCollector::ClearMarkbits() {
   ClearMarkbitsInPagedSpace(heap_->old_space());
   ClearMarkbitsInNewSpace(heap_->new_space());
   heap_->lo_space()->ClearMarkingStateOfLiveObjects();
+  heap_->new_lo_space()->ClearMarkingStateOfLiveObjects();
 }
 
 class MarkCompactCollector::Sweeper::SweeperTask : public v8::Task {
@@ -589,11 +604,17 @@ class MarkCompactCollector::Sweeper::SweeperTask : public v8::Task {
     DCHECK_LE(space_to_start_, LAST_PAGED_SPACE);
     const int offset = space_to_start_ - FIRST_SPACE;
     const int num_spaces = LAST_PAGED_SPACE - FIRST_SPACE + 1;
-    for (int i = 0; i < num_spaces; i++) {
-      const int space_id = FIRST_SPACE + ((i + offset) % num_spaces);
-      DCHECK_GE(space_id, FIRST_SPACE);
-      DCHECK_LE(space_id, LAST_PAGED_SPACE);
-      sweeper_->ParallelSweepSpace(static_cast<AllocationSpace>(space_id), 0);
+    {
+      GCTracer::BackgroundScope scope(
+          sweeper_->heap_->tracer(),
+          GCTracer::BackgroundScope::MC_BACKGROUND_SWEEPING);
+      for (int i = 0; i < num_spaces; i++) {
+        const int space_id = FIRST_SPACE + ((i + offset) % num_spaces);
+        DCHECK_GE(space_id, FIRST_SPACE);
+        DCHECK_LE(space_id, LAST_PAGED_SPACE);
+        sweeper_->ParallelSweepSpace(static_cast<AllocationSpace>(space_id),
+                                     0);
+      }
     }
     num_sweeping_tasks_->Decrement(1);
     pending_sweeper_tasks_->Signal();
@@ -609,6 +630,8 @@ class MarkCompactCollector::Sweeper::SweeperTask : public v8::Task {
 
 void MarkCompactCollector::Sweeper::StartSweeping() {
   sweeping_in_progress_ = true;
+  discard_free_memory_ =
+      FLAG_discard_free_memory || heap_->ShouldReduceMemory();
   ForAllSweepingSpaces([this](AllocationSpace space) {
     std::sort(sweeping_list_[space].begin(), sweeping_list_[space].end(),
               [](Page* a, Page* b) {
@@ -932,7 +955,7 @@ void MarkCompactCollector::Prepare() {
   // them here.
   heap()->memory_allocator()->unmapper()->WaitUntilCompleted();
 
-  heap()->concurrent_marking()->EnsureTaskCompleted();
+  heap()->concurrent_marking()->EnsureCompleted();
 
   // Clear marking bits if incremental marking is aborted.
   if (was_marked_incrementally_ && heap_->ShouldAbortIncrementalMarking()) {
@@ -948,6 +971,15 @@ void MarkCompactCollector::Prepare() {
     was_marked_incrementally_ = false;
   }
 
+  // Bytecode is only flushed by atomic mark-compacts: the incremental and
+  // concurrent markers visit functions strongly and do not record candidates.
+  bytecode_flushing_enabled_ = FLAG_flush_bytecode &&
+                               !was_marked_incrementally_ &&
+                               !isolate()->serializer_enabled() &&
+                               !isolate()->debug()->is_active();
+  bytecode_flushing_candidates_.clear();
+  bytecode_flushing_closure_candidates_.clear();
+
   if (!was_marked_incrementally_) {
     TRACE_GC(heap()->tracer(), GCTracer::Scope::MC_MARK_WRAPPER_PROLOGUE);
     heap_->local_embedder_heap_tracer()->TracePrologue();
@@ -1192,6 +1224,103 @@ class MarkCompactMarkingVisitor
     // Visit the fields of the RegExp, including the updated FixedArray.
     JSObjectVisitor::Visit(map, object);
   }
+
+  // Bytecode flushing support.
+
+  static bool IsFlushableBytecode(Heap* heap, SharedFunctionInfo* shared) {
+    if (!shared->HasBytecodeArray() || !shared->IsInterpreted()) return false;
+    if (!shared->bytecode_array()->IsOld()) return false;
+    // The function must be recompilable from source with the same scope and
+    // feedback layout.
+    if (!HasSourceCode(heap, shared)) return false;
+    if (!shared->allows_lazy_compilation()) return false;
+    if (shared->is_toplevel()) return false;
+    // Suspended generators resume at an offset into their bytecode.
+    if (IsResumableFunction(shared->kind())) return false;
+    if (shared->HasDebugInfo()) return false;
+    return true;
+  }
+
+  // Marks the bytecode of |shared| so that it survives this GC, because some
+  // code that is still alive deoptimizes into it.
+  static void RetainBytecode(Heap* heap, SharedFunctionInfo* shared) {
+    if (!shared->HasBytecodeArray()) return;
+    Object** slot =
+        HeapObject::RawField(shared, SharedFunctionInfo::kFunctionDataOffset);
+    MarkObjectByPointer(heap->mark_compact_collector(), shared, slot);
+  }
+
+  // Visits everything but the bytecode of flushable functions, which is left
+  // to FlushBytecode to decide on once marking is complete.
+  static void VisitSharedFunctionInfoAndFlushBytecode(Map* map,
+                                                      HeapObject* object) {
+    Heap* heap = map->GetHeap();
+    SharedFunctionInfo* shared = SharedFunctionInfo::cast(object);
+    MarkCompactCollector* collector = heap->mark_compact_collector();
+    if (!collector->is_bytecode_flushing_enabled() ||
+        !IsFlushableBytecode(heap, shared)) {
+      VisitSharedFunctionInfo(map, object);
+      return;
+    }
+    if (shared->ic_age() != heap->global_ic_age()) {
+      shared->ResetForNewContext(heap->global_ic_age());
+    }
+    collector->AddBytecodeFlushingCandidate(shared);
+    VisitPointers(
+        heap, object,
+        HeapObject::RawField(object, SharedFunctionInfo::kCodeOffset),
+        HeapObject::RawField(object, SharedFunctionInfo::kFunctionDataOffset));
+    VisitPointers(
+        heap, object,
+        HeapObject::RawField(object, SharedFunctionInfo::kScriptOffset),
+        HeapObject::RawField(object,
+                             SharedFunctionInfo::kLastPointerFieldOffset +
+                                 kPointerSize));
+  }
+
+  static void VisitJSFunctionAndFlushBytecode(Map* map, HeapObject* object) {
+    Heap* heap = map->GetHeap();
+    MarkCompactCollector* collector = heap->mark_compact_collector();
+    if (collector->is_bytecode_flushing_enabled()) {
+      JSFunction* function = JSFunction::cast(object);
+      SharedFunctionInfo* shared = function->shared();
+      if (shared->HasBytecodeArray()) {
+        if (function->code()->kind() == Code::OPTIMIZED_FUNCTION) {
+          RetainBytecode(heap, shared);
+        } else {
+          // The interpreter trampoline or one of the optimization markers,
+          // all of which expect the bytecode to be present.
+          collector->AddBytecodeFlushingCandidate(function);
+        }
+      }
+    }
+    VisitJSFunction(map, object);
+  }
+
+  static void VisitCodeAndRetainBytecode(Map* map, HeapObject* object) {
+    Heap* heap = map->GetHeap();
+    Code* code = Code::cast(object);
+    if (heap->mark_compact_collector()->is_bytecode_flushing_enabled() &&
+        code->kind() == Code::OPTIMIZED_FUNCTION) {
+      DeoptimizationInputData* data =
+          DeoptimizationInputData::cast(code->deoptimization_data());
+      if (data->length() > 0) {
+        Object* outermost = data->SharedFunctionInfo();
+        if (outermost->IsSharedFunctionInfo()) {
+          RetainBytecode(heap, SharedFunctionInfo::cast(outermost));
+        }
+        // Inlined functions are recorded in the literal array.
+        FixedArray* literals = data->LiteralArray();
+        for (int i = 0; i < literals->length(); i++) {
+          Object* literal = literals->get(i);
+          if (literal->IsSharedFunctionInfo()) {
+            RetainBytecode(heap, SharedFunctionInfo::cast(literal));
+          }
+        }
+      }
+    }
+    VisitCode(map, object);
+  }
 };
 
 
@@ -1199,6 +1328,10 @@ void MarkCompactMarkingVisitor::Initialize() {
   StaticMarkingVisitor<MarkCompactMarkingVisitor>::Initialize();
 
   table_.Register(kVisitJSRegExp, &VisitRegExpAndFlushCode);
+  table_.Register(kVisitSharedFunctionInfo,
+                  &VisitSharedFunctionInfoAndFlushBytecode);
+  table_.Register(kVisitJSFunction, &VisitJSFunctionAndFlushBytecode);
+  table_.Register(kVisitCode, &VisitCodeAndRetainBytecode);
 }
 
 void MinorMarkCompactCollector::CleanupSweepToIteratePages() {
@@ -1533,12 +1666,15 @@ class RecordMigratedSlotVisitor : public ObjectVisitor {
                                          Address slot) {
     if (value->IsHeapObject()) {
       Page* p = Page::FromAddress(reinterpret_cast<Address>(value));
+      // The chunk is computed from the host as slots of promoted young large
+      // objects may lie beyond the first page of the chunk.
+      MemoryChunk* host_chunk = MemoryChunk::FromAddress(host->address());
       if (p->InNewSpace()) {
         DCHECK_IMPLIES(p->InToSpace(),
                        p->IsFlagSet(Page::PAGE_NEW_NEW_PROMOTION));
-        RememberedSet<OLD_TO_NEW>::Insert(Page::FromAddress(slot), slot);
+        RememberedSet<OLD_TO_NEW>::Insert(host_chunk, slot);
       } else if (p->IsEvacuationCandidate()) {
-        RememberedSet<OLD_TO_OLD>::Insert(Page::FromAddress(slot), slot);
+        RememberedSet<OLD_TO_OLD>::Insert(host_chunk, slot);
       }
     }
   }
@@ -2075,6 +2211,9 @@ void MarkCompactCollector::RefillMarkingDeque() {
   LargeObjectIterator lo_it(heap()->lo_space());
   DiscoverGreyObjectsWithIterator(&lo_it);
   if (marking_deque()->IsFull()) return;
+  LargeObjectIterator new_lo_it(heap()->new_lo_space());
+  DiscoverGreyObjectsWithIterator(&new_lo_it);
+  if (marking_deque()->IsFull()) return;
 
   marking_deque()->ClearOverflowed();
 }
@@ -3012,6 +3151,37 @@ void MarkCompactCollector::ClearNonLiveReferences() {
   MarkDependentCodeForDeoptimization(dependent_code_list);
 
   ClearWeakCollections();
+
+  if (is_bytecode_flushing_enabled()) FlushBytecode();
+}
+
+void MarkCompactCollector::FlushBytecode() {
+  Code* lazy_compile = isolate()->builtins()->builtin(Builtins::kCompileLazy);
+  for (SharedFunctionInfo* shared : bytecode_flushing_candidates_) {
+    Object** data_slot =
+        HeapObject::RawField(shared, SharedFunctionInfo::kFunctionDataOffset);
+    BytecodeArray* bytecode = shared->bytecode_array();
+    if (ObjectMarking::IsBlackOrGrey(bytecode,
+                                     MarkingState::Internal(bytecode))) {
+      // Still reachable, e.g. from an interpreter frame or a compile job.
+      RecordSlot(shared, data_slot, bytecode);
+      continue;
+    }
+    shared->set_function_data(heap()->undefined_value(), SKIP_WRITE_BARRIER);
+    shared->set_code(lazy_compile, SKIP_WRITE_BARRIER);
+    Object** code_slot =
+        HeapObject::RawField(shared, SharedFunctionInfo::kCodeOffset);
+    RecordSlot(shared, code_slot, lazy_compile);
+  }
+  for (JSFunction* function : bytecode_flushing_closure_candidates_) {
+    if (function->shared()->is_compiled()) continue;
+    function->set_code_no_write_barrier(lazy_compile);
+    RecordCodeEntrySlot(function,
+                        function->address() + JSFunction::kCodeEntryOffset,
+                        lazy_compile);
+  }
+  bytecode_flushing_candidates_.clear();
+  bytecode_flushing_closure_candidates_.clear();
 }
 
 
@@ -3510,6 +3680,23 @@ void MarkCompactCollector::EvacuatePrologue() {
   new_space->Flip();
   new_space->ResetAllocationInfo();
 
+  // Young large objects. Live objects are promoted in place and their slots
+  // are recorded as for any other object that moved to the old generation.
+  // The pages of dead objects stay in from-space until pointers have been
+  // updated, as stale old-to-new slots may still point to them.
+  heap()->new_lo_space()->Flip();
+  RecordMigratedSlotVisitor record_visitor(this);
+  LargePage* current = heap()->new_lo_space()->first_page();
+  while (current != nullptr) {
+    LargePage* page = current;
+    current = current->next_page();
+    HeapObject* object = page->GetObject();
+    if (ObjectMarking::IsBlack(object, marking_state(object))) {
+      heap()->lo_space()->PromoteNewLargeObject(page);
+      object->IterateBodyFast(&record_visitor);
+    }
+  }
+
   // Old space.
   DCHECK(old_space_evacuation_pages_.is_empty());
   old_space_evacuation_pages_.Swap(&evacuation_candidates_);
@@ -3519,6 +3706,8 @@ void MarkCompactCollector::EvacuatePrologue() {
 void MarkCompactCollector::EvacuateEpilogue() {
   // New space.
   heap()->new_space()->set_age_mark(heap()->new_space()->top());
+  // Young large objects that did not survive.
+  heap()->new_lo_space()->FreeDeadObjects();
   // Old space. Deallocate evacuated candidate pages.
   ReleaseEvacuationCandidates();
 }
@@ -3963,6 +4152,21 @@ MarkCompactCollector::Sweeper::GetClearOldToNewSlotsMode(Page* p) {
   return MarkCompactCollector::Sweeper::DO_NOT_CLEAR;
 }
 
+void MarkCompactCollector::Sweeper::DiscardFreeRange(Address start,
+                                                     size_t size) {
+  // The header of the free space object (or filler) that covers the range is
+  // kept, as it is needed to iterate the page and to find free list entries.
+  const uintptr_t page_size = base::OS::CommitPageSize();
+  const uintptr_t discard_start = RoundUp(
+      reinterpret_cast<uintptr_t>(start + FreeSpace::kSize), page_size);
+  const uintptr_t discard_end =
+      RoundDown(reinterpret_cast<uintptr_t>(start + size), page_size);
+  if (discard_start < discard_end) {
+    base::OS::DiscardSystemPages(reinterpret_cast<void*>(discard_start),
+                                 discard_end - discard_start);
+  }
+}
+
 int MarkCompactCollector::Sweeper::RawSweep(
     Page* p, FreeListRebuildingMode free_list_mode,
     FreeSpaceTreatmentMode free_space_mode) {
@@ -4023,6 +4227,9 @@ int MarkCompactCollector::Sweeper::RawSweep(
         p->heap()->CreateFillerObjectAt(free_start, static_cast<int>(size),
                                         ClearRecordedSlots::kNo);
       }
+      if (free_space_mode == DISCARD_FREE_SPACE) {
+        DiscardFreeRange(free_start, size);
+      }
 
       if (slots_clearing_mode == CLEAR_REGULAR_SLOTS) {
         RememberedSet<OLD_TO_NEW>::RemoveRange(p, free_start, free_end,
@@ -4061,6 +4268,9 @@ int MarkCompactCollector::Sweeper::RawSweep(
       p->heap()->CreateFillerObjectAt(free_start, static_cast<int>(size),
                                       ClearRecordedSlots::kNo);
     }
+    if (free_space_mode == DISCARD_FREE_SPACE) {
+      DiscardFreeRange(free_start, size);
+    }
 
     if (slots_clearing_mode == CLEAR_REGULAR_SLOTS) {
       RememberedSet<OLD_TO_NEW>::RemoveRange(p, free_start, p->area_end(),
@@ -4215,10 +4425,11 @@ void MarkCompactCollector::Evacuate() {
     }
   }
 
-  // Give pages that are queued to be freed back to the OS. Note that filtering
-  // slots only handles old space (for unboxed doubles), and thus map space can
-  // still contain stale pointers. We only free the chunks after pointer updates
-  // to still have access to page headers.
+  // Give pages that are queued to be freed back to the OS. This includes the
+  // pages of dead large objects, which StartSweepSpaces queued. Note that
+  // filtering slots only handles old space (for unboxed doubles), and thus map
+  // space can still contain stale pointers. We only free the chunks after
+  // pointer updates to still have access to page headers.
   heap()->memory_allocator()->unmapper()->FreeQueuedChunks();
 
   {
@@ -4403,9 +4614,14 @@ class RememberedSetUpdatingItem : public UpdatingItem {
         return CheckAndUpdateOldToNewSlot(slot);
       });
     } else {
-      RememberedSet<OLD_TO_OLD>::Iterate(chunk_, [](Address slot) {
+      // Slots recorded by the concurrent marker inside objects that changed
+      // their layout afterwards are dropped.
+      InvalidatedSlotsFilter filter(chunk_);
+      RememberedSet<OLD_TO_OLD>::Iterate(chunk_, [&filter](Address slot) {
+        if (!filter.IsValid(slot)) return REMOVE_SLOT;
         return UpdateSlot(reinterpret_cast<Object**>(slot));
       });
+      chunk_->ReleaseInvalidatedSlots();
     }
   }
 
@@ -4630,8 +4846,12 @@ int MarkCompactCollector::Sweeper::ParallelSweepPage(Page* page,
     DCHECK_EQ(Page::kSweepingPending,
               page->concurrent_sweeping_state().Value());
     page->concurrent_sweeping_state().SetValue(Page::kSweepingInProgress);
-    const FreeSpaceTreatmentMode free_space_mode =
-        Heap::ShouldZapGarbage() ? ZAP_FREE_SPACE : IGNORE_FREE_SPACE;
+    FreeSpaceTreatmentMode free_space_mode = IGNORE_FREE_SPACE;
+    if (Heap::ShouldZapGarbage()) {
+      free_space_mode = ZAP_FREE_SPACE;
+    } else if (discard_free_memory_) {
+      free_space_mode = DISCARD_FREE_SPACE;
+    }
     if (identity == NEW_SPACE) {
       RawSweep(page, IGNORE_FREE_LIST, free_space_mode);
     } else {
@@ -4770,7 +4990,8 @@ void MarkCompactCollector::StartSweepSpaces() {
     sweeper().StartSweeping();
   }
 
-  // Deallocate unmarked large objects.
+  // Deallocate unmarked large objects. Their pages are queued for the
+  // unmapper and given back to the OS after pointer updating in Evacuate.
   heap_->lo_space()->FreeUnmarkedObjects();
 }
 
@@ -230,7 +230,13 @@ class LiveObjectVisitor BASE_EMBEDDED {
 };
 
 enum PageEvacuationMode { NEW_TO_NEW, NEW_TO_OLD };
-enum FreeSpaceTreatmentMode { IGNORE_FREE_SPACE, ZAP_FREE_SPACE };
+// DISCARD_FREE_SPACE returns the system pages covered by free ranges to the
+// operating system.
+enum FreeSpaceTreatmentMode {
+  IGNORE_FREE_SPACE,
+  ZAP_FREE_SPACE,
+  DISCARD_FREE_SPACE
+};
 enum MarkingTreatmentMode { KEEP, CLEAR };
 
 // Base class for minor and full MC collectors.
@@ -378,6 +384,7 @@ class MarkCompactCollector final : public MarkCompactCollectorBase {
           pending_sweeper_tasks_semaphore_(0),
           semaphore_counter_(0),
           sweeping_in_progress_(false),
+          discard_free_memory_(false),
           num_sweeping_tasks_(0) {}
 
     bool sweeping_in_progress() { return sweeping_in_progress_; }
@@ -406,6 +413,10 @@ class MarkCompactCollector final : public MarkCompactCollectorBase {
 
     static ClearOldToNewSlotsMode GetClearOldToNewSlotsMode(Page* p);
 
+    // Discards the system pages that lie completely within the free range
+    // [start, start + size), leaving room for the free space header.
+    static void DiscardFreeRange(Address start, size_t size);
+
     template <typename Callback>
     void ForAllSweepingSpaces(Callback callback) {
       for (int i = 0; i < kAllocationSpaces; i++) {
@@ -426,6 +437,9 @@ class MarkCompactCollector final : public MarkCompactCollectorBase {
     SweptList swept_list_[kAllocationSpaces];
     SweepingList sweeping_list_[kAllocationSpaces];
     bool sweeping_in_progress_;
+    // Whether free ranges of the pages swept in the current cycle are given
+    // back to the operating system. Fixed when sweeping starts.
+    bool discard_free_memory_;
     // Counter is actively maintained by the concurrent tasks to avoid querying
     // the semaphore for maintaining a task counter on the main thread.
     base::AtomicNumber<intptr_t> num_sweeping_tasks_;
@@ -476,7 +490,8 @@ class MarkCompactCollector final : public MarkCompactCollectorBase {
   void RecordRelocSlot(Code* host, RelocInfo* rinfo, Object* target);
   void RecordCodeEntrySlot(HeapObject* host, Address slot, Code* target);
   void RecordCodeTargetPatch(Address pc, Code* target);
-  INLINE(void RecordSlot(HeapObject* object, Object** slot, Object* target));
+  INLINE(static void RecordSlot(HeapObject* object, Object** slot,
+                                Object* target));
   INLINE(void ForceRecordSlot(HeapObject* object, Object** slot,
                               Object* target));
   void RecordLiveSlotsOnPage(Page* page);
@@ -490,6 +505,25 @@ class MarkCompactCollector final : public MarkCompactCollectorBase {
 
   bool is_compacting() const { return compacting_; }
 
+  // True if the current atomic mark-compact flushes the bytecode of functions
+  // that have not been executed for a while, see FLAG_flush_bytecode.
+  bool is_bytecode_flushing_enabled() const {
+    return bytecode_flushing_enabled_;
+  }
+
+  // Registers a function whose bytecode was not marked through its
+  // SharedFunctionInfo. The bytecode is flushed after marking unless it was
+  // reached along some other path (e.g. from a stack frame or a handle).
+  void AddBytecodeFlushingCandidate(SharedFunctionInfo* shared) {
+    bytecode_flushing_candidates_.push_back(shared);
+  }
+
+  // Registers a closure whose code has to be reset to CompileLazy if the
+  // bytecode of its SharedFunctionInfo is flushed.
+  void AddBytecodeFlushingCandidate(JSFunction* function) {
+    bytecode_flushing_closure_candidates_.push_back(function);
+  }
+
   // Ensures that sweeping is finished.
   //
   // Note: Can only be called safely from main thread.
@@ -637,6 +671,10 @@ class MarkCompactCollector final : public MarkCompactCollectorBase {
                       DependentCode** dependent_code_list);
   void AbortWeakCells();
 
+  // Drops the unmarked bytecode of the registered flushing candidates and
+  // resets them and their closures to lazy compilation.
+  void FlushBytecode();
+
   void AbortTransitionArrays();
 
   // Starts sweeping of spaces by contributing on the main thread and setting
@@ -682,6 +720,10 @@ class MarkCompactCollector final : public MarkCompactCollectorBase {
 
   bool have_code_to_deoptimize_;
 
+  bool bytecode_flushing_enabled_;
+  std::vector<SharedFunctionInfo*> bytecode_flushing_candidates_;
+  std::vector<JSFunction*> bytecode_flushing_closure_candidates_;
+
   MarkingDeque marking_deque_;
 
   // Candidates for pages that should be evacuated.
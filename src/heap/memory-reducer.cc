@@ -200,6 +200,76 @@ MemoryReducer::State MemoryReducer::Step(const State& state,
 }
 
 
+MemoryReducer::IdleTask::IdleTask(MemoryReducer* memory_reducer)
+    : CancelableTask(memory_reducer->heap()->isolate()),
+      memory_reducer_(memory_reducer) {}
+
+void MemoryReducer::IdleTask::RunInternal() {
+  memory_reducer_->PerformIdleStep();
+}
+
+bool MemoryReducer::AboveTargetCommittedMemory() {
+  return target_committed_memory_ > 0 &&
+         heap()->CommittedMemory() > target_committed_memory_;
+}
+
+void MemoryReducer::NotifyIdle(double idle_time_ms) {
+  double now_ms = heap()->MonotonicallyIncreasingTimeInMs();
+  if (idle_time_ms <= 0) {
+    idle_deadline_ms_ = now_ms;
+    return;
+  }
+  if (idle_deadline_ms_ <= now_ms) {
+    // A new idle period starts.
+    idle_gcs_started_ = 0;
+  }
+  idle_deadline_ms_ = now_ms + idle_time_ms;
+  if (FLAG_incremental_marking && AboveTargetCommittedMemory()) {
+    ScheduleIdleTask();
+  }
+}
+
+void MemoryReducer::ScheduleIdleTask() {
+  if (idle_task_pending_) return;
+  idle_task_pending_ = true;
+  v8::Isolate* isolate = reinterpret_cast<v8::Isolate*>(heap()->isolate());
+  V8::GetCurrentPlatform()->CallOnForegroundThread(isolate,
+                                                   new IdleTask(this));
+}
+
+void MemoryReducer::PerformIdleStep() {
+  // Each step gives the mutator a chance to run in between, so that a request
+  // arriving while the heap shrinks is delayed by at most one step.
+  const double kIdleStepMs = 5;
+  idle_task_pending_ = false;
+  double now_ms = heap()->MonotonicallyIncreasingTimeInMs();
+  if (now_ms >= idle_deadline_ms_ || !AboveTargetCommittedMemory()) return;
+  IncrementalMarking* marking = heap()->incremental_marking();
+  if (marking->IsStopped()) {
+    if (idle_gcs_started_ >= kMaxNumberOfGCs || !marking->CanBeActivated()) {
+      return;
+    }
+    idle_gcs_started_++;
+    if (FLAG_trace_gc_verbose) {
+      heap()->isolate()->PrintWithTimestamp(
+          "Memory reducer: started idle GC #%d (committed %" PRIuS
+          " KB, target %" PRIuS " KB)\n",
+          idle_gcs_started_, heap()->CommittedMemory() / KB,
+          target_committed_memory_ / KB);
+    }
+    heap()->StartIdleIncrementalMarking(
+        GarbageCollectionReason::kMemoryReducer,
+        kGCCallbackFlagCollectAllExternalMemory);
+  }
+  double deadline_ms = Min(now_ms + kIdleStepMs, idle_deadline_ms_);
+  marking->AdvanceIncrementalMarking(
+      deadline_ms, IncrementalMarking::NO_GC_VIA_STACK_GUARD,
+      IncrementalMarking::FORCE_COMPLETION, StepOrigin::kTask);
+  heap()->FinalizeIncrementalMarkingIfComplete(
+      GarbageCollectionReason::kFinalizeMarkingViaTask);
+  ScheduleIdleTask();
+}
+
 void MemoryReducer::ScheduleTimer(double time_ms, double delay_ms) {
   DCHECK(delay_ms > 0);
   // Leave some room for precision error in task scheduler.
@@ -210,7 +280,10 @@ void MemoryReducer::ScheduleTimer(double time_ms, double delay_ms) {
       isolate, timer_task, (delay_ms + kSlackMs) / 1000.0);
 }
 
-void MemoryReducer::TearDown() { state_ = State(kDone, 0, 0, 0.0, 0); }
+void MemoryReducer::TearDown() {
+  state_ = State(kDone, 0, 0, 0.0, 0);
+  idle_deadline_ms_ = 0.0;
+}
 
 }  // namespace internal
 }  // namespace v8
@@ -80,6 +80,12 @@ class Heap;
 // now_ms is the current time,
 // t' is t if the current event is not a GC event and is now_ms otherwise,
 // long_delay_ms, short_delay_ms, and watchdog_delay_ms are constants.
+//
+// Independently of the automaton, the embedder can set a target for the
+// committed memory of the heap and signal idle periods of known length. While
+// the target is exceeded and the isolate is idle, the MemoryReducer posts
+// tasks that run memory reducing incremental mark-compact GCs in steps bounded
+// by the end of the idle period, up to kMaxNumberOfGCs per idle period.
 class V8_EXPORT_PRIVATE MemoryReducer {
  public:
   enum Action { kDone, kWait, kRun };
@@ -114,11 +120,24 @@ class V8_EXPORT_PRIVATE MemoryReducer {
       : heap_(heap),
         state_(kDone, 0, 0.0, 0.0, 0),
         js_calls_counter_(0),
-        js_calls_sample_time_ms_(0.0) {}
+        js_calls_sample_time_ms_(0.0),
+        target_committed_memory_(0),
+        idle_deadline_ms_(0.0),
+        idle_gcs_started_(0),
+        idle_task_pending_(false) {}
   // Callbacks.
   void NotifyMarkCompact(const Event& event);
   void NotifyPossibleGarbage(const Event& event);
   void NotifyBackgroundIdleNotification(const Event& event);
+  // Sets the committed memory the heap should shrink to during idle periods.
+  // Zero removes the target.
+  void SetTargetCommittedMemory(size_t target) {
+    target_committed_memory_ = target;
+  }
+  // Signals that the isolate is idle for the next |idle_time_ms|. Zero ends
+  // the current idle period.
+  void NotifyIdle(double idle_time_ms);
+  bool AboveTargetCommittedMemory();
   // The step function that computes the next state from the current state and
   // the incoming event.
   static State Step(const State& state, const Event& event);
@@ -154,7 +173,20 @@ class V8_EXPORT_PRIVATE MemoryReducer {
     DISALLOW_COPY_AND_ASSIGN(TimerTask);
   };
 
+  class IdleTask : public v8::internal::CancelableTask {
+   public:
+    explicit IdleTask(MemoryReducer* memory_reducer);
+
+   private:
+    // v8::internal::CancelableTask overrides.
+    void RunInternal() override;
+    MemoryReducer* memory_reducer_;
+    DISALLOW_COPY_AND_ASSIGN(IdleTask);
+  };
+
   void NotifyTimer(const Event& event);
+  void PerformIdleStep();
+  void ScheduleIdleTask();
 
   static bool WatchdogGC(const State& state, const Event& event);
 
@@ -163,6 +195,11 @@ class V8_EXPORT_PRIVATE MemoryReducer {
   unsigned int js_calls_counter_;
   double js_calls_sample_time_ms_;
 
+  size_t target_committed_memory_;
+  double idle_deadline_ms_;
+  int idle_gcs_started_;
+  bool idle_task_pending_;
+
   // Used in cctest.
   friend class HeapTester;
   DISALLOW_COPY_AND_ASSIGN(MemoryReducer);
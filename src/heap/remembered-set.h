@@ -118,7 +118,8 @@ class RememberedSet : public AllStatic {
     while ((chunk = it.next()) != nullptr) {
       SlotSet* slots = chunk->slot_set<type>();
       TypedSlotSet* typed_slots = chunk->typed_slot_set<type>();
-      if (slots != nullptr || typed_slots != nullptr) {
+      if (slots != nullptr || typed_slots != nullptr ||
+          (type == OLD_TO_OLD && chunk->invalidated_slots() != nullptr)) {
         callback(chunk);
       }
     }
@@ -131,12 +132,8 @@ class RememberedSet : public AllStatic {
   static void Iterate(MemoryChunk* chunk, Callback callback) {
     SlotSet* slots = chunk->slot_set<type>();
     if (slots != nullptr) {
-      size_t pages = (chunk->size() + Page::kPageSize - 1) / Page::kPageSize;
-      int new_count = 0;
-      for (size_t page = 0; page < pages; page++) {
-        new_count +=
-            slots[page].Iterate(callback, SlotSet::PREFREE_EMPTY_BUCKETS);
-      }
+      int new_count =
+          IterateSlotSets(chunk, 0, NumberOfSlotSets(chunk), callback);
       // Only old-to-old slot sets are released eagerly. Old-new-slot sets are
       // released by the sweeper threads.
       if (type == OLD_TO_OLD && new_count == 0) {
@@ -145,6 +142,31 @@ class RememberedSet : public AllStatic {
     }
   }
 
+  // Large pages have one slot set per Page::kPageSize region. Each of them
+  // can be iterated independently, e.g. by different tasks.
+  static int NumberOfSlotSets(MemoryChunk* chunk) {
+    return static_cast<int>((chunk->size() + Page::kPageSize - 1) /
+                            Page::kPageSize);
+  }
+
+  // Iterates and filters the slot sets [start, end) of the given memory chunk
+  // with the given callback. The callback should take (Address slot) and
+  // return SlotCallbackResult. Returns the number of remaining slots.
+  template <typename Callback>
+  static int IterateSlotSets(MemoryChunk* chunk, int start, int end,
+                             Callback callback) {
+    DCHECK_LE(0, start);
+    DCHECK_LE(start, end);
+    DCHECK_LE(end, NumberOfSlotSets(chunk));
+    SlotSet* slots = chunk->slot_set<type>();
+    if (slots == nullptr) return 0;
+    int new_count = 0;
+    for (int i = start; i < end; i++) {
+      new_count += slots[i].Iterate(callback, SlotSet::PREFREE_EMPTY_BUCKETS);
+    }
+    return new_count;
+  }
+
   // Given a page and a typed slot in that page, this function adds the slot
   // to the remembered set.
   static void InsertTyped(Page* page, Address host_addr, SlotType slot_type,
@@ -214,6 +236,7 @@ class RememberedSet : public AllStatic {
     while ((chunk = it.next()) != nullptr) {
       chunk->ReleaseSlotSet<OLD_TO_OLD>();
       chunk->ReleaseTypedSlotSet<OLD_TO_OLD>();
+      chunk->ReleaseInvalidatedSlots();
     }
   }
 
@@ -61,6 +61,38 @@ SlotCallbackResult Scavenger::CheckAndScavengeObject(Heap* heap,
   return REMOVE_SLOT;
 }
 
+void LocalScavenger::ScavengePointer(Object** p) {
+  Object* object = *p;
+  if (!heap()->InFromSpace(object)) return;
+  ScavengeObject(reinterpret_cast<HeapObject**>(p),
+                 reinterpret_cast<HeapObject*>(object));
+}
+
+SlotCallbackResult LocalScavenger::CheckAndScavengeObject(
+    Address slot_address) {
+  Object** slot = reinterpret_cast<Object**>(slot_address);
+  Object* object = *slot;
+  if (heap()->InFromSpace(object)) {
+    ScavengeObject(reinterpret_cast<HeapObject**>(slot),
+                   reinterpret_cast<HeapObject*>(object));
+    // The object is still live if it was copied within new space.
+    if (heap()->InToSpace(*slot)) return KEEP_SLOT;
+  }
+  return REMOVE_SLOT;
+}
+
+void LocalScavenger::ScavengeObject(HeapObject** p, HeapObject* object) {
+  DCHECK(heap()->InFromSpace(object));
+  // The acquire load pairs with the release compare-and-swap in MigrateObject
+  // so that the contents of a copy made by another task are visible.
+  MapWord first_word = object->synchronized_map_word();
+  if (first_word.IsForwardingAddress()) {
+    *p = first_word.ToForwardingAddress();
+    return;
+  }
+  EvacuateObject(p, first_word.ToMap(), object);
+}
+
 // static
 void StaticScavengeVisitor::VisitPointer(Heap* heap, HeapObject* obj,
                                          Object** p) {
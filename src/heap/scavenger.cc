@@ -5,13 +5,19 @@
 #include "src/heap/scavenger.h"
 
 #include "src/contexts.h"
+#include "src/global-handles.h"
+#include "src/heap/gc-tracer.h"
 #include "src/heap/heap-inl.h"
 #include "src/heap/incremental-marking.h"
+#include "src/heap/item-parallel-job.h"
 #include "src/heap/objects-visiting-inl.h"
+#include "src/heap/remembered-set.h"
 #include "src/heap/scavenger-inl.h"
 #include "src/isolate.h"
 #include "src/log.h"
 #include "src/profiler/heap-profiler.h"
+#include "src/utils-inl.h"
+#include "src/v8.h"
 
 namespace v8 {
 namespace internal {
@@ -211,13 +217,38 @@ class ScavengingVisitor : public StaticVisitorBase {
     return false;
   }
 
+  // Objects in the young generation large object space are not copied. Their
+  // page is moved to the old generation large object space instead, which
+  // leaves all slots pointing to the object valid.
+  template <ObjectContents object_contents>
+  static inline void PromoteLargeObject(Heap* heap, HeapObject* object,
+                                        int object_size) {
+    DCHECK(heap->new_lo_space()->Contains(object));
+    heap->lo_space()->PromoteNewLargeObject(
+        static_cast<LargePage*>(MemoryChunk::FromAddress(object->address())));
+
+    if (logging_and_profiling_mode == LOGGING_AND_PROFILING_ENABLED) {
+      RecordCopiedObject(heap, object);
+    }
+
+    if (object_contents == POINTER_OBJECT) {
+      heap->promotion_queue()->insert(object, object_size);
+    }
+    heap->IncrementPromotedObjectsSize(object_size);
+  }
+
   template <ObjectContents object_contents, AllocationAlignment alignment>
   static inline void EvacuateObject(Map* map, HeapObject** slot,
                                     HeapObject* object, int object_size) {
-    SLOW_DCHECK(object_size <= Page::kAllocatableMemory);
     SLOW_DCHECK(object->Size() == object_size);
     Heap* heap = map->GetHeap();
 
+    if (object_size > kMaxRegularHeapObjectSize) {
+      PromoteLargeObject<object_contents>(heap, object, object_size);
+      return;
+    }
+    SLOW_DCHECK(object_size <= Page::kAllocatableMemory);
+
     if (!heap->ShouldBePromoted(object->address(), object_size)) {
       // A semi-space copy may fail due to fragmentation. In that case, we
       // try to promote the object.
@@ -411,12 +442,15 @@ void Scavenger::ScavengeObjectSlow(HeapObject** p, HeapObject* object) {
 }
 
 
+bool Scavenger::IsLoggingOrProfiling() {
+  return FLAG_verify_predictable || isolate()->logger()->is_logging() ||
+         isolate()->is_profiling() ||
+         (isolate()->heap_profiler() != NULL &&
+          isolate()->heap_profiler()->is_tracking_object_moves());
+}
+
 void Scavenger::SelectScavengingVisitorsTable() {
-  bool logging_and_profiling =
-      FLAG_verify_predictable || isolate()->logger()->is_logging() ||
-      isolate()->is_profiling() ||
-      (isolate()->heap_profiler() != NULL &&
-       isolate()->heap_profiler()->is_tracking_object_moves());
+  bool logging_and_profiling = IsLoggingOrProfiling();
 
   if (!heap()->incremental_marking()->IsMarking()) {
     if (!logging_and_profiling) {
@@ -458,6 +492,392 @@ void Scavenger::SelectScavengingVisitorsTable() {
 
 Isolate* Scavenger::isolate() { return heap()->isolate(); }
 
+bool Scavenger::CanScavengeInParallel() {
+  // Young large objects are promoted by relinking their pages, which is only
+  // implemented for the sequential scavenger.
+  return !heap()->incremental_marking()->IsMarking() &&
+         !IsLoggingOrProfiling() && heap()->new_lo_space()->IsEmpty();
+}
+
+int Scavenger::NumberOfParallelScavengeTasks() {
+  // Use one task per MB of new space, bounded by the number of cores and the
+  // number of tasks the marking deque supports.
+  const int wanted_tasks =
+      static_cast<int>(heap()->new_space()->TotalCapacity() / MB);
+  const int available_cores = Max(
+      1, static_cast<int>(
+             V8::GetCurrentPlatform()->NumberOfAvailableBackgroundThreads()));
+  return Max(1, Min(Min(wanted_tasks, available_cores),
+                    WorkStealingMarkingDeque::kMaxNumTasks));
+}
+
+namespace {
+
+// Data objects do not contain pointers and do not need to be visited after
+// they have been copied.
+bool IsDataObject(Map* map) {
+  switch (static_cast<VisitorId>(map->visitor_id())) {
+    case kVisitByteArray:
+    case kVisitDataObject:
+    case kVisitFixedDoubleArray:
+    case kVisitSeqOneByteString:
+    case kVisitSeqTwoByteString:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Computes the alignment of |object| from |map| as the map word of |object|
+// may be replaced with a forwarding address by another task at any time.
+AllocationAlignment RequiredAlignment(Map* map, HeapObject* object) {
+#ifdef V8_HOST_ARCH_32_BIT
+  InstanceType type = map->instance_type();
+  if ((type == FIXED_FLOAT64_ARRAY_TYPE || type == FIXED_DOUBLE_ARRAY_TYPE) &&
+      reinterpret_cast<FixedArrayBase*>(object)->length() != 0) {
+    return kDoubleAligned;
+  }
+  if (type == HEAP_NUMBER_TYPE) return kDoubleUnaligned;
+#endif  // V8_HOST_ARCH_32_BIT
+  return kWordAligned;
+}
+
+}  // namespace
+
+// Visits the body of an object copied by the parallel scavenger and scavenges
+// all from-space objects it references. Slots of promoted objects that still
+// point into new space afterwards are recorded for the remembered set.
+class ParallelScavengeVisitor final : public ObjectVisitor {
+ public:
+  ParallelScavengeVisitor(LocalScavenger* scavenger, bool record_slots)
+      : scavenger_(scavenger), record_slots_(record_slots) {}
+
+  void VisitPointers(HeapObject* host, Object** start, Object** end) override {
+    Heap* heap = scavenger_->heap();
+    for (Object** slot = start; slot < end; slot++) {
+      Object* target = *slot;
+      if (!heap->InFromSpace(target)) continue;
+      scavenger_->ScavengeObject(reinterpret_cast<HeapObject**>(slot),
+                                 reinterpret_cast<HeapObject*>(target));
+      if (record_slots_ && heap->InNewSpace(*slot)) {
+        scavenger_->RecordOldToNewSlot(reinterpret_cast<Address>(slot));
+      }
+    }
+  }
+
+ private:
+  LocalScavenger* scavenger_;
+  bool record_slots_;
+};
+
+LocalScavenger::LocalScavenger(Heap* heap, WorkStealingMarkingDeque* deque,
+                               int task_id)
+    : heap_(heap),
+      deque_(deque, task_id),
+      buffer_(LocalAllocationBuffer::InvalidBuffer()),
+      compaction_spaces_(heap),
+      local_pretenuring_feedback_(base::HashMap::kDefaultHashMapCapacity),
+      copied_size_(0),
+      promoted_size_(0) {}
+
+void LocalScavenger::Process() {
+  HeapObject* object = nullptr;
+  while (deque_.WaitForMoreObjects()) {
+    while (deque_.Pop(&object)) {
+      IterateAndScavengeObject(object);
+    }
+  }
+}
+
+void LocalScavenger::Finalize() {
+  heap()->old_space()->MergeCompactionSpace(compaction_spaces_.Get(OLD_SPACE));
+  heap()->code_space()->MergeCompactionSpace(
+      compaction_spaces_.Get(CODE_SPACE));
+  heap()->IncrementPromotedObjectsSize(promoted_size_);
+  heap()->IncrementSemiSpaceCopiedObjectSize(copied_size_);
+  heap()->MergeAllocationSitePretenuringFeedback(local_pretenuring_feedback_);
+  for (Address slot : old_to_new_slots_) {
+    RememberedSet<OLD_TO_NEW>::Insert(Page::FromAddress(slot), slot);
+  }
+  old_to_new_slots_.clear();
+}
+
+void LocalScavenger::IterateAndScavengeObject(HeapObject* object) {
+  Map* map = object->map();
+  const int size = object->SizeFromMap(map);
+  ParallelScavengeVisitor visitor(this, !heap()->InNewSpace(object));
+  switch (static_cast<VisitorId>(map->visitor_id())) {
+    case kVisitJSFunction:
+      // JSFunctions reachable through kNextFunctionLinkOffset are weak.
+      JSFunction::BodyDescriptorWeakCode::IterateBody(object, size, &visitor);
+      break;
+    case kVisitNativeContext:
+      Context::ScavengeBodyDescriptor::IterateBody(object, size, &visitor);
+      break;
+    default:
+      object->IterateBody(map->instance_type(), size, &visitor);
+      break;
+  }
+}
+
+bool LocalScavenger::MigrateObject(Map* map, HeapObject* source,
+                                   HeapObject* target, int size) {
+  // The map is taken from |map| as the map word of |source| may already have
+  // been replaced with a forwarding address.
+  target->set_map_word(MapWord::FromMap(map));
+  heap()->CopyBlock(target->address() + kPointerSize,
+                    source->address() + kPointerSize, size - kPointerSize);
+  base::AtomicWord old = base::Release_CompareAndSwap(
+      reinterpret_cast<base::AtomicWord*>(source->address()),
+      reinterpret_cast<base::AtomicWord>(map),
+      reinterpret_cast<base::AtomicWord>(
+          MapWord::FromForwardingAddress(target).ToMap()));
+  return old == reinterpret_cast<base::AtomicWord>(map);
+}
+
+void LocalScavenger::OnRaceLost(HeapObject** slot, HeapObject* object,
+                                HeapObject* target, int size) {
+  // Another task installed its forwarding address first. Our copy becomes a
+  // filler and the slot is updated to the winning copy.
+  heap()->CreateFillerObjectAt(target->address(), size,
+                               ClearRecordedSlots::kNo);
+  *slot = object->synchronized_map_word().ToForwardingAddress();
+}
+
+bool LocalScavenger::SemiSpaceCopyObject(Map* map, HeapObject** slot,
+                                         HeapObject* object, int object_size,
+                                         AllocationAlignment alignment) {
+  AllocationResult allocation = AllocateInNewSpace(object_size, alignment);
+  HeapObject* target = nullptr;
+  if (!allocation.To(&target)) return false;
+  if (!MigrateObject(map, object, target, object_size)) {
+    OnRaceLost(slot, object, target, object_size);
+    return true;
+  }
+  *slot = target;
+  heap()->UpdateAllocationSite<Heap::kCached>(map, object,
+                                              &local_pretenuring_feedback_);
+  copied_size_ += object_size;
+  if (!IsDataObject(map)) deque_.Push(target);
+  return true;
+}
+
+bool LocalScavenger::PromoteObject(Map* map, HeapObject** slot,
+                                   HeapObject* object, int object_size,
+                                   AllocationAlignment alignment) {
+  AllocationResult allocation =
+      compaction_spaces_.Get(OLD_SPACE)->AllocateRaw(object_size, alignment);
+  HeapObject* target = nullptr;
+  if (!allocation.To(&target)) return false;
+  if (!MigrateObject(map, object, target, object_size)) {
+    OnRaceLost(slot, object, target, object_size);
+    return true;
+  }
+  // Update slot to new target using CAS. A concurrent sweeper thread my
+  // filter the slot concurrently.
+  HeapObject* old = *slot;
+  base::Release_CompareAndSwap(reinterpret_cast<base::AtomicWord*>(slot),
+                               reinterpret_cast<base::AtomicWord>(old),
+                               reinterpret_cast<base::AtomicWord>(target));
+  heap()->UpdateAllocationSite<Heap::kCached>(map, object,
+                                              &local_pretenuring_feedback_);
+  promoted_size_ += object_size;
+  if (!IsDataObject(map)) deque_.Push(target);
+  return true;
+}
+
+void LocalScavenger::EvacuateObject(HeapObject** slot, Map* map,
+                                    HeapObject* source) {
+  const int size = source->SizeFromMap(map);
+  const AllocationAlignment alignment = RequiredAlignment(map, source);
+  SLOW_DCHECK(size <= Page::kAllocatableMemory);
+
+  if (!heap()->ShouldBePromoted(source->address(), size)) {
+    // A semi-space copy may fail due to fragmentation. In that case, we
+    // try to promote the object.
+    if (SemiSpaceCopyObject(map, slot, source, size, alignment)) return;
+  }
+
+  if (PromoteObject(map, slot, source, size, alignment)) return;
+
+  // If promotion failed, we try to copy the object to the other semi-space.
+  if (SemiSpaceCopyObject(map, slot, source, size, alignment)) return;
+
+  FatalProcessOutOfMemory("Scavenger: semi-space copy\n");
+}
+
+AllocationResult LocalScavenger::AllocateInNewSpace(
+    int size_in_bytes, AllocationAlignment alignment) {
+  NewSpace* new_space = heap()->new_space();
+  if (size_in_bytes > kMaxLabObjectSize) {
+    AllocationResult allocation =
+        new_space->AllocateRawSynchronized(size_in_bytes, alignment);
+    if (allocation.IsRetry() && new_space->AddFreshPageSynchronized()) {
+      allocation = new_space->AllocateRawSynchronized(size_in_bytes, alignment);
+    }
+    return allocation;
+  }
+
+  AllocationResult allocation =
+      buffer_.AllocateRawAligned(size_in_bytes, alignment);
+  if (!allocation.IsRetry()) return allocation;
+
+  AllocationResult result =
+      new_space->AllocateRawSynchronized(kLabSize, kWordAligned);
+  if (result.IsRetry() && new_space->AddFreshPageSynchronized()) {
+    result = new_space->AllocateRawSynchronized(kLabSize, kWordAligned);
+  }
+  LocalAllocationBuffer saved_old_buffer = buffer_;
+  buffer_ = LocalAllocationBuffer::FromResult(heap(), result, kLabSize);
+  if (!buffer_.IsValid()) return AllocationResult::Retry(NEW_SPACE);
+  buffer_.TryMerge(&saved_old_buffer);
+  return buffer_.AllocateRawAligned(size_in_bytes, alignment);
+}
+
+// Scavenges the old-to-new slots recorded in the slot sets
+// [start_slot_set, end_slot_set) of a memory chunk. Regular pages have a
+// single slot set and are processed as a whole. Large pages are split into
+// one item per slot set so that a single large, heavily written object does
+// not serialize the parallel phase.
+class PageScavengingItem final : public ItemParallelJob::Item {
+ public:
+  PageScavengingItem(MemoryChunk* chunk, int start_slot_set, int end_slot_set)
+      : chunk_(chunk),
+        start_slot_set_(start_slot_set),
+        end_slot_set_(end_slot_set) {}
+  virtual ~PageScavengingItem() {}
+
+  void Process(LocalScavenger* scavenger) {
+    if (start_slot_set_ == 0 &&
+        end_slot_set_ == RememberedSet<OLD_TO_NEW>::NumberOfSlotSets(chunk_)) {
+      base::LockGuard<base::RecursiveMutex> guard(chunk_->mutex());
+      ProcessSlots(scavenger);
+    } else {
+      // Large pages are not swept concurrently, so the parts of a split page
+      // do not need to synchronize on the page mutex.
+      ProcessSlots(scavenger);
+    }
+  }
+
+ private:
+  void ProcessSlots(LocalScavenger* scavenger) {
+    RememberedSet<OLD_TO_NEW>::IterateSlotSets(
+        chunk_, start_slot_set_, end_slot_set_, [scavenger](Address slot) {
+          return scavenger->CheckAndScavengeObject(slot);
+        });
+    // Typed slots are processed by the item covering the first slot set.
+    if (start_slot_set_ > 0) return;
+    Isolate* isolate = chunk_->heap()->isolate();
+    RememberedSet<OLD_TO_NEW>::IterateTyped(
+        chunk_, [isolate, scavenger](SlotType type, Address host_addr,
+                                     Address slot) {
+          return UpdateTypedSlotHelper::UpdateTypedSlot(
+              isolate, type, slot, [scavenger](Object** slot) {
+                return scavenger->CheckAndScavengeObject(
+                    reinterpret_cast<Address>(slot));
+              });
+        });
+  }
+
+  MemoryChunk* const chunk_;
+  const int start_slot_set_;
+  const int end_slot_set_;
+};
+
+class ScavengingTask final : public ItemParallelJob::Task {
+ public:
+  ScavengingTask(Isolate* isolate, LocalScavenger* scavenger)
+      : ItemParallelJob::Task(isolate), scavenger_(scavenger) {}
+
+  void RunInParallel() override {
+    double scavenging_time = 0.0;
+    {
+      TimedScope scope(&scavenging_time);
+      PageScavengingItem* item = nullptr;
+      while ((item = GetItem<PageScavengingItem>()) != nullptr) {
+        item->Process(scavenger_);
+        item->MarkFinished();
+        scavenger_->Process();
+      }
+      scavenger_->Process();
+    }
+    if (FLAG_trace_parallel_scavenge) {
+      PrintIsolate(scavenger_->heap()->isolate(),
+                   "scavenge[%p]: time=%.2f\n", static_cast<void*>(this),
+                   scavenging_time);
+    }
+  }
+
+ private:
+  LocalScavenger* const scavenger_;
+};
+
+void Scavenger::ScavengeInParallel() {
+  WorkStealingMarkingDeque deque;
+  const int num_tasks = NumberOfParallelScavengeTasks();
+  LocalScavenger* scavengers[WorkStealingMarkingDeque::kMaxNumTasks];
+  for (int i = 0; i < num_tasks; i++) {
+    scavengers[i] = new LocalScavenger(heap(), &deque, i);
+  }
+  // The first task of an ItemParallelJob runs on the main thread.
+  LocalScavenger* main_thread_scavenger = scavengers[0];
+  LocalRootScavengeVisitor root_scavenge_visitor(main_thread_scavenger);
+
+  {
+    // Copy roots. Objects reachable from them are distributed among the tasks
+    // through the work-stealing deque.
+    TRACE_GC(heap()->tracer(), GCTracer::Scope::SCAVENGER_ROOTS);
+    heap()->IterateRoots(&root_scavenge_visitor, VISIT_ALL_IN_SCAVENGE);
+  }
+
+  {
+    TRACE_GC(heap()->tracer(), GCTracer::Scope::SCAVENGER_WEAK);
+    heap()->IterateEncounteredWeakCollections(&root_scavenge_visitor);
+  }
+
+  {
+    // Copy objects reachable from the old generation and the transitive
+    // closure of everything copied so far.
+    TRACE_GC(heap()->tracer(), GCTracer::Scope::SCAVENGER_SCAVENGE_PARALLEL);
+    ItemParallelJob job(isolate()->cancelable_task_manager(),
+                        &parallel_scavenge_semaphore_);
+    RememberedSet<OLD_TO_NEW>::IterateMemoryChunks(
+        heap(), [&job](MemoryChunk* chunk) {
+          int slot_sets = RememberedSet<OLD_TO_NEW>::NumberOfSlotSets(chunk);
+          if (slot_sets == 1 || chunk->slot_set<OLD_TO_NEW>() == nullptr) {
+            job.AddItem(new PageScavengingItem(chunk, 0, slot_sets));
+            return;
+          }
+          for (int i = 0; i < slot_sets; i++) {
+            job.AddItem(new PageScavengingItem(chunk, i, i + 1));
+          }
+        });
+    for (int i = 0; i < num_tasks; i++) {
+      job.AddTask(new ScavengingTask(isolate(), scavengers[i]));
+    }
+    job.Run();
+  }
+
+  isolate()->global_handles()->MarkNewSpaceWeakUnmodifiedObjectsPending(
+      &Heap::IsUnscavengedHeapObject);
+  isolate()->global_handles()->IterateNewSpaceWeakUnmodifiedRoots(
+      &root_scavenge_visitor);
+  main_thread_scavenger->Process();
+
+  const Address top = heap()->new_space()->top();
+  for (int i = 0; i < num_tasks; i++) {
+    scavengers[i]->Finalize();
+    // If the last LAB of a task is adjacent to the current top, move top back
+    // so that the unused part of the LAB can be allocated again.
+    const AllocationInfo info = scavengers[i]->CloseLAB();
+    if (info.limit() != nullptr && info.limit() == top) {
+      DCHECK_NOT_NULL(info.top());
+      *heap()->new_space()->allocation_top_address() = info.top();
+    }
+    delete scavengers[i];
+  }
+}
+
 void RootScavengeVisitor::VisitRootPointer(Root root, Object** p) {
   ScavengePointer(p);
 }
@@ -468,6 +888,15 @@ void RootScavengeVisitor::VisitRootPointers(Root root, Object** start,
   for (Object** p = start; p < end; p++) ScavengePointer(p);
 }
 
+void LocalRootScavengeVisitor::VisitRootPointer(Root root, Object** p) {
+  scavenger_->ScavengePointer(p);
+}
+
+void LocalRootScavengeVisitor::VisitRootPointers(Root root, Object** start,
+                                                 Object** end) {
+  for (Object** p = start; p < end; p++) scavenger_->ScavengePointer(p);
+}
+
 void RootScavengeVisitor::ScavengePointer(Object** p) {
   Object* object = *p;
   if (!heap_->InNewSpace(object)) return;
@@ -5,8 +5,14 @@
 #ifndef V8_HEAP_SCAVENGER_H_
 #define V8_HEAP_SCAVENGER_H_
 
+#include <vector>
+
+#include "src/base/hashmap.h"
+#include "src/base/platform/semaphore.h"
 #include "src/heap/objects-visiting.h"
 #include "src/heap/slot-set.h"
+#include "src/heap/spaces.h"
+#include "src/heap/workstealing-marking-deque.h"
 
 namespace v8 {
 namespace internal {
@@ -16,7 +22,8 @@ typedef void (*ScavengingCallback)(Map* map, HeapObject** slot,
 
 class Scavenger {
  public:
-  explicit Scavenger(Heap* heap) : heap_(heap) {}
+  explicit Scavenger(Heap* heap)
+      : heap_(heap), parallel_scavenge_semaphore_(0) {}
 
   // Initializes static visitor dispatch tables.
   static void Initialize();
@@ -36,12 +43,92 @@ class Scavenger {
   // of the heap (i.e. incremental marking, logging and profiling).
   void SelectScavengingVisitorsTable();
 
+  // Returns true if the current state of the heap allows copying objects from
+  // several tasks. Incremental marking, logging and profiling as well as
+  // young large objects require the sequential scavenger.
+  bool CanScavengeInParallel();
+
+  // Copies all objects reachable from roots and old-to-new slots using
+  // several tasks. Replaces the Cheney scan of the sequential scavenger.
+  void ScavengeInParallel();
+
   Isolate* isolate();
   Heap* heap() { return heap_; }
 
  private:
+  bool IsLoggingOrProfiling();
+  int NumberOfParallelScavengeTasks();
+
   Heap* heap_;
   VisitorDispatchTable<ScavengingCallback> scavenging_visitors_table_;
+  base::Semaphore parallel_scavenge_semaphore_;
+};
+
+// Scavenger state owned by a single task of the parallel scavenger. Objects
+// are copied into task-local allocation buffers (a LAB in to-space and a
+// compaction space in old space) and are then pushed onto the task's portion
+// of a shared work-stealing deque until their bodies have been visited.
+// Forwarding addresses are installed with a compare-and-swap on the map word,
+// so several tasks may race for the same object.
+class LocalScavenger {
+ public:
+  LocalScavenger(Heap* heap, WorkStealingMarkingDeque* deque, int task_id);
+
+  // Scavenges the object pointed to by {p} if it lives in from-space.
+  inline void ScavengePointer(Object** p);
+
+  // Scavenges the object referenced from an old-to-new slot and returns
+  // whether the slot has to be kept in the remembered set.
+  inline SlotCallbackResult CheckAndScavengeObject(Address slot_address);
+
+  // Visits copied objects until neither the local portion of the deque nor
+  // other tasks have work left.
+  void Process();
+
+  // Hands compaction spaces, counters, pretenuring feedback and recorded
+  // slots back to the heap. Must be called on the main thread after all tasks
+  // have finished.
+  void Finalize();
+
+  AllocationInfo CloseLAB() { return buffer_.Close(); }
+
+  Heap* heap() { return heap_; }
+
+ private:
+  static const int kLabSize = 4 * KB;
+  static const int kMaxLabObjectSize = 256;
+
+  inline void ScavengeObject(HeapObject** p, HeapObject* object);
+  void EvacuateObject(HeapObject** slot, Map* map, HeapObject* source);
+  inline bool SemiSpaceCopyObject(Map* map, HeapObject** slot,
+                                  HeapObject* object, int object_size,
+                                  AllocationAlignment alignment);
+  inline bool PromoteObject(Map* map, HeapObject** slot, HeapObject* object,
+                            int object_size, AllocationAlignment alignment);
+  inline bool MigrateObject(Map* map, HeapObject* source, HeapObject* target,
+                            int size);
+  inline void OnRaceLost(HeapObject** slot, HeapObject* object,
+                         HeapObject* target, int size);
+  AllocationResult AllocateInNewSpace(int size_in_bytes,
+                                      AllocationAlignment alignment);
+  void IterateAndScavengeObject(HeapObject* object);
+  void RecordOldToNewSlot(Address slot_address) {
+    old_to_new_slots_.push_back(slot_address);
+  }
+
+  Heap* heap_;
+  LocalWorkStealingMarkingDeque deque_;
+  LocalAllocationBuffer buffer_;
+  CompactionSpaceCollection compaction_spaces_;
+  base::HashMap local_pretenuring_feedback_;
+  // Slots of promoted objects that still point into new space. They are
+  // inserted into the remembered set on the main thread as slot sets do not
+  // support concurrent insertion and iteration.
+  std::vector<Address> old_to_new_slots_;
+  size_t copied_size_;
+  size_t promoted_size_;
+
+  friend class ParallelScavengeVisitor;
 };
 
 // Helper class for turning the scavenger into an object visitor that is also
@@ -60,6 +147,20 @@ class RootScavengeVisitor : public RootVisitor {
 };
 
 
+// Root visitor used by the parallel scavenger. Roots are processed on the main
+// thread; the objects reachable from them are distributed through the deque.
+class LocalRootScavengeVisitor : public RootVisitor {
+ public:
+  explicit LocalRootScavengeVisitor(LocalScavenger* scavenger)
+      : scavenger_(scavenger) {}
+
+  void VisitRootPointer(Root root, Object** p) override;
+  void VisitRootPointers(Root root, Object** start, Object** end) override;
+
+ private:
+  LocalScavenger* scavenger_;
+};
+
 // Helper class for turning the scavenger into an object visitor that is also
 // filtering out non-HeapObjects and objects which do not reside in new space.
 class StaticScavengeVisitor
@@ -24,6 +24,9 @@ enum SlotCallbackResult { KEEP_SLOT, REMOVE_SLOT };
 // The data structure assumes that the slots are pointer size aligned and
 // splits the valid slot offset range into kBuckets buckets.
 // Each bucket is a bitmap with a bit corresponding to a single slot offset.
+// Most pages only ever record a handful of slots, so a set starts out in
+// sparse mode where up to kSparseSlots slots are stored inline. The bucket
+// array is allocated when the sparse slots overflow.
 class SlotSet : public Malloced {
  public:
   enum EmptyBucketMode {
@@ -34,54 +37,61 @@ class SlotSet : public Malloced {
     KEEP_EMPTY_BUCKETS      // An empty bucket will be kept.
   };
 
-  SlotSet() {
-    for (int i = 0; i < kBuckets; i++) {
-      bucket[i].SetValue(nullptr);
+  static const int kSparseSlots = 16;
+
+  SlotSet() : page_start_(nullptr) {
+    buckets_.SetValue(nullptr);
+    for (int i = 0; i < kSparseSlots; i++) {
+      sparse_slots_[i].SetValue(kEmptySparseSlot);
     }
   }
 
   ~SlotSet() {
-    for (int i = 0; i < kBuckets; i++) {
-      ReleaseBucket(i);
+    Bucket* buckets = buckets_.Value();
+    if (buckets != nullptr) {
+      for (int i = 0; i < kBuckets; i++) {
+        ReleaseBucket(buckets, i);
+      }
+      DeleteArray<Bucket>(buckets);
     }
     FreeToBeFreedBuckets();
   }
 
   void SetPageStart(Address page_start) { page_start_ = page_start; }
 
+  // Returns true if the slots are stored inline, i.e. no buckets have been
+  // allocated yet.
+  bool IsSparse() const { return buckets_.Value() == nullptr; }
+
   // The slot offset specifies a slot at address page_start_ + slot_offset.
-  // This method should only be called on the main thread because concurrent
-  // allocation of the bucket is not thread-safe.
+  // This method can be called concurrently with other Insert calls, e.g.
+  // from the main thread and the concurrent marker, and with Remove* calls
+  // that keep buckets, e.g. from the sweeper, but not with Remove* calls
+  // that free buckets.
   void Insert(int slot_offset) {
-    int bucket_index, cell_index, bit_index;
-    SlotToIndices(slot_offset, &bucket_index, &cell_index, &bit_index);
-    base::AtomicValue<uint32_t>* current_bucket = bucket[bucket_index].Value();
-    if (current_bucket == nullptr) {
-      current_bucket = AllocateBucket();
-      bucket[bucket_index].SetValue(current_bucket);
-    }
-    if (!(current_bucket[cell_index].Value() & (1u << bit_index))) {
-      current_bucket[cell_index].SetBit(bit_index);
+    Bucket* buckets = buckets_.Value();
+    if (buckets == nullptr) {
+      if (InsertSparse(slot_offset)) return;
+      buckets = buckets_.Value();
+      DCHECK_NOT_NULL(buckets);
     }
+    InsertInBuckets(buckets, slot_offset);
   }
 
   // The slot offset specifies a slot at address page_start_ + slot_offset.
   // Returns true if the set contains the slot.
-  bool Contains(int slot_offset) {
-    int bucket_index, cell_index, bit_index;
-    SlotToIndices(slot_offset, &bucket_index, &cell_index, &bit_index);
-    base::AtomicValue<uint32_t>* current_bucket = bucket[bucket_index].Value();
-    if (current_bucket == nullptr) {
-      return false;
-    }
-    return (current_bucket[cell_index].Value() & (1u << bit_index)) != 0;
-  }
+  bool Contains(int slot_offset) { return Lookup(slot_offset); }
 
   // The slot offset specifies a slot at address page_start_ + slot_offset.
   void Remove(int slot_offset) {
+    Bucket* buckets = buckets_.Value();
+    if (buckets == nullptr) {
+      if (RemoveSparse(slot_offset)) return;
+      buckets = buckets_.Value();
+    }
     int bucket_index, cell_index, bit_index;
     SlotToIndices(slot_offset, &bucket_index, &cell_index, &bit_index);
-    base::AtomicValue<uint32_t>* current_bucket = bucket[bucket_index].Value();
+    base::AtomicValue<uint32_t>* current_bucket = buckets[bucket_index].Value();
     if (current_bucket != nullptr) {
       uint32_t cell = current_bucket[cell_index].Value();
       if (cell) {
@@ -98,6 +108,11 @@ class SlotSet : public Malloced {
   void RemoveRange(int start_offset, int end_offset, EmptyBucketMode mode) {
     CHECK_LE(end_offset, 1 << kPageSizeBits);
     DCHECK_LE(start_offset, end_offset);
+    Bucket* buckets = buckets_.Value();
+    if (buckets == nullptr) {
+      if (RemoveSparseRange(start_offset, end_offset)) return;
+      buckets = buckets_.Value();
+    }
     int start_bucket, start_cell, start_bit;
     SlotToIndices(start_offset, &start_bucket, &start_cell, &start_bit);
     int end_bucket, end_cell, end_bit;
@@ -105,14 +120,14 @@ class SlotSet : public Malloced {
     uint32_t start_mask = (1u << start_bit) - 1;
     uint32_t end_mask = ~((1u << end_bit) - 1);
     if (start_bucket == end_bucket && start_cell == end_cell) {
-      ClearCell(start_bucket, start_cell, ~(start_mask | end_mask));
+      ClearCell(buckets, start_bucket, start_cell, ~(start_mask | end_mask));
       return;
     }
     int current_bucket = start_bucket;
     int current_cell = start_cell;
-    ClearCell(current_bucket, current_cell, ~start_mask);
+    ClearCell(buckets, current_bucket, current_cell, ~start_mask);
     current_cell++;
-    base::AtomicValue<uint32_t>* bucket_ptr = bucket[current_bucket].Value();
+    base::AtomicValue<uint32_t>* bucket_ptr = buckets[current_bucket].Value();
     if (current_bucket < end_bucket) {
       if (bucket_ptr != nullptr) {
         ClearBucket(bucket_ptr, current_cell, kCellsPerBucket);
@@ -126,12 +141,12 @@ class SlotSet : public Malloced {
            (current_bucket < end_bucket && current_cell == 0));
     while (current_bucket < end_bucket) {
       if (mode == PREFREE_EMPTY_BUCKETS) {
-        PreFreeEmptyBucket(current_bucket);
+        PreFreeEmptyBucket(buckets, current_bucket);
       } else if (mode == FREE_EMPTY_BUCKETS) {
-        ReleaseBucket(current_bucket);
+        ReleaseBucket(buckets, current_bucket);
       } else {
         DCHECK(mode == KEEP_EMPTY_BUCKETS);
-        bucket_ptr = bucket[current_bucket].Value();
+        bucket_ptr = buckets[current_bucket].Value();
         if (bucket_ptr) {
           ClearBucket(bucket_ptr, 0, kCellsPerBucket);
         }
@@ -139,26 +154,34 @@ class SlotSet : public Malloced {
       current_bucket++;
     }
     // All buckets between start_bucket and end_bucket are cleared.
-    bucket_ptr = bucket[current_bucket].Value();
     DCHECK(current_bucket == end_bucket && current_cell <= end_cell);
-    if (current_bucket == kBuckets || bucket_ptr == nullptr) {
-      return;
-    }
+    if (current_bucket == kBuckets) return;
+    bucket_ptr = buckets[current_bucket].Value();
+    if (bucket_ptr == nullptr) return;
     while (current_cell < end_cell) {
       bucket_ptr[current_cell].SetValue(0);
       current_cell++;
     }
     // All cells between start_cell and end_cell are cleared.
     DCHECK(current_bucket == end_bucket && current_cell == end_cell);
-    ClearCell(end_bucket, end_cell, ~end_mask);
+    ClearCell(buckets, end_bucket, end_cell, ~end_mask);
   }
 
   // The slot offset specifies a slot at address page_start_ + slot_offset.
   bool Lookup(int slot_offset) {
+    Bucket* buckets = buckets_.Value();
+    if (buckets == nullptr) {
+      if (FindSparseSlot(SparseValue(slot_offset)) >= 0) return true;
+      // A concurrent insert may have moved the inline slots to the buckets
+      // while they were scanned. See AllocateBuckets.
+      buckets = buckets_.Value();
+      if (buckets == nullptr) return false;
+    }
     int bucket_index, cell_index, bit_index;
     SlotToIndices(slot_offset, &bucket_index, &cell_index, &bit_index);
-    if (bucket[bucket_index].Value() != nullptr) {
-      uint32_t cell = bucket[bucket_index].Value()[cell_index].Value();
+    base::AtomicValue<uint32_t>* current_bucket = buckets[bucket_index].Value();
+    if (current_bucket != nullptr) {
+      uint32_t cell = current_bucket[cell_index].Value();
       return (cell & (1u << bit_index)) != 0;
     }
     return false;
@@ -176,10 +199,16 @@ class SlotSet : public Malloced {
   // });
   template <typename Callback>
   int Iterate(Callback callback, EmptyBucketMode mode) {
+    Bucket* buckets = buckets_.Value();
+    if (buckets == nullptr) {
+      int sparse_count;
+      if (IterateSparse(callback, &sparse_count)) return sparse_count;
+      buckets = buckets_.Value();
+    }
     int new_count = 0;
     for (int bucket_index = 0; bucket_index < kBuckets; bucket_index++) {
       base::AtomicValue<uint32_t>* current_bucket =
-          bucket[bucket_index].Value();
+          buckets[bucket_index].Value();
       if (current_bucket != nullptr) {
         int in_bucket_count = 0;
         int cell_offset = bucket_index * kBitsPerBucket;
@@ -214,7 +243,7 @@ class SlotSet : public Malloced {
           }
         }
         if (mode == PREFREE_EMPTY_BUCKETS && in_bucket_count == 0) {
-          PreFreeEmptyBucket(bucket_index);
+          PreFreeEmptyBucket(buckets, bucket_index);
         }
         new_count += in_bucket_count;
       }
@@ -223,7 +252,7 @@ class SlotSet : public Malloced {
   }
 
   void FreeToBeFreedBuckets() {
-    base::LockGuard<base::Mutex> guard(&to_be_freed_buckets_mutex_);
+    base::LockGuard<base::Mutex> guard(&mutex_);
     while (!to_be_freed_buckets_.empty()) {
       base::AtomicValue<uint32_t>* top = to_be_freed_buckets_.top();
       to_be_freed_buckets_.pop();
@@ -241,6 +270,142 @@ class SlotSet : public Malloced {
   static const int kBitsPerBucketLog2 = kCellsPerBucketLog2 + kBitsPerCellLog2;
   static const int kBuckets = kMaxSlots / kCellsPerBucket / kBitsPerCell;
 
+  typedef base::AtomicValue<base::AtomicValue<uint32_t>*> Bucket;
+
+  // Sparse slots are stored as slot index + 1 so that zero marks a free
+  // entry.
+  static const uint32_t kEmptySparseSlot = 0;
+
+  static uint32_t SparseValue(int slot_offset) {
+    DCHECK_EQ(slot_offset % kPointerSize, 0);
+    return static_cast<uint32_t>(slot_offset >> kPointerSizeLog2) + 1;
+  }
+
+  static int SparseValueToOffset(uint32_t value) {
+    DCHECK(value != kEmptySparseSlot);
+    return static_cast<int>(value - 1) << kPointerSizeLog2;
+  }
+
+  int FindSparseSlot(uint32_t value) {
+    for (int i = 0; i < kSparseSlots; i++) {
+      if (sparse_slots_[i].Value() == value) return i;
+    }
+    return -1;
+  }
+
+  // Returns false if the slot has to be inserted into the buckets instead,
+  // which are guaranteed to be allocated at that point.
+  bool InsertSparse(int slot_offset) {
+    uint32_t value = SparseValue(slot_offset);
+    if (FindSparseSlot(value) >= 0) return true;
+    // New entries are only added under the lock so that two racing inserts
+    // cannot record the same slot twice.
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    if (buckets_.Value() != nullptr) return false;
+    int free_index = -1;
+    for (int i = 0; i < kSparseSlots; i++) {
+      uint32_t current = sparse_slots_[i].Value();
+      if (current == value) return true;
+      if (current == kEmptySparseSlot && free_index < 0) free_index = i;
+    }
+    if (free_index >= 0) {
+      sparse_slots_[free_index].SetValue(value);
+      return true;
+    }
+    AllocateBuckets();
+    return false;
+  }
+
+  // Moves the inline slots into a freshly allocated bucket array. Must be
+  // called with mutex_ held.
+  void AllocateBuckets() {
+    DCHECK_NULL(buckets_.Value());
+    Bucket* buckets = NewArray<Bucket>(kBuckets);
+    for (int i = 0; i < kBuckets; i++) {
+      buckets[i].SetValue(nullptr);
+    }
+    for (int i = 0; i < kSparseSlots; i++) {
+      uint32_t value = sparse_slots_[i].Value();
+      if (value != kEmptySparseSlot) {
+        InsertInBuckets(buckets, SparseValueToOffset(value));
+      }
+    }
+    // Publish the buckets before dropping the inline slots. A concurrent
+    // lookup that misses a slot in the inline slots because they were cleared
+    // will then see the buckets when it re-reads buckets_.
+    buckets_.SetValue(buckets);
+    for (int i = 0; i < kSparseSlots; i++) {
+      sparse_slots_[i].SetValue(kEmptySparseSlot);
+    }
+  }
+
+  // The sparse Remove* and Iterate paths hold mutex_ while they touch the
+  // inline slots, so that AllocateBuckets cannot copy a slot into the buckets
+  // that is being removed. They return false if the buckets were allocated
+  // before the lock was taken; the caller then has to use the buckets.
+  bool RemoveSparse(int slot_offset) {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    if (buckets_.Value() != nullptr) return false;
+    int index = FindSparseSlot(SparseValue(slot_offset));
+    if (index >= 0) sparse_slots_[index].SetValue(kEmptySparseSlot);
+    return true;
+  }
+
+  bool RemoveSparseRange(int start_offset, int end_offset) {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    if (buckets_.Value() != nullptr) return false;
+    for (int i = 0; i < kSparseSlots; i++) {
+      uint32_t value = sparse_slots_[i].Value();
+      if (value == kEmptySparseSlot) continue;
+      int offset = SparseValueToOffset(value);
+      if (start_offset <= offset && offset < end_offset) {
+        sparse_slots_[i].SetValue(kEmptySparseSlot);
+      }
+    }
+    return true;
+  }
+
+  template <typename Callback>
+  bool IterateSparse(Callback callback, int* new_count) {
+    uint32_t values[kSparseSlots];
+    {
+      base::LockGuard<base::Mutex> guard(&mutex_);
+      if (buckets_.Value() != nullptr) return false;
+      for (int i = 0; i < kSparseSlots; i++) {
+        values[i] = sparse_slots_[i].Value();
+      }
+    }
+    // The callback runs without the lock, as it may insert slots into this
+    // set. Remove finds slots that have been moved to the buckets since.
+    *new_count = 0;
+    for (int i = 0; i < kSparseSlots; i++) {
+      if (values[i] == kEmptySparseSlot) continue;
+      int offset = SparseValueToOffset(values[i]);
+      if (callback(page_start_ + offset) == KEEP_SLOT) {
+        ++*new_count;
+      } else {
+        Remove(offset);
+      }
+    }
+    return true;
+  }
+
+  void InsertInBuckets(Bucket* buckets, int slot_offset) {
+    int bucket_index, cell_index, bit_index;
+    SlotToIndices(slot_offset, &bucket_index, &cell_index, &bit_index);
+    base::AtomicValue<uint32_t>* current_bucket = buckets[bucket_index].Value();
+    if (current_bucket == nullptr) {
+      current_bucket = AllocateBucket();
+      if (!buckets[bucket_index].TrySetValue(nullptr, current_bucket)) {
+        DeleteArray<base::AtomicValue<uint32_t>>(current_bucket);
+        current_bucket = buckets[bucket_index].Value();
+      }
+    }
+    if (!(current_bucket[cell_index].Value() & (1u << bit_index))) {
+      current_bucket[cell_index].SetBit(bit_index);
+    }
+  }
+
   base::AtomicValue<uint32_t>* AllocateBucket() {
     base::AtomicValue<uint32_t>* result =
         NewArray<base::AtomicValue<uint32_t>>(kCellsPerBucket);
@@ -261,23 +426,24 @@ class SlotSet : public Malloced {
     }
   }
 
-  void PreFreeEmptyBucket(int bucket_index) {
-    base::AtomicValue<uint32_t>* bucket_ptr = bucket[bucket_index].Value();
+  void PreFreeEmptyBucket(Bucket* buckets, int bucket_index) {
+    base::AtomicValue<uint32_t>* bucket_ptr = buckets[bucket_index].Value();
     if (bucket_ptr != nullptr) {
-      base::LockGuard<base::Mutex> guard(&to_be_freed_buckets_mutex_);
+      base::LockGuard<base::Mutex> guard(&mutex_);
       to_be_freed_buckets_.push(bucket_ptr);
-      bucket[bucket_index].SetValue(nullptr);
+      buckets[bucket_index].SetValue(nullptr);
     }
   }
 
-  void ReleaseBucket(int bucket_index) {
-    DeleteArray<base::AtomicValue<uint32_t>>(bucket[bucket_index].Value());
-    bucket[bucket_index].SetValue(nullptr);
+  void ReleaseBucket(Bucket* buckets, int bucket_index) {
+    DeleteArray<base::AtomicValue<uint32_t>>(buckets[bucket_index].Value());
+    buckets[bucket_index].SetValue(nullptr);
   }
 
-  void ClearCell(int bucket_index, int cell_index, uint32_t mask) {
+  void ClearCell(Bucket* buckets, int bucket_index, int cell_index,
+                 uint32_t mask) {
     if (bucket_index < kBuckets) {
-      base::AtomicValue<uint32_t>* cells = bucket[bucket_index].Value();
+      base::AtomicValue<uint32_t>* cells = buckets[bucket_index].Value();
       if (cells != nullptr) {
         uint32_t cell = cells[cell_index].Value();
         if (cell) cells[cell_index].SetBits(0, mask);
@@ -300,9 +466,13 @@ class SlotSet : public Malloced {
     *bit_index = slot & (kBitsPerCell - 1);
   }
 
-  base::AtomicValue<base::AtomicValue<uint32_t>*> bucket[kBuckets];
+  // The bucket array is only allocated once the inline slots overflow.
+  base::AtomicValue<Bucket*> buckets_;
+  base::AtomicValue<uint32_t> sparse_slots_[kSparseSlots];
   Address page_start_;
-  base::Mutex to_be_freed_buckets_mutex_;
+  // Guards to_be_freed_buckets_, the allocation of buckets_ and all writes
+  // to sparse_slots_.
+  base::Mutex mutex_;
   std::stack<base::AtomicValue<uint32_t>*> to_be_freed_buckets_;
 };
 
@@ -12,6 +12,7 @@
 #include "src/counters.h"
 #include "src/full-codegen/full-codegen.h"
 #include "src/heap/array-buffer-tracker.h"
+#include "src/heap/gc-tracer.h"
 #include "src/heap/incremental-marking.h"
 #include "src/heap/mark-compact.h"
 #include "src/heap/slot-set.h"
@@ -339,7 +340,12 @@ class MemoryAllocator::Unmapper::UnmapFreeMemoryTask : public v8::Task {
  private:
   // v8::Task overrides.
   void Run() override {
-    unmapper_->PerformFreeMemoryOnQueuedChunks<FreeMode::kUncommitPooled>();
+    {
+      GCTracer::BackgroundScope scope(
+          unmapper_->allocator_->isolate_->heap()->tracer(),
+          GCTracer::BackgroundScope::BACKGROUND_UNMAPPER);
+      unmapper_->PerformFreeMemoryOnQueuedChunks<FreeMode::kUncommitPooled>();
+    }
     unmapper_->pending_unmapping_tasks_semaphore_.Signal();
   }
 
@@ -542,6 +548,7 @@ MemoryChunk* MemoryChunk::Initialize(Heap* heap, Address base, size_t size,
   chunk->set_next_chunk(nullptr);
   chunk->set_prev_chunk(nullptr);
   chunk->local_tracker_ = nullptr;
+  chunk->invalidated_slots_ = nullptr;
 
   MarkingState::Internal(chunk).ClearLiveness();
 
@@ -1135,6 +1142,7 @@ void MemoryChunk::ReleaseAllocatedMemory() {
   ReleaseSlotSet<OLD_TO_OLD>();
   ReleaseTypedSlotSet<OLD_TO_NEW>();
   ReleaseTypedSlotSet<OLD_TO_OLD>();
+  ReleaseInvalidatedSlots();
   if (local_tracker_ != nullptr) ReleaseLocalTracker();
   if (young_generation_bitmap_ != nullptr) ReleaseYoungGenerationBitmap();
 }
@@ -1203,6 +1211,30 @@ void MemoryChunk::ReleaseTypedSlotSet() {
   }
 }
 
+InvalidatedSlots* MemoryChunk::AllocateInvalidatedSlots() {
+  DCHECK_NULL(invalidated_slots_);
+  invalidated_slots_ = new InvalidatedSlots();
+  return invalidated_slots_;
+}
+
+void MemoryChunk::ReleaseInvalidatedSlots() {
+  if (invalidated_slots_) {
+    delete invalidated_slots_;
+    invalidated_slots_ = nullptr;
+  }
+}
+
+void MemoryChunk::RegisterObjectWithInvalidatedSlots(HeapObject* object,
+                                                     int size) {
+  if (!ShouldSkipEvacuationSlotRecording()) {
+    if (invalidated_slots() == nullptr) {
+      AllocateInvalidatedSlots();
+    }
+    int old_size = (*invalidated_slots())[object];
+    (*invalidated_slots())[object] = Max(old_size, size);
+  }
+}
+
 void MemoryChunk::AllocateLocalTracker() {
   DCHECK_NULL(local_tracker_);
   local_tracker_ = new LocalArrayBufferTracker(heap());
@@ -3132,19 +3164,8 @@ AllocationResult LargeObjectSpace::AllocateRaw(int object_size,
     return AllocationResult::Retry(identity());
   }
 
-  LargePage* page = heap()->memory_allocator()->AllocateLargePage(
-      object_size, this, executable);
+  LargePage* page = AllocateLargePage(object_size, executable);
   if (page == NULL) return AllocationResult::Retry(identity());
-  DCHECK_GE(page->area_size(), static_cast<size_t>(object_size));
-
-  size_ += static_cast<int>(page->size());
-  AccountCommitted(page->size());
-  objects_size_ += object_size;
-  page_count_++;
-  page->set_next_page(first_page_);
-  first_page_ = page;
-
-  InsertChunkMapEntries(page);
 
   HeapObject* object = page->GetObject();
 
@@ -3171,6 +3192,62 @@ AllocationResult LargeObjectSpace::AllocateRaw(int object_size,
 }
 
 
+LargePage* LargeObjectSpace::AllocateLargePage(int object_size,
+                                               Executability executable) {
+  LargePage* page = heap()->memory_allocator()->AllocateLargePage(
+      object_size, this, executable);
+  if (page == NULL) return NULL;
+  DCHECK_GE(page->area_size(), static_cast<size_t>(object_size));
+  AddPage(page, object_size);
+  return page;
+}
+
+void LargeObjectSpace::AddPage(LargePage* page, size_t object_size) {
+  size_ += static_cast<int>(page->size());
+  AccountCommitted(page->size());
+  objects_size_ += object_size;
+  page_count_++;
+  page->set_next_page(first_page_);
+  first_page_ = page;
+
+  InsertChunkMapEntries(page);
+}
+
+void LargeObjectSpace::RemovePage(LargePage* page, size_t object_size) {
+  LargePage* previous = nullptr;
+  LargePage* current = first_page_;
+  while (current != page) {
+    DCHECK_NOT_NULL(current);
+    previous = current;
+    current = current->next_page();
+  }
+  if (previous == nullptr) {
+    first_page_ = page->next_page();
+  } else {
+    previous->set_next_page(page->next_page());
+  }
+  page->set_next_page(nullptr);
+
+  size_ -= static_cast<int>(page->size());
+  AccountUncommitted(page->size());
+  objects_size_ -= object_size;
+  page_count_--;
+
+  RemoveChunkMapEntries(page);
+}
+
+void LargeObjectSpace::PromoteNewLargeObject(LargePage* page) {
+  DCHECK_EQ(page->owner(), heap()->new_lo_space());
+  DCHECK(page->InNewSpace());
+  size_t object_size = static_cast<size_t>(page->GetObject()->Size());
+  heap()->new_lo_space()->RemovePage(page, object_size);
+  page->ClearFlag(MemoryChunk::IN_FROM_SPACE);
+  page->ClearFlag(MemoryChunk::IN_TO_SPACE);
+  heap()->incremental_marking()->SetOldSpacePageFlags(page);
+  page->set_owner(this);
+  AddPage(page, object_size);
+}
+
 size_t LargeObjectSpace::CommittedPhysicalMemory() {
   // On a platform that provides lazy committing of memory, we over-account
   // the actually committed memory. There is no easy way right now to support
@@ -3312,6 +3389,55 @@ std::unique_ptr<ObjectIterator> LargeObjectSpace::GetObjectIterator() {
   return std::unique_ptr<ObjectIterator>(new LargeObjectIterator(this));
 }
 
+NewLargeObjectSpace::NewLargeObjectSpace(Heap* heap)
+    : LargeObjectSpace(heap, LO_SPACE) {}
+
+AllocationResult NewLargeObjectSpace::AllocateRaw(int object_size) {
+  // Objects in this space are promoted into the old generation large object
+  // space by the next young generation collection, so the old generation has
+  // to be able to hold them. Besides that, the space is limited to the
+  // capacity of the new space to keep scavenges scheduled as usual.
+  if (!heap()->CanExpandOldGeneration(SizeOfObjects() + object_size) ||
+      (!IsEmpty() && SizeOfObjects() + object_size >
+                         heap()->new_space()->Capacity())) {
+    return AllocationResult::Retry(NEW_SPACE);
+  }
+
+  LargePage* page = AllocateLargePage(object_size, NOT_EXECUTABLE);
+  if (page == NULL) return AllocationResult::Retry(NEW_SPACE);
+
+  page->SetFlag(MemoryChunk::IN_TO_SPACE);
+  heap()->incremental_marking()->SetNewSpacePageFlags(page);
+
+  HeapObject* object = page->GetObject();
+  AllocationStep(object->address(), object_size);
+  heap()->CreateFillerObjectAt(object->address(), object_size,
+                               ClearRecordedSlots::kNo);
+  return object;
+}
+
+size_t NewLargeObjectSpace::Available() {
+  size_t capacity = heap()->new_space()->Capacity();
+  return capacity > SizeOfObjects() ? capacity - SizeOfObjects() : 0;
+}
+
+void NewLargeObjectSpace::Flip() {
+  for (LargePage* page = first_page_; page != nullptr;
+       page = page->next_page()) {
+    page->SetFlag(MemoryChunk::IN_FROM_SPACE);
+    page->ClearFlag(MemoryChunk::IN_TO_SPACE);
+  }
+}
+
+void NewLargeObjectSpace::FreeDeadObjects() {
+  while (first_page_ != nullptr) {
+    LargePage* page = first_page_;
+    DCHECK(page->InFromSpace());
+    RemovePage(page, static_cast<size_t>(page->GetObject()->Size()));
+    heap()->memory_allocator()->Free<MemoryAllocator::kPreFreeAndQueue>(page);
+  }
+}
+
 #ifdef VERIFY_HEAP
 // We do not assume that the large object iterator works, because it depends
 // on the invariants we are checking during verification.
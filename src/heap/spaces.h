@@ -18,6 +18,7 @@
 #include "src/flags.h"
 #include "src/globals.h"
 #include "src/heap/heap.h"
+#include "src/heap/invalidated-slots.h"
 #include "src/heap/marking.h"
 #include "src/list.h"
 #include "src/objects.h"
@@ -364,7 +365,8 @@ class MemoryChunk {
       // FreeListCategory categories_[kNumberOfCategories]
       + kPointerSize   // LocalArrayBufferTracker* local_tracker_
       + kIntptrSize    // intptr_t young_generation_live_byte_count_
-      + kPointerSize;  // Bitmap* young_generation_bitmap_
+      + kPointerSize   // Bitmap* young_generation_bitmap_
+      + kPointerSize;  // InvalidatedSlots* invalidated_slots_
 
   // We add some more space to the computed header size to amount for missing
   // alignment requirements in our computation.
@@ -465,6 +467,10 @@ class MemoryChunk {
   TypedSlotSet* AllocateTypedSlotSet();
   template <RememberedSetType type>
   void ReleaseTypedSlotSet();
+  InvalidatedSlots* AllocateInvalidatedSlots();
+  void ReleaseInvalidatedSlots();
+  void RegisterObjectWithInvalidatedSlots(HeapObject* object, int size);
+  InvalidatedSlots* invalidated_slots() { return invalidated_slots_; }
   void AllocateLocalTracker();
   void ReleaseLocalTracker();
   void AllocateYoungGenerationBitmap();
@@ -645,6 +651,11 @@ class MemoryChunk {
   intptr_t young_generation_live_byte_count_;
   Bitmap* young_generation_bitmap_;
 
+  // Objects that underwent an unsafe layout change while slots were being
+  // recorded. Slots inside these objects are filtered against the current
+  // layout before they are updated. See InvalidatedSlotsFilter.
+  InvalidatedSlots* invalidated_slots_;
+
  private:
   void InitializeReservedMemory() { reservation_.Reset(); }
 
@@ -1209,6 +1220,13 @@ class V8_EXPORT_PRIVATE MemoryAllocator {
 
     bool has_delayed_chunks() { return delayed_regular_chunks_.size() > 0; }
 
+    // Returns the number of large and executable chunks that are queued but
+    // not freed yet. Exposed for testing.
+    size_t NumberOfNonRegularChunks() {
+      base::LockGuard<base::Mutex> guard(&mutex_);
+      return chunks_[kNonRegular].size();
+    }
+
    private:
     static const int kReservedQueueingSlots = 64;
 
@@ -2912,6 +2930,11 @@ class LargeObjectSpace : public Space {
   void RemoveChunkMapEntries(LargePage* page);
   void RemoveChunkMapEntries(LargePage* page, Address free_start);
 
+  // Moves a page that survived a young generation collection from the young
+  // generation large object space into this space. The object keeps its
+  // address.
+  void PromoteNewLargeObject(LargePage* page);
+
   // Checks whether a heap object is in this space; O(1).
   bool Contains(HeapObject* obj);
   // Checks whether an address is in the object area in this space. Iterates
@@ -2942,7 +2965,15 @@ class LargeObjectSpace : public Space {
   void ReportStatistics();
 #endif
 
- private:
+ protected:
+  // Allocates a page for an object of the given size and links it into this
+  // space. Returns nullptr if the memory allocator is out of memory.
+  LargePage* AllocateLargePage(int object_size, Executability executable);
+
+  // Links a page into or out of this space and updates the accounting.
+  void AddPage(LargePage* page, size_t object_size);
+  void RemovePage(LargePage* page, size_t object_size);
+
   // The head of the linked list of large object chunks.
   LargePage* first_page_;
   size_t size_;            // allocated bytes
@@ -2957,6 +2988,33 @@ class LargeObjectSpace : public Space {
   friend class LargeObjectIterator;
 };
 
+// Large objects allocated in the young generation with
+// --young-generation-large-objects. Pages of this space are flagged as new
+// space pages, so the write barrier and the young generation collectors treat
+// the objects like any other young object. Instead of being copied, surviving
+// objects are promoted by moving their page to the old generation large object
+// space. The space shares its identity (LO_SPACE) with the old generation large
+// object space and is not part of Heap::space_.
+class NewLargeObjectSpace : public LargeObjectSpace {
+ public:
+  explicit NewLargeObjectSpace(Heap* heap);
+
+  // Returns a retry result for NEW_SPACE once the objects of this space would
+  // exceed the capacity of the new space, so that a scavenge is triggered.
+  MUST_USE_RESULT AllocationResult AllocateRaw(int object_size);
+
+  // Available bytes for objects in this space.
+  size_t Available() override;
+
+  // Moves all pages to from-space. Called at the start of a young generation
+  // collection; pages of surviving objects are promoted afterwards.
+  void Flip();
+
+  // Frees all pages that are still in from-space, i.e., the objects that did
+  // not survive the last collection.
+  void FreeDeadObjects();
+};
+
 
 class LargeObjectIterator : public ObjectIterator {
  public:
@@ -103,10 +103,16 @@ void StoreBuffer::MoveEntriesToRememberedSet(int index) {
   if (!lazy_top_[index]) return;
   DCHECK_GE(index, 0);
   DCHECK_LT(index, kStoreBuffers);
+  // Consecutive entries usually hit the same page. Caching the last page
+  // avoids the large object space lookup in Page::FromAnyPointerAddress for
+  // every slot of a large, heavily written object.
+  Page* page = nullptr;
   for (Address* current = start_[index]; current < lazy_top_[index];
        current++) {
     Address addr = *current;
-    Page* page = Page::FromAnyPointerAddress(heap_, addr);
+    if (page == nullptr || !page->Contains(addr)) {
+      page = Page::FromAnyPointerAddress(heap_, addr);
+    }
     if (IsDeletionAddress(addr)) {
       current++;
       Address end = *current;
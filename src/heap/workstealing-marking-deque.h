@@ -6,9 +6,11 @@
 #define V8_HEAP_WORKSTEALING_MARKING_DEQUE_
 
 #include <cstddef>
+#include <vector>
 
 #include "src/base/logging.h"
 #include "src/base/macros.h"
+#include "src/base/platform/mutex.h"
 
 namespace v8 {
 namespace internal {
@@ -41,6 +43,18 @@ class StackSegment {
   bool IsFull() { return index_ == kNumEntries; }
   void Clear() { index_ = 0; }
 
+  // Replaces each object with the result of the callback. Objects for which
+  // the callback returns nullptr are removed from the segment.
+  template <typename Callback>
+  void Update(Callback callback) {
+    size_t new_index = 0;
+    for (size_t i = 0; i < index_; i++) {
+      HeapObject* object = callback(objects_[i]);
+      if (object != nullptr) objects_[new_index++] = object;
+    }
+    index_ = new_index;
+  }
+
   StackSegment* next() { return next_; }
   StackSegment* prev() { return prev_; }
   void set_next(StackSegment* next) { next_ = next; }
@@ -91,6 +105,19 @@ class SegmentedStack {
 
   bool IsEmpty() { return front_ == back_ && front_->IsEmpty(); }
 
+  // Returns true if the stack contains a segment besides the front segment.
+  // All segments but the front segment are full.
+  bool HasFullSegment() { return front_ != back_; }
+
+  // Detaches and returns the oldest full segment of the stack.
+  StackSegment* TakeFullSegment() {
+    DCHECK(HasFullSegment());
+    StackSegment* segment = Unlink(back_);
+    segment->set_next(nullptr);
+    segment->set_prev(nullptr);
+    return segment;
+  }
+
  private:
   void NewFront() {
     StackSegment* s = new StackSegment(front_, nullptr);
@@ -112,25 +139,57 @@ class SegmentedStack {
   StackSegment* back_;
 };
 
-// TODO(mlippautz): Implement actual work stealing.
+// Work is shared between tasks by publishing full segments: Once a private
+// stack grows beyond its front segment, the oldest full segment is moved to a
+// pool from which tasks with empty private stacks steal.
 class WorkStealingMarkingDeque {
  public:
   static const int kMaxNumTasks = 8;
 
+  ~WorkStealingMarkingDeque() { CHECK(shared_segments_.empty()); }
+
   bool Push(int task_id, HeapObject* object) {
     DCHECK_LT(task_id, kMaxNumTasks);
-    return private_stacks_[task_id].Push(object);
+    SegmentedStack* stack = &private_stacks_[task_id];
+    stack->Push(object);
+    if (stack->HasFullSegment()) {
+      StackSegment* segment = stack->TakeFullSegment();
+      base::LockGuard<base::Mutex> guard(&lock_);
+      shared_segments_.push_back(segment);
+    }
+    return true;
   }
 
   bool Pop(int task_id, HeapObject** object) {
     DCHECK_LT(task_id, kMaxNumTasks);
-    return private_stacks_[task_id].Pop(object);
+    if (private_stacks_[task_id].Pop(object)) return true;
+    return Steal(task_id) && private_stacks_[task_id].Pop(object);
   }
 
   bool IsLocalEmpty(int task_id) { return private_stacks_[task_id].IsEmpty(); }
 
+  // Moves the objects of a published segment to the private stack of
+  // |task_id|. Returns false if there was no segment to steal.
+  bool Steal(int task_id) {
+    DCHECK_LT(task_id, kMaxNumTasks);
+    StackSegment* segment = nullptr;
+    {
+      base::LockGuard<base::Mutex> guard(&lock_);
+      if (shared_segments_.empty()) return false;
+      segment = shared_segments_.back();
+      shared_segments_.pop_back();
+    }
+    SegmentedStack* stack = &private_stacks_[task_id];
+    HeapObject* object = nullptr;
+    while (segment->Pop(&object)) stack->Push(object);
+    delete segment;
+    return true;
+  }
+
  private:
   SegmentedStack private_stacks_[kMaxNumTasks];
+  base::Mutex lock_;
+  std::vector<StackSegment*> shared_segments_;
 };
 
 class LocalWorkStealingMarkingDeque {
@@ -147,14 +206,11 @@ class LocalWorkStealingMarkingDeque {
   // Returns true if the local portion of the marking deque is empty.
   bool IsEmpty() { return deque_->IsLocalEmpty(task_id_); }
 
-  // Blocks if there are no more objects available. Returns execution with
-  // |true| once new objects are available and |false| otherwise.
-  bool WaitForMoreObjects() {
-    // Return false once the local portion of the marking deque is drained.
-    // TODO(mlippautz): Implement a barrier that can be used to synchronize
-    // work stealing and emptiness.
-    return !IsEmpty();
-  }
+  // Returns |true| if the local portion of the marking deque is non-empty or
+  // objects could be stolen from other tasks, and |false| otherwise. Segments
+  // are only published by tasks that have not yet drained their own portion,
+  // so every published segment is processed before the last task returns.
+  bool WaitForMoreObjects() { return !IsEmpty() || deque_->Steal(task_id_); }
 
  private:
   WorkStealingMarkingDeque* deque_;
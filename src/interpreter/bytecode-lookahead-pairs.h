@@ -0,0 +1,38 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_INTERPRETER_BYTECODE_LOOKAHEAD_PAIRS_H_
+#define V8_INTERPRETER_BYTECODE_LOOKAHEAD_PAIRS_H_
+
+// The list of (First, Second) bytecode pairs for which the handler of First
+// looks ahead at the next bytecode and, if it is Second, executes it inline
+// instead of dispatching to its handler. This saves an indirect jump through
+// the dispatch table for the most frequent bytecode sequences.
+//
+// Only pairs from the following families are supported:
+//   - any non-jump bytecode followed by JumpIfTrue or JumpIfFalse,
+//   - Ldar followed by a binary operation with feedback (Add, Sub, ...).
+// Star is not listed here, it is covered by Bytecodes::IsStarLookahead.
+//
+// The list is generated from a dispatch counters file recorded with
+// --trace-ignition-dispatches --trace-ignition-dispatches-output-file=<file>
+// on representative workloads, by running
+//
+//   tools/ignition/bytecode_dispatches_report.py -l -n <count> <file>
+//
+// and replacing the list below with the output.
+#define BYTECODE_LOOKAHEAD_PAIR_LIST(V)  \
+  V(TestLessThan, JumpIfFalse)           \
+  V(TestEqualStrict, JumpIfFalse)        \
+  V(TestGreaterThan, JumpIfFalse)        \
+  V(TestLessThanOrEqual, JumpIfFalse)    \
+  V(TestGreaterThanOrEqual, JumpIfFalse) \
+  V(TestEqual, JumpIfFalse)              \
+  V(TestUndetectable, JumpIfFalse)       \
+  V(TestTypeOf, JumpIfFalse)             \
+  V(Ldar, Add)                           \
+  V(Ldar, Sub)                           \
+  V(Ldar, Mul)
+
+#endif  // V8_INTERPRETER_BYTECODE_LOOKAHEAD_PAIRS_H_
@@ -7,6 +7,7 @@
 #include <iomanip>
 
 #include "src/base/bits.h"
+#include "src/interpreter/bytecode-lookahead-pairs.h"
 #include "src/interpreter/bytecode-traits.h"
 
 namespace v8 {
@@ -170,6 +171,21 @@ bool Bytecodes::MakesCallAlongCriticalPath(Bytecode bytecode) {
     case Bytecode::kCreateBlockContext:
     case Bytecode::kCreateCatchContext:
     case Bytecode::kCreateRegExpLiteral:
+    // The handlers of the following bytecodes unconditionally call an IC or
+    // the runtime. Marking them lets the handler reload the interpreter state
+    // from the frame after the call, instead of spilling it around the call.
+    case Bytecode::kLdaKeyedProperty:
+    case Bytecode::kLdaLookupSlot:
+    case Bytecode::kLdaLookupSlotInsideTypeof:
+    case Bytecode::kStaGlobalSloppy:
+    case Bytecode::kStaGlobalStrict:
+    case Bytecode::kStaNamedPropertySloppy:
+    case Bytecode::kStaNamedPropertyStrict:
+    case Bytecode::kStaNamedOwnProperty:
+    case Bytecode::kStaKeyedPropertySloppy:
+    case Bytecode::kStaKeyedPropertyStrict:
+    case Bytecode::kStaDataPropertyInLiteral:
+    case Bytecode::kToObject:
       return true;
     default:
       return false;
@@ -254,6 +270,17 @@ bool Bytecodes::IsStarLookahead(Bytecode bytecode, OperandScale operand_scale) {
   return false;
 }
 
+// static
+bool Bytecodes::IsLookaheadPair(Bytecode bytecode, Bytecode next) {
+#define LOOKAHEAD_PAIR(First, Second)                                  \
+  if (bytecode == Bytecode::k##First && next == Bytecode::k##Second) { \
+    return true;                                                       \
+  }
+  BYTECODE_LOOKAHEAD_PAIR_LIST(LOOKAHEAD_PAIR)
+#undef LOOKAHEAD_PAIR
+  return false;
+}
+
 // static
 bool Bytecodes::IsBytecodeWithScalableOperands(Bytecode bytecode) {
   for (int i = 0; i < NumberOfOperands(bytecode); i++) {
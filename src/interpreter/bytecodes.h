@@ -811,6 +811,11 @@ class V8_EXPORT_PRIVATE Bytecodes final {
   // dispatch to a Star bytecode.
   static bool IsStarLookahead(Bytecode bytecode, OperandScale operand_scale);
 
+  // Returns true if the handler for |bytecode| should look ahead and execute
+  // |next| inline when it immediately follows, see
+  // BYTECODE_LOOKAHEAD_PAIR_LIST.
+  static bool IsLookaheadPair(Bytecode bytecode, Bytecode next);
+
   // Returns the number of registers represented by a register operand. For
   // instance, a RegPair represents two registers. Should not be called for
   // kRegList which has a variable number of registers based on the following
@@ -10,6 +10,7 @@
 #include "src/code-factory.h"
 #include "src/frames.h"
 #include "src/interface-descriptors.h"
+#include "src/interpreter/bytecode-lookahead-pairs.h"
 #include "src/interpreter/bytecodes.h"
 #include "src/interpreter/interpreter.h"
 #include "src/machine-type.h"
@@ -1102,7 +1103,73 @@ void InterpreterAssembler::InlineStar() {
   accumulator_use_ = previous_acc_use;
 }
 
+void InterpreterAssembler::InlineLookahead(
+    Node* target_bytecode, Bytecode next,
+    const LookaheadGenerator& generate_next) {
+  DCHECK(Bytecodes::IsLookaheadPair(bytecode_, next));
+  Label do_inline(this), done(this);
+
+  Node* next_bytecode = IntPtrConstant(static_cast<int>(next));
+  Branch(WordEqual(target_bytecode, next_bytecode), &do_inline, &done);
+
+  BIND(&do_inline);
+  {
+    // Count the dispatch to the inlined bytecode, as DispatchToBytecode would
+    // have done; the source of the dispatch is still the current bytecode.
+    if (FLAG_trace_ignition_dispatches) {
+      TraceBytecodeDispatch(next_bytecode);
+    }
+
+    Bytecode previous_bytecode = bytecode_;
+    AccumulatorUse previous_acc_use = accumulator_use_;
+    bool previous_made_call = made_call_;
+    bool previous_reloaded_frame_ptr = reloaded_frame_ptr_;
+    bool previous_saved_bytecode_offset = saved_bytecode_offset_;
+
+    bytecode_ = next;
+    accumulator_use_ = AccumulatorUse::kNone;
+    // Calls made by the inlined bytecode have to save its own offset.
+    saved_bytecode_offset_ = false;
+
+#ifdef V8_TRACE_IGNITION
+    TraceBytecode(Runtime::kInterpreterTraceBytecodeEntry);
+#endif
+    if (next == Bytecode::kJumpIfTrue || next == Bytecode::kJumpIfFalse) {
+      InlineJumpIfBoolean(next == Bytecode::kJumpIfTrue);
+    } else {
+      // The handler of the current bytecode has to know how to generate
+      // |next|, otherwise the pair must not be listed.
+      CHECK(generate_next);
+      generate_next(next);
+    }
+
+    DCHECK_EQ(accumulator_use_, Bytecodes::GetAccumulatorUse(bytecode_));
+
+    // The inlined code ended in a dispatch, so the state of the code that
+    // follows is that of the current bytecode before the branch.
+    bytecode_ = previous_bytecode;
+    accumulator_use_ = previous_acc_use;
+    made_call_ = previous_made_call;
+    reloaded_frame_ptr_ = previous_reloaded_frame_ptr;
+    saved_bytecode_offset_ = previous_saved_bytecode_offset;
+  }
+  BIND(&done);
+}
+
+void InterpreterAssembler::InlineJumpIfBoolean(bool value) {
+  Node* accumulator = GetAccumulator();
+  Node* relative_jump = BytecodeOperandUImmWord(0);
+  CSA_ASSERT(this, TaggedIsNotSmi(accumulator));
+  CSA_ASSERT(this, IsBoolean(accumulator));
+  JumpIfWordEqual(accumulator, BooleanConstant(value), relative_jump);
+}
+
 Node* InterpreterAssembler::Dispatch() {
+  return DispatchWithLookahead(LookaheadGenerator());
+}
+
+Node* InterpreterAssembler::DispatchWithLookahead(
+    const LookaheadGenerator& generate_next) {
   Comment("========= Dispatch");
   DCHECK_IMPLIES(Bytecodes::MakesCallAlongCriticalPath(bytecode_), made_call_);
   Node* target_offset = Advance();
@@ -1111,6 +1178,19 @@ Node* InterpreterAssembler::Dispatch() {
   if (Bytecodes::IsStarLookahead(bytecode_, operand_scale_)) {
     target_bytecode = StarDispatchLookahead(target_bytecode);
   }
+
+  // The inlined bytecode reads its operands with the operand scale of the
+  // current one, so only look ahead from unprefixed bytecodes. Jumps never
+  // look ahead, which also stops an inlined jump from inlining further.
+  if (operand_scale_ == OperandScale::kSingle &&
+      !Bytecodes::IsJump(bytecode_)) {
+#define LOOKAHEAD_PAIR(First, Second)                                     \
+  if (bytecode_ == Bytecode::k##First) {                                  \
+    InlineLookahead(target_bytecode, Bytecode::k##Second, generate_next); \
+  }
+    BYTECODE_LOOKAHEAD_PAIR_LIST(LOOKAHEAD_PAIR)
+#undef LOOKAHEAD_PAIR
+  }
   return DispatchToBytecode(target_bytecode, BytecodeOffset());
 }
 
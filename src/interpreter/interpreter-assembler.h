@@ -5,6 +5,8 @@
 #ifndef V8_INTERPRETER_INTERPRETER_ASSEMBLER_H_
 #define V8_INTERPRETER_INTERPRETER_ASSEMBLER_H_
 
+#include <functional>
+
 #include "src/allocation.h"
 #include "src/builtins/builtins.h"
 #include "src/code-stub-assembler.h"
@@ -231,6 +233,16 @@ class V8_EXPORT_PRIVATE InterpreterAssembler : public CodeStubAssembler {
   compiler::Node* BytecodeOffset();
 
  protected:
+  typedef std::function<void(Bytecode next)> LookaheadGenerator;
+
+  // Dispatch to the next bytecode like Dispatch(), but first look ahead and
+  // execute the next bytecode inline if it is paired with the current one in
+  // BYTECODE_LOOKAHEAD_PAIR_LIST. JumpIfTrue and JumpIfFalse are generated by
+  // the assembler itself, all other bytecodes by |generate_next|, which has to
+  // end in a dispatch.
+  compiler::Node* DispatchWithLookahead(
+      const LookaheadGenerator& generate_next);
+
   Bytecode bytecode() const { return bytecode_; }
   static bool TargetSupportsUnalignedAccess();
 
@@ -328,6 +340,15 @@ class V8_EXPORT_PRIVATE InterpreterAssembler : public CodeStubAssembler {
   // next dispatch offset.
   void InlineStar();
 
+  // Look ahead for |next| and, if |target_bytecode| is |next|, build code for
+  // it at the current BytecodeOffset() in a branch that ends in a dispatch.
+  void InlineLookahead(compiler::Node* target_bytecode, Bytecode next,
+                       const LookaheadGenerator& generate_next);
+
+  // Build code for JumpIfTrue (if |value| is true) or JumpIfFalse at the
+  // current BytecodeOffset().
+  void InlineJumpIfBoolean(bool value);
+
   // Dispatch to |target_bytecode| at |new_bytecode_offset|.
   // |target_bytecode| should be equivalent to loading from the offset.
   compiler::Node* DispatchToBytecode(compiler::Node* target_bytecode,
@@ -122,14 +122,69 @@ IGNITION_HANDLER(LdaFalse, InterpreterAssembler) {
   Dispatch();
 }
 
+class InterpreterBinaryOpAssembler : public InterpreterAssembler {
+ public:
+  InterpreterBinaryOpAssembler(CodeAssemblerState* state, Bytecode bytecode,
+                               OperandScale operand_scale)
+      : InterpreterAssembler(state, bytecode, operand_scale) {}
+
+  typedef Node* (BinaryOpAssembler::*BinaryOpGenerator)(Node* context,
+                                                        Node* left, Node* right,
+                                                        Node* slot,
+                                                        Node* vector);
+
+  void BinaryOpWithFeedback(BinaryOpGenerator generator) {
+    Node* reg_index = BytecodeOperandReg(0);
+    Node* lhs = LoadRegister(reg_index);
+    Node* rhs = GetAccumulator();
+    Node* context = GetContext();
+    Node* slot_index = BytecodeOperandIdx(1);
+    Node* feedback_vector = LoadFeedbackVector();
+
+    BinaryOpAssembler binop_asm(state());
+    Node* result =
+        (binop_asm.*generator)(context, lhs, rhs, slot_index, feedback_vector);
+    SetAccumulator(result);
+    Dispatch();
+  }
+
+  // Dispatch to the next bytecode, executing it inline if it is a binary
+  // operation which BYTECODE_LOOKAHEAD_PAIR_LIST pairs with the current one.
+  void BinaryOpDispatchLookahead() {
+    DispatchWithLookahead([this](Bytecode next) {
+      BinaryOpWithFeedback(BinaryOpGeneratorFor(next));
+    });
+  }
+
+ private:
+  static BinaryOpGenerator BinaryOpGeneratorFor(Bytecode bytecode) {
+    switch (bytecode) {
+      case Bytecode::kAdd:
+        return &BinaryOpAssembler::Generate_AddWithFeedback;
+      case Bytecode::kSub:
+        return &BinaryOpAssembler::Generate_SubtractWithFeedback;
+      case Bytecode::kMul:
+        return &BinaryOpAssembler::Generate_MultiplyWithFeedback;
+      case Bytecode::kDiv:
+        return &BinaryOpAssembler::Generate_DivideWithFeedback;
+      case Bytecode::kMod:
+        return &BinaryOpAssembler::Generate_ModulusWithFeedback;
+      default:
+        UNREACHABLE();
+        return nullptr;
+    }
+  }
+};
+
 // Ldar <src>
 //
 // Load accumulator with value from register <src>.
-IGNITION_HANDLER(Ldar, InterpreterAssembler) {
+IGNITION_HANDLER(Ldar, InterpreterBinaryOpAssembler) {
   Node* reg_index = BytecodeOperandReg(0);
   Node* value = LoadRegister(reg_index);
   SetAccumulator(value);
-  Dispatch();
+  // Ldar is mostly followed by a binary operation on the loaded value.
+  BinaryOpDispatchLookahead();
 }
 
 // Star <dst>
@@ -824,33 +879,6 @@ IGNITION_HANDLER(PopContext, InterpreterAssembler) {
   Dispatch();
 }
 
-class InterpreterBinaryOpAssembler : public InterpreterAssembler {
- public:
-  InterpreterBinaryOpAssembler(CodeAssemblerState* state, Bytecode bytecode,
-                               OperandScale operand_scale)
-      : InterpreterAssembler(state, bytecode, operand_scale) {}
-
-  typedef Node* (BinaryOpAssembler::*BinaryOpGenerator)(Node* context,
-                                                        Node* left, Node* right,
-                                                        Node* slot,
-                                                        Node* vector);
-
-  void BinaryOpWithFeedback(BinaryOpGenerator generator) {
-    Node* reg_index = BytecodeOperandReg(0);
-    Node* lhs = LoadRegister(reg_index);
-    Node* rhs = GetAccumulator();
-    Node* context = GetContext();
-    Node* slot_index = BytecodeOperandIdx(1);
-    Node* feedback_vector = LoadFeedbackVector();
-
-    BinaryOpAssembler binop_asm(state());
-    Node* result =
-        (binop_asm.*generator)(context, lhs, rhs, slot_index, feedback_vector);
-    SetAccumulator(result);
-    Dispatch();
-  }
-};
-
 // Add <src>
 //
 // Add register <src> to accumulator.
@@ -1247,7 +1247,8 @@ Handle<TemplateList> TemplateList::Add(Isolate* isolate,
 // static
 MaybeHandle<JSObject> JSObject::New(Handle<JSFunction> constructor,
                                     Handle<JSReceiver> new_target,
-                                    Handle<AllocationSite> site) {
+                                    Handle<AllocationSite> site,
+                                    PretenureFlag pretenure) {
   // If called through new, new.target can be:
   // - a subclass of constructor,
   // - a proxy wrapper around constructor, or
@@ -1264,7 +1265,7 @@ MaybeHandle<JSObject> JSObject::New(Handle<JSFunction> constructor,
       isolate, initial_map,
       JSFunction::GetDerivedMap(isolate, constructor, new_target), JSObject);
   Handle<JSObject> result =
-      isolate->factory()->NewJSObjectFromMap(initial_map, NOT_TENURED, site);
+      isolate->factory()->NewJSObjectFromMap(initial_map, pretenure, site);
   if (initial_map->is_dictionary_map()) {
     Handle<NameDictionary> dictionary =
         NameDictionary::New(isolate, NameDictionary::kInitialCapacity);
@@ -2123,7 +2123,8 @@ class JSObject: public JSReceiver {
 
   static MUST_USE_RESULT MaybeHandle<JSObject> New(
       Handle<JSFunction> constructor, Handle<JSReceiver> new_target,
-      Handle<AllocationSite> site = Handle<AllocationSite>::null());
+      Handle<AllocationSite> site = Handle<AllocationSite>::null(),
+      PretenureFlag pretenure = NOT_TENURED);
 
   // Gets global object properties.
   inline GlobalDictionary* global_dictionary();
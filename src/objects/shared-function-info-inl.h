@@ -87,6 +87,8 @@ BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints, marked_for_tier_up,
                kMarkedForTierUp)
 BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints,
                has_concurrent_optimization_job, kHasConcurrentOptimizationJob)
+BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints, has_optimization_hint,
+               kHasOptimizationHint)
 
 BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints, needs_home_object,
                kNeedsHomeObject)
@@ -333,6 +335,9 @@ void SharedFunctionInfo::set_deopt_count(int deopt_count) {
 }
 
 void SharedFunctionInfo::increment_deopt_count() {
+  // The assumptions the optimized code was based on no longer hold, so don't
+  // let a code cache suggest optimizing this function early again.
+  set_has_optimization_hint(false);
   int value = counters();
   int deopt_count = DeoptCountBits::decode(value);
   // Saturate the deopt count when incrementing, rather than overflowing.
@@ -323,6 +323,12 @@ class SharedFunctionInfo : public HeapObject {
   // Whether this function has a concurrent compilation job running.
   DECL_BOOLEAN_ACCESSORS(has_concurrent_optimization_job)
 
+  // Whether this function was optimized and did not deoptimize since. The hint
+  // is persisted in code caches created after execution, and tells the runtime
+  // profiler to optimize the function as soon as its feedback is stable again
+  // (see --cache-optimization-hints).
+  DECL_BOOLEAN_ACCESSORS(has_optimization_hint)
+
   // Indicates that asm->wasm conversion failed and should not be re-attempted.
   DECL_BOOLEAN_ACCESSORS(is_asm_wasm_broken)
 
@@ -528,9 +534,9 @@ class SharedFunctionInfo : public HeapObject {
     kIsDeclaration,
     kIsAsmWasmBroken,
     kHasConcurrentOptimizationJob,
+    kHasOptimizationHint,
 
-    kUnused1,  // Unused fields.
-    kUnused2,
+    kUnused2,  // Unused field.
 
     // byte 2
     kFunctionKind,
@@ -0,0 +1,461 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/parsing/parallel-preparser.h"
+
+#include <algorithm>
+
+#include "src/ast/ast-value-factory.h"
+#include "src/ast/scopes.h"
+#include "src/cancelable-task.h"
+#include "src/isolate.h"
+#include "src/objects-inl.h"
+#include "src/parsing/parser.h"
+#include "src/parsing/preparser.h"
+#include "src/parsing/scanner-character-streams.h"
+#include "src/parsing/scanner.h"
+#include "src/unicode-cache.h"
+#include "src/utils.h"
+#include "src/v8.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+// The quick scan behind ParallelPreParser::FindTopLevelFunctions. It does not
+// tokenize the source, it only skips over the constructs that may contain
+// unbalanced braces or a 'function' that is not a keyword.
+template <typename Char>
+class TopLevelFunctionScanner {
+ public:
+  explicit TopLevelFunctionScanner(Vector<const Char> source)
+      : source_(source) {}
+
+  bool Scan(std::vector<int>* positions) {
+    bool use_strict = StartsWithUseStrict();
+    // The open braces, innermost last. True for template substitutions.
+    std::vector<bool> braces;
+    // Whether a '/' at this point starts a regular expression rather than
+    // being a division.
+    bool regexp_allowed = true;
+    bool after_async = false;
+    int previous = '\0';
+    int pos = 0;
+    while (pos < length()) {
+      int c = At(pos);
+      if (IsWhiteSpace(c)) {
+        pos++;
+        continue;
+      }
+      if (c == '/' && (At(pos + 1) == '/' || At(pos + 1) == '*')) {
+        pos = SkipComment(pos);
+        continue;
+      }
+      if (c == '<' && At(pos + 1) == '!' && At(pos + 2) == '-' &&
+          At(pos + 3) == '-') {
+        pos = SkipLineComment(pos);
+        continue;
+      }
+      bool is_async = false;
+      if (c == '/' && regexp_allowed) {
+        pos = SkipRegExp(pos);
+        regexp_allowed = false;
+      } else if (c == '\'' || c == '"') {
+        pos = SkipString(pos);
+        regexp_allowed = false;
+      } else if (c == '`') {
+        bool substitution;
+        pos = SkipTemplateSpan(pos + 1, &substitution);
+        if (substitution) braces.push_back(true);
+        regexp_allowed = substitution;
+      } else if (c == '{') {
+        braces.push_back(false);
+        pos++;
+        regexp_allowed = true;
+      } else if (c == '}') {
+        pos++;
+        regexp_allowed = true;
+        if (!braces.empty()) {
+          bool closes_substitution = braces.back();
+          braces.pop_back();
+          if (closes_substitution) {
+            bool substitution;
+            pos = SkipTemplateSpan(pos, &substitution);
+            if (substitution) braces.push_back(true);
+            regexp_allowed = substitution;
+          }
+        }
+      } else if (IsIdentifierPart(c)) {
+        int start = pos;
+        while (pos < length() && IsIdentifierPart(At(pos))) pos++;
+        if (WordIs(start, pos, "function")) {
+          // Functions inside braces are (most likely) inner functions, async
+          // functions and generators cannot be preparsed as plain functions,
+          // and functions after '(' are eagerly compiled.
+          if (braces.empty() && !after_async && previous != '.' &&
+              previous != '(') {
+            int parameters = FindParameterList(pos);
+            if (parameters >= 0) positions->push_back(parameters);
+          }
+          regexp_allowed = false;
+        } else {
+          is_async = WordIs(start, pos, "async");
+          regexp_allowed = IsDecimalDigit(c) ? false : IsKeywordBeforeRegExp(
+                                                           start, pos);
+        }
+        c = 'a';
+      } else {
+        pos++;
+        regexp_allowed = c != ')' && c != ']';
+      }
+      after_async = is_async;
+      previous = c;
+    }
+    return use_strict;
+  }
+
+ private:
+  int length() const { return source_.length(); }
+
+  // Returns the character at |pos|, or '\0' past the end of the source.
+  int At(int pos) const {
+    return pos < length() ? static_cast<int>(source_[pos]) : '\0';
+  }
+
+  static bool IsWhiteSpace(int c) {
+    return c == ' ' || c == '\t' || c == '\v' || c == '\f' ||
+           IsLineTerminator(c) || c == 0xA0 || c == 0xFEFF;
+  }
+
+  static bool IsLineTerminator(int c) {
+    return c == '\n' || c == '\r' || c == 0x2028 || c == 0x2029;
+  }
+
+  static bool IsIdentifierPart(int c) {
+    return IsAlphaNumeric(c) || c == '_' || c == '$' || c == '\\' ||
+           (c >= 0x80 && !IsWhiteSpace(c));
+  }
+
+  bool WordIs(int start, int end, const char* word) const {
+    for (int i = start; i < end; i++, word++) {
+      if (*word == '\0' || At(i) != *word) return false;
+    }
+    return *word == '\0';
+  }
+
+  // Keywords after which a '/' starts a regular expression.
+  bool IsKeywordBeforeRegExp(int start, int end) const {
+    static const char* const kKeywords[] = {
+        "return", "typeof", "instanceof", "in",   "of",    "new",  "delete",
+        "void",   "throw",  "case",       "do",   "else",  "yield", "await"};
+    for (const char* keyword : kKeywords) {
+      if (WordIs(start, end, keyword)) return true;
+    }
+    return false;
+  }
+
+  int SkipLineComment(int pos) const {
+    while (pos < length() && !IsLineTerminator(At(pos))) pos++;
+    return pos;
+  }
+
+  // Skips the '//' or '/*' comment at |pos|.
+  int SkipComment(int pos) const {
+    if (At(pos + 1) == '/') return SkipLineComment(pos);
+    pos += 2;
+    while (pos < length() && !(At(pos) == '*' && At(pos + 1) == '/')) pos++;
+    return Min(pos + 2, length());
+  }
+
+  int SkipWhiteSpaceAndComments(int pos) const {
+    while (pos < length()) {
+      if (IsWhiteSpace(At(pos))) {
+        pos++;
+      } else if (At(pos) == '/' && (At(pos + 1) == '/' || At(pos + 1) == '*')) {
+        pos = SkipComment(pos);
+      } else {
+        break;
+      }
+    }
+    return pos;
+  }
+
+  // Skips the string literal starting with the quote at |pos|.
+  int SkipString(int pos) const {
+    int quote = At(pos++);
+    while (pos < length()) {
+      int c = At(pos);
+      if (c == '\\') {
+        pos += 2;
+      } else if (c == quote) {
+        return pos + 1;
+      } else if (c == '\n' || c == '\r') {
+        break;
+      } else {
+        pos++;
+      }
+    }
+    return Min(pos, length());
+  }
+
+  // Skips the characters of a template literal from |pos| up to and including
+  // the closing '`' or the '${' of the next substitution.
+  int SkipTemplateSpan(int pos, bool* substitution) const {
+    *substitution = false;
+    while (pos < length()) {
+      int c = At(pos);
+      if (c == '\\') {
+        pos += 2;
+      } else if (c == '`') {
+        return pos + 1;
+      } else if (c == '$' && At(pos + 1) == '{') {
+        *substitution = true;
+        return pos + 2;
+      } else {
+        pos++;
+      }
+    }
+    return length();
+  }
+
+  // Skips the regular expression literal starting with the '/' at |pos|,
+  // except for its flags.
+  int SkipRegExp(int pos) const {
+    bool in_class = false;
+    pos++;
+    while (pos < length()) {
+      int c = At(pos);
+      if (c == '\\') {
+        pos += 2;
+      } else if (IsLineTerminator(c)) {
+        break;
+      } else if (c == '/' && !in_class) {
+        return pos + 1;
+      } else {
+        if (c == '[') in_class = true;
+        if (c == ']') in_class = false;
+        pos++;
+      }
+    }
+    return Min(pos, length());
+  }
+
+  // Returns the position of the '(' after 'function' and an optional name,
+  // or -1 if there is none.
+  int FindParameterList(int pos) const {
+    pos = SkipWhiteSpaceAndComments(pos);
+    if (pos < length() && IsIdentifierPart(At(pos)) &&
+        !IsDecimalDigit(At(pos))) {
+      while (pos < length() && IsIdentifierPart(At(pos))) pos++;
+      pos = SkipWhiteSpaceAndComments(pos);
+    }
+    return At(pos) == '(' ? pos : -1;
+  }
+
+  bool StartsWithUseStrict() const {
+    int pos = SkipWhiteSpaceAndComments(0);
+    int quote = At(pos);
+    if (quote != '\'' && quote != '"') return false;
+    int end = pos + 1 + StrLength("use strict");
+    return WordIs(pos + 1, end, "use strict") && At(end) == quote;
+  }
+
+  Vector<const Char> source_;
+};
+
+}  // namespace
+
+class ParallelPreParser::PreParseTask : public CancelableTask {
+ public:
+  PreParseTask(Isolate* isolate, ParallelPreParser* preparser,
+               Utf16CharacterStream* stream)
+      : CancelableTask(isolate), preparser_(preparser), stream_(stream) {}
+
+  void RunInternal() override {
+    preparser_->RunTask(stream_);
+    preparser_->pending_tasks_.Signal();
+  }
+
+ private:
+  ParallelPreParser* preparser_;
+  Utf16CharacterStream* stream_;
+
+  DISALLOW_COPY_AND_ASSIGN(PreParseTask);
+};
+
+ParallelPreParser::ParallelPreParser(Isolate* isolate, Parser* parser,
+                                     Handle<String> source,
+                                     LanguageMode language_mode)
+    : isolate_(isolate),
+      parser_(parser),
+      source_(source),
+      language_mode_(language_mode),
+      allocator_(isolate->allocator()),
+      ast_string_constants_(isolate->ast_string_constants()),
+      hash_seed_(isolate->heap()->HashSeed()),
+      candidate_count_(0),
+      abort_(false),
+      pending_tasks_(0) {}
+
+ParallelPreParser::~ParallelPreParser() {
+  abort_.SetValue(true);
+  for (uint32_t id : task_ids_) {
+    // If the task has not started yet, then we abort it. Otherwise we wait
+    // for it to finish.
+    if (isolate_->cancelable_task_manager()->TryAbort(id) !=
+        CancelableTaskManager::kTaskAborted) {
+      pending_tasks_.Wait();
+    }
+  }
+}
+
+bool ParallelPreParser::FindTopLevelFunctions(Vector<const uint8_t> source,
+                                              std::vector<int>* positions) {
+  return TopLevelFunctionScanner<uint8_t>(source).Scan(positions);
+}
+
+bool ParallelPreParser::FindTopLevelFunctions(Vector<const uc16> source,
+                                              std::vector<int>* positions) {
+  return TopLevelFunctionScanner<uc16>(source).Scan(positions);
+}
+
+void ParallelPreParser::Start() {
+  DCHECK(task_ids_.empty());
+  std::vector<int> positions;
+  bool use_strict;
+  {
+    DisallowHeapAllocation no_gc;
+    String::FlatContent content = source_->GetFlatContent();
+    DCHECK(content.IsFlat());
+    if (content.IsOneByte()) {
+      Vector<const uint8_t> chars = content.ToOneByteVector();
+      use_strict = FindTopLevelFunctions(chars, &positions);
+      if (!positions.empty()) {
+        one_byte_source_.reset(new uint8_t[chars.length()]);
+        CopyChars(one_byte_source_.get(), chars.start(), chars.length());
+      }
+    } else {
+      Vector<const uc16> chars = content.ToUC16Vector();
+      use_strict = FindTopLevelFunctions(chars, &positions);
+      if (!positions.empty()) {
+        two_byte_source_.reset(new uc16[chars.length()]);
+        CopyChars(two_byte_source_.get(), chars.start(), chars.length());
+      }
+    }
+  }
+  if (use_strict) language_mode_ = STRICT;
+  if (positions.empty()) return;
+
+  candidate_count_ = static_cast<int>(positions.size());
+  candidates_.reset(new Candidate[candidate_count_]);
+  for (int i = 0; i < candidate_count_; i++) {
+    candidates_[i].start = positions[i];
+  }
+
+  if (FLAG_parallel_preparse_on_main_thread) {
+    std::unique_ptr<Utf16CharacterStream> stream(NewStream());
+    RunTask(stream.get());
+    return;
+  }
+
+  size_t num_tasks =
+      Min(static_cast<size_t>(candidate_count_),
+          V8::GetCurrentPlatform()->NumberOfAvailableBackgroundThreads());
+  for (size_t i = 0; i < num_tasks; i++) {
+    streams_.emplace_back(NewStream());
+    PreParseTask* task =
+        new PreParseTask(isolate_, this, streams_.back().get());
+    task_ids_.push_back(task->id());
+    V8::GetCurrentPlatform()->CallOnBackgroundThread(
+        task, v8::Platform::kLongRunningTask);
+  }
+}
+
+Utf16CharacterStream* ParallelPreParser::NewStream() {
+  size_t length = static_cast<size_t>(source_->length());
+  if (one_byte_source_) {
+    return ScannerStream::For(one_byte_source_.get(), length);
+  }
+  return ScannerStream::For(two_byte_source_.get(), length);
+}
+
+PreParseData::FunctionData ParallelPreParser::GetFunctionData(
+    int start, LanguageMode outer_language_mode) {
+  Candidate* end = candidates_.get() + candidate_count_;
+  Candidate* candidate = std::lower_bound(
+      candidates_.get(), end, start,
+      [](const Candidate& c, int start) { return c.start < start; });
+  if (candidate == end || candidate->start != start) {
+    return PreParseData::FunctionData();
+  }
+  // Keep the background tasks from starting on a function the parser is
+  // about to preparse itself.
+  if (candidate->state.TrySetValue(kPending, kSkipped)) {
+    return PreParseData::FunctionData();
+  }
+  if (candidate->state.Value() != kDone ||
+      outer_language_mode != language_mode_) {
+    return PreParseData::FunctionData();
+  }
+  return candidate->data;
+}
+
+void ParallelPreParser::RunTask(Utf16CharacterStream* stream) {
+  DisallowHeapAllocation no_allocation;
+  DisallowHandleAllocation no_handles;
+  DisallowHandleDereference no_deref;
+
+  uintptr_t stack_limit = GetCurrentStackPosition() - FLAG_stack_size * KB;
+  UnicodeCache unicode_cache;
+  while (!abort_.Value()) {
+    int index = next_candidate_.Increment(1) - 1;
+    if (index >= candidate_count_) break;
+    Candidate* candidate = &candidates_[index];
+    if (!candidate->state.TrySetValue(kPending, kRunning)) continue;
+    candidate->data = PreParseFunction(&unicode_cache, stream,
+                                       candidate->start, stack_limit);
+    candidate->state.SetValue(kDone);
+  }
+}
+
+PreParseData::FunctionData ParallelPreParser::PreParseFunction(
+    UnicodeCache* unicode_cache, Utf16CharacterStream* stream, int start,
+    uintptr_t stack_limit) {
+  Zone zone(allocator_, ZONE_NAME);
+  AstValueFactory ast_value_factory(&zone, ast_string_constants_, hash_seed_);
+  PendingCompilationErrorHandler pending_error_handler;
+  Scanner scanner(unicode_cache);
+  PreParser preparser(&zone, &scanner, stack_limit, &ast_value_factory,
+                      &pending_error_handler, nullptr, nullptr, false);
+  parser_->SetPreParserFlags(&preparser);
+
+  stream->Seek(start);
+  scanner.Initialize(stream, false);
+  if (scanner.Next() != Token::LPAREN) return PreParseData::FunctionData();
+
+  DeclarationScope* script_scope =
+      new (&zone) DeclarationScope(&zone, &ast_value_factory);
+  script_scope->SetLanguageMode(language_mode_);
+  DeclarationScope* function_scope = new (&zone)
+      DeclarationScope(&zone, script_scope, FUNCTION_SCOPE, kNormalFunction);
+  function_scope->SetLanguageMode(language_mode_);
+  function_scope->set_start_position(start);
+
+  // Use counts are not reported for functions preparsed in the background.
+  int use_counts[v8::Isolate::kUseCounterFeatureCount] = {0};
+  PreParser::PreParseResult result = preparser.PreParseFunction(
+      kNormalFunction, function_scope, false, false, true, use_counts);
+  if (result != PreParser::kPreParseSuccess ||
+      pending_error_handler.has_pending_error()) {
+    return PreParseData::FunctionData();
+  }
+  PreParserLogger* logger = preparser.logger();
+  return PreParseData::FunctionData(
+      logger->end(), logger->num_parameters(), logger->num_inner_functions(),
+      function_scope->language_mode(), function_scope->uses_super_property());
+}
+
+}  // namespace internal
+}  // namespace v8
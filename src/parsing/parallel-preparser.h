@@ -0,0 +1,122 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_PARSING_PARALLEL_PREPARSER_H_
+#define V8_PARSING_PARALLEL_PREPARSER_H_
+
+#include <memory>
+#include <vector>
+
+#include "src/base/atomic-utils.h"
+#include "src/base/macros.h"
+#include "src/base/platform/semaphore.h"
+#include "src/globals.h"
+#include "src/handles.h"
+#include "src/parsing/preparse-data.h"
+#include "src/vector.h"
+
+namespace v8 {
+namespace internal {
+
+class AccountingAllocator;
+class AstStringConstants;
+class Isolate;
+class Parser;
+class String;
+class UnicodeCache;
+class Utf16CharacterStream;
+
+// Preparses the top-level functions of a large script on background threads
+// while the main thread parses the script.
+//
+// The function boundaries are found by a quick scan of the source that only
+// keeps track of brackets, comments, string, template and regular expression
+// literals. It can be fooled by unusual input, so its results are only hints:
+// a background result is used for a function only if the parser reaches a
+// plain function whose parameter list starts at the same position, outside of
+// any other function and in the language mode the background preparse
+// assumed. Everything else is preparsed by the parser itself, as is every
+// function whose background preparse has not finished yet.
+class V8_EXPORT_PRIVATE ParallelPreParser {
+ public:
+  // |source| must be flat. Its characters are copied off the heap by Start(),
+  // so that background threads can read them.
+  ParallelPreParser(Isolate* isolate, Parser* parser, Handle<String> source,
+                    LanguageMode language_mode);
+
+  // Cancels the background tasks that have not started yet and waits for the
+  // others to finish.
+  ~ParallelPreParser();
+
+  // Finds the top-level functions of the script and posts background tasks
+  // that preparse them. With --parallel-preparse-on-main-thread, the functions
+  // are preparsed right away instead.
+  void Start();
+
+  // Returns the result of the background preparse of the function whose
+  // parameter list starts at |start|, if it is available and was computed for
+  // a function in |outer_language_mode|. Otherwise returns invalid data, and
+  // the background tasks will not start preparsing the function anymore.
+  PreParseData::FunctionData GetFunctionData(int start,
+                                             LanguageMode outer_language_mode);
+
+  // Appends the positions of the parameter lists of plain functions that are
+  // not nested in any brackets to |positions|. Returns true if the script
+  // starts with a "use strict" directive. Exposed for testing.
+  static bool FindTopLevelFunctions(Vector<const uint8_t> source,
+                                    std::vector<int>* positions);
+  static bool FindTopLevelFunctions(Vector<const uc16> source,
+                                    std::vector<int>* positions);
+
+ private:
+  class PreParseTask;
+
+  enum State { kPending, kRunning, kDone, kSkipped };
+
+  struct Candidate {
+    int start;
+    base::AtomicValue<State> state;
+    PreParseData::FunctionData data;
+  };
+
+  // Returns a new stream over the copy of the source.
+  Utf16CharacterStream* NewStream();
+
+  // Preparses candidates until there are none left or the work is aborted.
+  void RunTask(Utf16CharacterStream* stream);
+  PreParseData::FunctionData PreParseFunction(UnicodeCache* unicode_cache,
+                                              Utf16CharacterStream* stream,
+                                              int start, uintptr_t stack_limit);
+
+  Isolate* isolate_;
+  Parser* parser_;
+  Handle<String> source_;
+  LanguageMode language_mode_;
+  AccountingAllocator* allocator_;
+  const AstStringConstants* ast_string_constants_;
+  uint32_t hash_seed_;
+
+  std::unique_ptr<Candidate[]> candidates_;
+  int candidate_count_;
+  // Index of the next candidate a background task should preparse.
+  base::AtomicNumber<int> next_candidate_;
+  base::AtomicValue<bool> abort_;
+
+  // The characters of the source, copied off the heap.
+  std::unique_ptr<uint8_t[]> one_byte_source_;
+  std::unique_ptr<uc16[]> two_byte_source_;
+
+  // One character stream per task. The streams are created on the main thread
+  // and read the copy of the source.
+  std::vector<std::unique_ptr<Utf16CharacterStream>> streams_;
+  std::vector<uint32_t> task_ids_;
+  base::Semaphore pending_tasks_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelPreParser);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_PARSING_PARALLEL_PREPARSER_H_
@@ -246,6 +246,15 @@ class V8_EXPORT_PRIVATE ParseInfo : public CompileJobFinishCallback {
     }
   }
 
+  // Lazily compiled top-level function declarations that are called from the
+  // top-level code of the script, and are thus expected to run soon.
+  const std::vector<FunctionLiteral*>& precompile_candidates() const {
+    return precompile_candidates_;
+  }
+  void add_precompile_candidate(FunctionLiteral* literal) {
+    precompile_candidates_.push_back(literal);
+  }
+
   void UpdateStatisticsAfterBackgroundParse(Isolate* isolate);
 
   // The key of the map is the FunctionLiteral's start_position
@@ -312,6 +321,7 @@ class V8_EXPORT_PRIVATE ParseInfo : public CompileJobFinishCallback {
   //----------- Output of parsing and scope analysis ------------------------
   FunctionLiteral* literal_;
   std::shared_ptr<DeferredHandles> deferred_handles_;
+  std::vector<FunctionLiteral*> precompile_candidates_;
 
   std::vector<std::unique_ptr<ParseInfo>> child_infos_;
   mutable base::Mutex child_infos_mutex_;
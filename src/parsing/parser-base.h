@@ -3333,6 +3333,7 @@ ParserBase<Impl>::ParseLeftHandSideExpression(bool* ok) {
         // they are actually direct calls to eval is determined at run time.
         Call::PossiblyEval is_possibly_eval =
             CheckPossibleEvalCall(result, scope());
+        impl()->RecordCall(result);
 
         bool is_super_call = result->IsSuperCallReference();
         if (spread_pos.IsValid()) {
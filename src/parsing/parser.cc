@@ -19,6 +19,7 @@
 #include "src/messages.h"
 #include "src/objects-inl.h"
 #include "src/parsing/duplicate-finder.h"
+#include "src/parsing/parallel-preparser.h"
 #include "src/parsing/parameter-initializer-rewriter.h"
 #include "src/parsing/parse-info.h"
 #include "src/parsing/rewriter.h"
@@ -492,6 +493,7 @@ Parser::Parser(ParseInfo* info)
       compile_options_(info->compile_options()),
       cached_parse_data_(nullptr),
       total_preparse_skipped_(0),
+      parallel_preparsed_functions_(0),
       temp_zoned_(false),
       log_(nullptr),
       parameters_end_pos_(info->parameters_end_pos()) {
@@ -545,6 +547,21 @@ Parser::Parser(ParseInfo* info)
   }
 }
 
+void Parser::SetPreParserFlags(PreParser* preparser) const {
+#define SET_ALLOW(name) preparser->set_allow_##name(allow_##name());
+  SET_ALLOW(natives);
+  SET_ALLOW(tailcalls);
+  SET_ALLOW(harmony_do_expressions);
+  SET_ALLOW(harmony_function_sent);
+  SET_ALLOW(harmony_trailing_commas);
+  SET_ALLOW(harmony_class_fields);
+  SET_ALLOW(harmony_object_rest_spread);
+  SET_ALLOW(harmony_dynamic_import);
+  SET_ALLOW(harmony_async_iteration);
+  SET_ALLOW(harmony_template_escapes);
+#undef SET_ALLOW
+}
+
 void Parser::DeserializeScopeChain(
     ParseInfo* info, MaybeHandle<ScopeInfo> maybe_outer_scope_info) {
   // TODO(wingo): Add an outer SCRIPT_SCOPE corresponding to the native
@@ -607,11 +624,26 @@ FunctionLiteral* Parser::ParseProgram(Isolate* isolate, ParseInfo* info) {
     main_parse_info_ = info;
   }
 
+  // The background tasks do not produce preparsed scope data and would make
+  // the runtime call stats inaccurate.
+  std::unique_ptr<ParallelPreParser> parallel_preparser;
+  if (FLAG_parallel_preparse && allow_lazy_ && !info->is_module() &&
+      !info->is_eval() && source->length() >= FLAG_parallel_preparse_min_size &&
+      !FLAG_experimental_preparser_scope_analysis && !FLAG_runtime_stats &&
+      !consume_cached_parse_data()) {
+    parallel_preparser.reset(new ParallelPreParser(
+        isolate, this, source, info->language_mode()));
+    parallel_preparser->Start();
+    parallel_preparser_ = parallel_preparser.get();
+  }
+
   {
     std::unique_ptr<Utf16CharacterStream> stream(ScannerStream::For(source));
     scanner_.Initialize(stream.get(), info->is_module());
     result = DoParseProgram(info);
   }
+  parallel_preparser_ = nullptr;
+  parallel_preparser.reset();
   if (result != NULL) {
     DCHECK_EQ(scanner_.peek_location().beg_pos, source->length());
   }
@@ -738,6 +770,10 @@ FunctionLiteral* Parser::DoParseProgram(ParseInfo* info) {
       }
     }
 
+    if (ok && scope->is_script_scope()) {
+      RecordPrecompileCandidates(scope, info);
+    }
+
     if (ok) {
       RewriteDestructuringAssignments();
       int parameter_count = parsing_module_ ? 1 : 0;
@@ -755,6 +791,28 @@ FunctionLiteral* Parser::DoParseProgram(ParseInfo* info) {
   return result;
 }
 
+void Parser::RecordCall(Expression* callee) {
+  if (!FLAG_compiler_dispatcher_precompile) return;
+  if (!callee->IsVariableProxy()) return;
+  if (!scope()->GetClosureScope()->is_script_scope()) return;
+  top_level_callees_.insert(callee->AsVariableProxy()->raw_name());
+}
+
+void Parser::RecordPrecompileCandidates(DeclarationScope* scope,
+                                        ParseInfo* info) {
+  DCHECK(scope->is_script_scope());
+  if (top_level_callees_.empty()) return;
+  for (Declaration* decl : *scope->declarations()) {
+    if (!decl->IsFunctionDeclaration()) continue;
+    FunctionLiteral* literal = decl->AsFunctionDeclaration()->fun();
+    // Eagerly compiled functions are compiled along with the script anyway.
+    if (literal->ShouldEagerCompile()) continue;
+    if (top_level_callees_.count(decl->proxy()->raw_name()) == 0) continue;
+    info->add_precompile_candidate(literal);
+  }
+  top_level_callees_.clear();
+}
+
 FunctionLiteral* Parser::ParseFunction(Isolate* isolate, ParseInfo* info) {
   // It's OK to use the Isolate & counters here, since this function is only
   // called in the main thread.
@@ -2845,7 +2903,36 @@ Parser::LazyParsingResult Parser::SkipFunction(FunctionKind kind,
     cached_parse_data_->Reject();
   }
 
-  // FIXME(marja): There are 3 ways to skip functions now. Unify them.
+  // Top-level functions may have been preparsed in the background already.
+  if (!is_inner_function && parallel_preparser_ != nullptr &&
+      kind == kNormalFunction &&
+      function_scope->outer_scope()->is_script_scope()) {
+    PreParseData::FunctionData data = parallel_preparser_->GetFunctionData(
+        function_scope->start_position(),
+        function_scope->outer_scope()->language_mode());
+    if (data.is_valid()) {
+      total_preparse_skipped_ += data.end - function_scope->start_position();
+      parallel_preparsed_functions_++;
+      function_scope->set_end_position(data.end);
+      scanner()->SeekForward(data.end - 1);
+      Expect(Token::RBRACE, CHECK_OK_VALUE(kLazyParsingComplete));
+      *num_parameters = data.num_parameters;
+      SetLanguageMode(function_scope, data.language_mode);
+      if (data.uses_super_property) {
+        function_scope->RecordSuperPropertyUsage();
+      }
+      SkipFunctionLiterals(data.num_inner_functions);
+      if (produce_cached_parse_data()) {
+        DCHECK(log_);
+        log_->LogFunction(function_scope->start_position(), data.end,
+                          data.num_parameters, data.language_mode,
+                          data.uses_super_property, data.num_inner_functions);
+      }
+      return kLazyParsingComplete;
+    }
+  }
+
+  // FIXME(marja): There are 4 ways to skip functions now. Unify them.
   if (preparsed_scope_data_->Consuming()) {
     DCHECK(FLAG_experimental_preparser_scope_analysis);
     const PreParseData::FunctionData& data =
@@ -3457,6 +3544,8 @@ void Parser::UpdateStatistics(Isolate* isolate, Handle<Script> script) {
   }
   isolate->counters()->total_preparse_skipped()->Increment(
       total_preparse_skipped_);
+  isolate->counters()->parallel_preparsed_functions()->Increment(
+      parallel_preparsed_functions_);
 }
 
 void Parser::ParseOnBackground(ParseInfo* info) {
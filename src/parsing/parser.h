@@ -5,6 +5,8 @@
 #ifndef V8_PARSING_PARSER_H_
 #define V8_PARSING_PARSER_H_
 
+#include <unordered_set>
+
 #include "src/ast/ast.h"
 #include "src/ast/scopes.h"
 #include "src/base/compiler-specific.h"
@@ -23,6 +25,7 @@ class ScriptCompiler;
 
 namespace internal {
 
+class ParallelPreParser;
 class ParseInfo;
 class ScriptData;
 class ParserTarget;
@@ -215,6 +218,7 @@ class V8_EXPORT_PRIVATE Parser : public NON_EXPORTED_BASE(ParserBase<Parser>) {
 
  private:
   friend class ParserBase<Parser>;
+  friend class ParallelPreParser;  // Uses SetPreParserFlags.
   friend class v8::internal::ExpressionClassifier<ParserTypes<Parser>>;
   friend bool v8::internal::parsing::ParseProgram(ParseInfo*, Isolate*, bool);
   friend bool v8::internal::parsing::ParseFunction(ParseInfo*, Isolate*, bool);
@@ -291,22 +295,14 @@ class V8_EXPORT_PRIVATE Parser : public NON_EXPORTED_BASE(ParserBase<Parser>) {
           new PreParser(zone(), &scanner_, stack_limit_, ast_value_factory(),
                         &pending_error_handler_, runtime_call_stats_,
                         preparsed_scope_data_, parsing_on_main_thread_);
-#define SET_ALLOW(name) reusable_preparser_->set_allow_##name(allow_##name());
-      SET_ALLOW(natives);
-      SET_ALLOW(tailcalls);
-      SET_ALLOW(harmony_do_expressions);
-      SET_ALLOW(harmony_function_sent);
-      SET_ALLOW(harmony_trailing_commas);
-      SET_ALLOW(harmony_class_fields);
-      SET_ALLOW(harmony_object_rest_spread);
-      SET_ALLOW(harmony_dynamic_import);
-      SET_ALLOW(harmony_async_iteration);
-      SET_ALLOW(harmony_template_escapes);
-#undef SET_ALLOW
+      SetPreParserFlags(reusable_preparser_);
     }
     return reusable_preparser_;
   }
 
+  // Enables the same language features in |preparser| as in this parser.
+  void SetPreParserFlags(PreParser* preparser) const;
+
   void ParseModuleItemList(ZoneList<Statement*>* body, bool* ok);
   Statement* ParseModuleItem(bool* ok);
   const AstRawString* ParseModuleSpecifier(bool* ok);
@@ -562,6 +558,12 @@ class V8_EXPORT_PRIVATE Parser : public NON_EXPORTED_BASE(ParserBase<Parser>) {
                                  int* num_parameters, bool is_inner_function,
                                  bool may_abort, bool* ok);
 
+  // Remembers the name of a function called from top-level script code.
+  void RecordCall(Expression* callee);
+  // Passes the lazily compiled function declarations of the script {scope}
+  // that are called from its top-level code on to {info}.
+  void RecordPrecompileCandidates(DeclarationScope* scope, ParseInfo* info);
+
   Block* BuildParameterInitializationBlock(
       const ParserFormalParameters& parameters, bool* ok);
   Block* BuildRejectPromiseOnException(Block* block);
@@ -1157,9 +1159,13 @@ class V8_EXPORT_PRIVATE Parser : public NON_EXPORTED_BASE(ParserBase<Parser>) {
   Mode mode_;
 
   std::vector<FunctionLiteral*> literals_to_stitch_;
+  std::unordered_set<const AstRawString*> top_level_callees_;
   Handle<String> source_;
   CompilerDispatcher* compiler_dispatcher_ = nullptr;
   ParseInfo* main_parse_info_ = nullptr;
+  // Preparses top-level functions in the background while parsing a large
+  // script, if any.
+  ParallelPreParser* parallel_preparser_ = nullptr;
 
   friend class ParserTarget;
   friend class ParserTargetScope;
@@ -1174,6 +1180,7 @@ class V8_EXPORT_PRIVATE Parser : public NON_EXPORTED_BASE(ParserBase<Parser>) {
   // parsing.
   int use_counts_[v8::Isolate::kUseCounterFeatureCount];
   int total_preparse_skipped_;
+  int parallel_preparsed_functions_;
   bool allow_lazy_;
   bool temp_zoned_;
   ParserLogger* log_;
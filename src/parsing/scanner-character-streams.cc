@@ -17,6 +17,29 @@ namespace internal {
 
 namespace {
 const unibrow::uchar kUtf8Bom = 0xfeff;
+
+// Returns the length of the longest prefix of data[0..length) that consists
+// of ASCII characters only. The bulk of the input is checked a word at a
+// time.
+size_t AsciiPrefixLength(const uint8_t* data, size_t length) {
+  const char* chars = reinterpret_cast<const char*>(data);
+  size_t prefix = 0;
+  while (prefix < length) {
+    int limit = static_cast<int>(Min<size_t>(length - prefix, kMaxInt));
+    // NonAsciiStart may stop at the start of the word that contains the first
+    // non-ASCII byte, so finish that word byte by byte.
+    size_t ascii = String::NonAsciiStart(chars + prefix, limit);
+    prefix += ascii;
+    if (ascii < static_cast<size_t>(limit)) {
+      while (prefix < length &&
+             data[prefix] <= unibrow::Utf8::kMaxOneByteChar) {
+        prefix++;
+      }
+      break;
+    }
+  }
+  return prefix;
+}
 }  // namespace
 
 // ----------------------------------------------------------------------------
@@ -104,6 +127,7 @@ class ExternalTwoByteStringUtf16CharacterStream : public Utf16CharacterStream {
   ExternalTwoByteStringUtf16CharacterStream(Handle<ExternalTwoByteString> data,
                                             size_t start_position,
                                             size_t end_position);
+  ExternalTwoByteStringUtf16CharacterStream(const uc16* data, size_t length);
 
  private:
   bool ReadBlock() override;
@@ -126,6 +150,15 @@ ExternalTwoByteStringUtf16CharacterStream::
   buffer_pos_ = start_pos_;
 }
 
+ExternalTwoByteStringUtf16CharacterStream::
+    ExternalTwoByteStringUtf16CharacterStream(const uc16* data, size_t length)
+    : raw_data_(data), start_pos_(0), end_pos_(length) {
+  buffer_start_ = raw_data_;
+  buffer_cursor_ = raw_data_;
+  buffer_end_ = raw_data_ + length;
+  buffer_pos_ = 0;
+}
+
 bool ExternalTwoByteStringUtf16CharacterStream::ReadBlock() {
   size_t position = pos();
   bool have_data = start_pos_ <= position && position < end_pos_;
@@ -153,7 +186,6 @@ class ExternalOneByteStringUtf16CharacterStream
                                             size_t start_position,
                                             size_t end_position);
 
-  // For testing:
   ExternalOneByteStringUtf16CharacterStream(const char* data, size_t length);
 
  protected:
@@ -265,6 +297,14 @@ bool Utf8ExternalStreamingStream::SkipToPosition(size_t position) {
   size_t it = current_.pos.bytes - chunk.start.bytes;
   size_t chars = chunk.start.chars;
   while (it < chunk.length && chars < position) {
+    if (incomplete_char == unibrow::Utf8::Utf8IncrementalBuffer(0)) {
+      // Skip a run of ASCII characters, one byte per character.
+      size_t ascii_length = AsciiPrefixLength(
+          chunk.data + it, Min(chunk.length - it, position - chars));
+      it += ascii_length;
+      chars += ascii_length;
+      if (ascii_length > 0) continue;
+    }
     unibrow::uchar t =
         unibrow::Utf8::ValueOfIncremental(chunk.data[it], &incomplete_char);
     if (t == kUtf8Bom && current_.pos.chars == 0) {
@@ -312,15 +352,24 @@ void Utf8ExternalStreamingStream::FillBufferFromCurrentChunk() {
 
   unibrow::Utf8::Utf8IncrementalBuffer incomplete_char =
       current_.pos.incomplete_char;
-  size_t it;
-  for (it = current_.pos.bytes - chunk.start.bytes;
-       it < chunk.length && cursor + 1 < buffer_start_ + kBufferSize; it++) {
+  size_t it = current_.pos.bytes - chunk.start.bytes;
+  while (it < chunk.length && cursor + 1 < buffer_start_ + kBufferSize) {
+    if (incomplete_char == unibrow::Utf8::Utf8IncrementalBuffer(0)) {
+      // Copy a run of ASCII characters without decoding them one by one.
+      size_t capacity = buffer_start_ + kBufferSize - cursor;
+      size_t ascii_length =
+          AsciiPrefixLength(chunk.data + it, Min(chunk.length - it, capacity));
+      CopyCharsUnsigned(cursor, chunk.data + it, ascii_length);
+      cursor += ascii_length;
+      it += ascii_length;
+      if (ascii_length > 0) continue;
+    }
     unibrow::uchar t =
-        unibrow::Utf8::ValueOfIncremental(chunk.data[it], &incomplete_char);
+        unibrow::Utf8::ValueOfIncremental(chunk.data[it++], &incomplete_char);
     if (t == unibrow::Utf8::kIncomplete) continue;
     if (V8_LIKELY(t < kUtf8Bom)) {
       *(cursor++) = static_cast<uc16>(t);  // The by most frequent case.
-    } else if (t == kUtf8Bom && current_.pos.bytes + it == 2) {
+    } else if (t == kUtf8Bom && current_.pos.bytes + it == 3) {
       // BOM detected at beginning of the stream. Don't copy it.
     } else if (t <= unibrow::Utf16::kMaxNonSurrogateCharCode) {
       *(cursor++) = static_cast<uc16>(t);
@@ -846,6 +895,16 @@ std::unique_ptr<Utf16CharacterStream> ScannerStream::ForTesting(
       new ExternalOneByteStringUtf16CharacterStream(data, length));
 }
 
+Utf16CharacterStream* ScannerStream::For(const uint8_t* data,
+                                         size_t length) {
+  return new ExternalOneByteStringUtf16CharacterStream(
+      reinterpret_cast<const char*>(data), length);
+}
+
+Utf16CharacterStream* ScannerStream::For(const uc16* data, size_t length) {
+  return new ExternalTwoByteStringUtf16CharacterStream(data, length);
+}
+
 Utf16CharacterStream* ScannerStream::For(
     ScriptCompiler::ExternalSourceStream* source_stream,
     v8::ScriptCompiler::StreamedSource::Encoding encoding,
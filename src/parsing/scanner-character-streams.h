@@ -26,6 +26,10 @@ class V8_EXPORT_PRIVATE ScannerStream {
       ScriptCompiler::ExternalSourceStream* source_stream,
       ScriptCompiler::StreamedSource::Encoding encoding,
       RuntimeCallStats* stats);
+  // Streams over characters outside of the heap, which may be read from any
+  // thread. |data| must outlive the stream.
+  static Utf16CharacterStream* For(const uint8_t* data, size_t length);
+  static Utf16CharacterStream* For(const uc16* data, size_t length);
 
   // For testing:
   static std::unique_ptr<Utf16CharacterStream> ForTesting(const char* data);
@@ -63,7 +63,8 @@ static const int kMaxSizeOptIgnition = 60 * KB;
   V(DoNotOptimize, "do not optimize")                          \
   V(HotAndStable, "hot and stable")                            \
   V(HotWithoutMuchTypeInfo, "not much type info but very hot") \
-  V(SmallFunction, "small function")
+  V(SmallFunction, "small function")                           \
+  V(OptimizationHint, "optimization hint in code cache")
 
 enum class OptimizationReason : uint8_t {
 #define OPTIMIZATION_REASON_CONSTANTS(Constant, message) k##Constant,
@@ -376,6 +377,17 @@ OptimizationReason RuntimeProfiler::ShouldOptimizeIgnition(
     return OptimizationReason::kDoNotOptimize;
   }
 
+  if (FLAG_cache_optimization_hints && shared->has_optimization_hint()) {
+    // The function was optimized in the process that created its code cache,
+    // so don't wait for ticks, only for the feedback to be stable again.
+    int typeinfo, generic, total, type_percentage, generic_percentage;
+    GetICCounts(function, &typeinfo, &generic, &total, &type_percentage,
+                &generic_percentage);
+    if (type_percentage >= FLAG_type_info_threshold) {
+      return OptimizationReason::kOptimizationHint;
+    }
+  }
+
   if (ticks >= kProfilerTicksBeforeOptimization) {
     int typeinfo, generic, total, type_percentage, generic_percentage;
     GetICCounts(function, &typeinfo, &generic, &total, &type_percentage,
@@ -342,6 +342,13 @@ RUNTIME_FUNCTION(Runtime_GetOptimizationStatus) {
   if (function->IsInterpreted()) {
     status |= static_cast<int>(OptimizationStatus::kInterpreted);
   }
+  // Also report whether the caller runs in TurboFan code, e.g. because it was
+  // inlined into an optimized function.
+  JavaScriptFrameIterator it(isolate);
+  if (!it.done() && it.frame()->is_optimized() &&
+      it.frame()->LookupCode()->is_turbofanned()) {
+    status |= static_cast<int>(OptimizationStatus::kTopmostFrameIsTurboFanned);
+  }
   return Smi::FromInt(status);
 }
 
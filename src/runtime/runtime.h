@@ -862,6 +862,7 @@ enum class OptimizationStatus {
   kOptimized = 1 << 4,
   kTurboFanned = 1 << 5,
   kInterpreted = 1 << 6,
+  kTopmostFrameIsTurboFanned = 1 << 7,
 };
 
 }  // namespace internal
@@ -99,7 +99,14 @@ void CodeSerializer::SerializeObject(HeapObject* obj, HowToCode how_to_code,
         }
         return;
       case Code::FUNCTION:
-        DCHECK(code_object->has_reloc_info_for_serialization());
+        if (!code_object->has_reloc_info_for_serialization()) {
+          // Code caches created after execution may see full-codegen code
+          // that was compiled without serialization support; let the
+          // function be compiled lazily again instead.
+          SerializeBuiltin(Builtins::kCompileLazy, how_to_code,
+                           where_to_point);
+          return;
+        }
         SerializeGeneric(code_object, how_to_code, where_to_point);
         return;
       default:
@@ -804,10 +804,14 @@
         'compiler/load-elimination.h',
         'compiler/loop-analysis.cc',
         'compiler/loop-analysis.h',
+        'compiler/loop-invariant-code-motion.cc',
+        'compiler/loop-invariant-code-motion.h',
         'compiler/loop-peeling.cc',
         'compiler/loop-peeling.h',
         'compiler/loop-variable-optimizer.cc',
         'compiler/loop-variable-optimizer.h',
+        'compiler/loop-vectorizer.cc',
+        'compiler/loop-vectorizer.h',
         'compiler/machine-operator-reducer.cc',
         'compiler/machine-operator-reducer.h',
         'compiler/machine-operator.cc',
@@ -1078,6 +1082,8 @@
         'heap/gc-idle-time-handler.h',
         'heap/gc-tracer.cc',
         'heap/gc-tracer.h',
+        'heap/heap-group.cc',
+        'heap/heap-group.h',
         'heap/heap-inl.h',
         'heap/heap.cc',
         'heap/heap.h',
@@ -1086,6 +1092,9 @@
         'heap/incremental-marking-job.h',
         'heap/incremental-marking.cc',
         'heap/incremental-marking.h',
+        'heap/invalidated-slots-inl.h',
+        'heap/invalidated-slots.cc',
+        'heap/invalidated-slots.h',
         'heap/item-parallel-job.h',
         'heap/mark-compact-inl.h',
         'heap/mark-compact.cc',
@@ -1156,6 +1165,7 @@
         'interpreter/bytecode-generator.h',
         'interpreter/bytecode-label.cc',
         'interpreter/bytecode-label.h',
+        'interpreter/bytecode-lookahead-pairs.h',
         'interpreter/bytecode-node.cc',
         'interpreter/bytecode-node.h',
         'interpreter/bytecode-operands.cc',
@@ -1259,6 +1269,8 @@
         'parsing/expression-classifier.h',
         'parsing/func-name-inferrer.cc',
         'parsing/func-name-inferrer.h',
+        'parsing/parallel-preparser.cc',
+        'parsing/parallel-preparser.h',
         'parsing/parameter-initializer-rewriter.cc',
         'parsing/parameter-initializer-rewriter.h',
         'parsing/parse-info.cc',
@@ -13,7 +13,16 @@
 namespace v8 {
 namespace internal {
 
-AccountingAllocator::AccountingAllocator() : unused_segments_mutex_() {
+namespace {
+
+// The sum of the bytes of one segment of each size class.
+size_t SegmentSizeClassesSum(size_t min_power, size_t max_power) {
+  return (size_t(1) << (max_power + 1)) - (size_t(1) << min_power);
+}
+
+}  // namespace
+
+AccountingAllocator::AccountingAllocator() {
   static const size_t kDefaultBucketMaxSize = 5;
 
   memory_pressure_level_.SetValue(MemoryPressureLevel::kNone);
@@ -22,6 +31,9 @@ AccountingAllocator::AccountingAllocator() : unused_segments_mutex_() {
   std::fill(unused_segments_sizes_, unused_segments_sizes_ + kNumberBuckets, 0);
   std::fill(unused_segments_max_sizes_,
             unused_segments_max_sizes_ + kNumberBuckets, kDefaultBucketMaxSize);
+  max_pool_size_ = static_cast<base::AtomicWord>(
+      kDefaultBucketMaxSize *
+      SegmentSizeClassesSum(kMinSegmentSizePower, kMaxSegmentSizePower));
 }
 
 AccountingAllocator::~AccountingAllocator() { ClearPool(); }
@@ -36,12 +48,12 @@ void AccountingAllocator::MemoryPressureNotification(
 }
 
 void AccountingAllocator::ConfigureSegmentPool(const size_t max_pool_size) {
-  // The sum of the bytes of one segment of each size.
-  static const size_t full_size = (size_t(1) << (kMaxSegmentSizePower + 1)) -
-                                  (size_t(1) << kMinSegmentSizePower);
+  const size_t full_size =
+      SegmentSizeClassesSum(kMinSegmentSizePower, kMaxSegmentSizePower);
   size_t fits_fully = max_pool_size / full_size;
 
-  base::LockGuard<base::Mutex> lock_guard(&unused_segments_mutex_);
+  base::Relaxed_Store(&max_pool_size_,
+                      static_cast<base::AtomicWord>(max_pool_size));
 
   // We assume few zones (less than 'fits_fully' many) to be active at the same
   // time. When zones grow regularly, they will keep requesting segments of
@@ -59,14 +71,34 @@ void AccountingAllocator::ConfigureSegmentPool(const size_t max_pool_size) {
   size_t total_size = fits_fully * full_size;
 
   for (size_t power = 0; power < kNumberBuckets; ++power) {
-    if (total_size + (size_t(1) << (power + kMinSegmentSizePower)) <=
-        max_pool_size) {
+    base::LockGuard<base::Mutex> lock_guard(&unused_segments_mutexes_[power]);
+    const size_t segment_size = size_t(1) << (power + kMinSegmentSizePower);
+    if (total_size + segment_size <= max_pool_size) {
       unused_segments_max_sizes_[power] = fits_fully + 1;
-      total_size += size_t(1) << power;
+      total_size += segment_size;
     } else {
       unused_segments_max_sizes_[power] = fits_fully;
     }
   }
+
+  // Segments beyond the new limit are not needed anymore.
+  TrimPool(max_pool_size);
+}
+
+void AccountingAllocator::TrimPool(size_t target_size) {
+  for (size_t power = kNumberBuckets; power-- > 0;) {
+    if (GetCurrentPoolSize() <= target_size) return;
+    base::LockGuard<base::Mutex> lock_guard(&unused_segments_mutexes_[power]);
+    while (unused_segments_heads_[power] != nullptr &&
+           GetCurrentPoolSize() > target_size) {
+      Segment* segment = unused_segments_heads_[power];
+      unused_segments_heads_[power] = segment->next();
+      unused_segments_sizes_[power]--;
+      base::Relaxed_AtomicIncrement(
+          &current_pool_size_, -static_cast<base::AtomicWord>(segment->size()));
+      FreeSegment(segment);
+    }
+  }
 }
 
 Segment* AccountingAllocator::GetSegment(size_t bytes) {
@@ -123,6 +155,10 @@ size_t AccountingAllocator::GetCurrentPoolSize() const {
   return base::Relaxed_Load(&current_pool_size_);
 }
 
+size_t AccountingAllocator::GetMaxPoolSize() const {
+  return base::Relaxed_Load(&max_pool_size_);
+}
+
 Segment* AccountingAllocator::GetSegmentFromPool(size_t requested_size) {
   if (requested_size > (1 << kMaxSegmentSizePower)) {
     return nullptr;
@@ -136,7 +172,7 @@ Segment* AccountingAllocator::GetSegmentFromPool(size_t requested_size) {
 
   Segment* segment;
   {
-    base::LockGuard<base::Mutex> lock_guard(&unused_segments_mutex_);
+    base::LockGuard<base::Mutex> lock_guard(&unused_segments_mutexes_[power]);
 
     segment = unused_segments_heads_[power];
 
@@ -171,33 +207,48 @@ bool AccountingAllocator::AddSegmentToPool(Segment* segment) {
   power -= kMinSegmentSizePower;
 
   {
-    base::LockGuard<base::Mutex> lock_guard(&unused_segments_mutex_);
+    base::LockGuard<base::Mutex> lock_guard(&unused_segments_mutexes_[power]);
 
     if (unused_segments_sizes_[power] >= unused_segments_max_sizes_[power]) {
       return false;
     }
 
+    if (!ReservePoolSpace(size)) return false;
+
     segment->set_next(unused_segments_heads_[power]);
     unused_segments_heads_[power] = segment;
-    base::Relaxed_AtomicIncrement(&current_pool_size_, size);
     unused_segments_sizes_[power]++;
   }
 
   return true;
 }
 
-void AccountingAllocator::ClearPool() {
-  base::LockGuard<base::Mutex> lock_guard(&unused_segments_mutex_);
+bool AccountingAllocator::ReservePoolSpace(size_t size) {
+  const base::AtomicWord max = base::Relaxed_Load(&max_pool_size_);
+  const base::AtomicWord delta = static_cast<base::AtomicWord>(size);
+  base::AtomicWord current = base::Relaxed_Load(&current_pool_size_);
+  while (current + delta <= max) {
+    base::AtomicWord previous = base::Relaxed_CompareAndSwap(
+        &current_pool_size_, current, current + delta);
+    if (previous == current) return true;
+    current = previous;
+  }
+  return false;
+}
 
-  for (size_t power = 0; power <= kMaxSegmentSizePower - kMinSegmentSizePower;
-       power++) {
+void AccountingAllocator::ClearPool() {
+  for (size_t power = 0; power < kNumberBuckets; power++) {
+    base::LockGuard<base::Mutex> lock_guard(&unused_segments_mutexes_[power]);
     Segment* current = unused_segments_heads_[power];
     while (current) {
       Segment* next = current->next();
+      base::Relaxed_AtomicIncrement(
+          &current_pool_size_, -static_cast<base::AtomicWord>(current->size()));
       FreeSegment(current);
       current = next;
     }
     unused_segments_heads_[power] = nullptr;
+    unused_segments_sizes_[power] = 0;
   }
 }
 
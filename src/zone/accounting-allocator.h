@@ -35,13 +35,19 @@ class V8_EXPORT_PRIVATE AccountingAllocator {
   size_t GetMaxMemoryUsage() const;
 
   size_t GetCurrentPoolSize() const;
+  size_t GetMaxPoolSize() const;
 
   void MemoryPressureNotification(MemoryPressureLevel level);
   // Configures the zone segment pool size limits so the pool does not
-  // grow bigger than max_pool_size.
+  // grow bigger than max_pool_size. The limit is enforced on the total number
+  // of pooled bytes, independent of the per size class limits.
   // TODO(heimbuef): Do not accept segments to pool that are larger than
   // their size class requires. Sometimes the zones generate weird segments.
   void ConfigureSegmentPool(const size_t max_pool_size);
+  // Releases pooled segments, largest first, until the pool holds no more
+  // than target_size bytes. Used to give back the memory of big zones once
+  // the compilation that needed them is done.
+  void TrimPool(size_t target_size);
 
   virtual void ZoneCreation(const Zone* zone) {}
   virtual void ZoneDestruction(const Zone* zone) {}
@@ -69,16 +75,24 @@ class V8_EXPORT_PRIVATE AccountingAllocator {
   // Empties the pool and puts all its contents onto the garbage stack.
   void ClearPool();
 
+  // Reserves room for size bytes in the pool. Returns false if this would
+  // make the pool grow beyond its maximum size.
+  bool ReservePoolSpace(size_t size);
+
+  // The pool is shared by the main thread and the concurrent compiler threads,
+  // so every size class has its own lock to keep them from contending on
+  // unrelated segment sizes.
   Segment* unused_segments_heads_[kNumberBuckets];
 
   size_t unused_segments_sizes_[kNumberBuckets];
   size_t unused_segments_max_sizes_[kNumberBuckets];
 
-  base::Mutex unused_segments_mutex_;
+  base::Mutex unused_segments_mutexes_[kNumberBuckets];
 
   base::AtomicWord current_memory_usage_ = 0;
   base::AtomicWord max_memory_usage_ = 0;
   base::AtomicWord current_pool_size_ = 0;
+  base::AtomicWord max_pool_size_ = 0;
 
   base::AtomicValue<MemoryPressureLevel> memory_pressure_level_;
 
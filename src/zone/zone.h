@@ -63,6 +63,8 @@ class V8_EXPORT_PRIVATE Zone final {
 
   size_t allocation_size() const { return allocation_size_; }
 
+  size_t segment_bytes_allocated() const { return segment_bytes_allocated_; }
+
   AccountingAllocator* allocator() const { return allocator_; }
 
  private:
@@ -18,7 +18,10 @@
   V(CompactionSpaceDivideSinglePage)                      \
   V(TestNewSpaceRefsInCopiedCode)                         \
   V(GCFlags)                                              \
+  V(HeapGroupMembership)                                  \
+  V(HeapGroupOverBudget)                                  \
   V(MarkCompactCollector)                                 \
+  V(MemoryReducerIdleNotification)                        \
   V(NoPromotion)                                          \
   V(NumberStringCacheSize)                                \
   V(ObjectGroups)                                         \
@@ -364,5 +364,66 @@ TEST(ArrayBuffer_RetainedSizeDecreases) {
   CHECK_EQ(0, retained_after - retained_before);
 }
 
+TEST(ArrayBuffer_PretenuredAfterSurvivingScavenge) {
+  if (!FLAG_allocation_site_pretenuring) return;
+  CcTest::InitializeVM();
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate);
+  Heap* heap = i_isolate->heap();
+
+  v8::HandleScope handle_scope(isolate);
+  CHECK_EQ(NOT_TENURED, heap->GetArrayBufferPretenureMode());
+  const int kNumBuffers = AllocationSite::kPretenureMinimumCreated;
+  Handle<FixedArray> holder = i_isolate->factory()->NewFixedArray(kNumBuffers);
+  for (int i = 0; i < kNumBuffers; i++) {
+    Local<v8::ArrayBuffer> ab = v8::ArrayBuffer::New(isolate, 100);
+    holder->set(i, *v8::Utils::OpenHandle(*ab));
+  }
+  // All buffers survive, so new buffers are allocated in old space.
+  heap::GcAndSweep(heap, NEW_SPACE);
+  CHECK_EQ(TENURED, heap->GetArrayBufferPretenureMode());
+  Local<v8::ArrayBuffer> ab = v8::ArrayBuffer::New(isolate, 100);
+  Handle<JSArrayBuffer> buf = v8::Utils::OpenHandle(*ab);
+  CHECK(heap->old_space()->Contains(*buf));
+  CHECK(IsTracked(*buf));
+}
+
+TEST(ArrayBuffer_TypedArrayBuffersPretenured) {
+  if (!FLAG_allocation_site_pretenuring) return;
+  CcTest::InitializeVM();
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate);
+  Heap* heap = i_isolate->heap();
+
+  v8::HandleScope handle_scope(isolate);
+  const int kNumBuffers = AllocationSite::kPretenureMinimumCreated;
+  Handle<FixedArray> holder = i_isolate->factory()->NewFixedArray(kNumBuffers);
+  for (int i = 0; i < kNumBuffers; i++) {
+    Local<v8::ArrayBuffer> ab = v8::ArrayBuffer::New(isolate, 100);
+    holder->set(i, *v8::Utils::OpenHandle(*ab));
+  }
+  heap::GcAndSweep(heap, NEW_SPACE);
+  CHECK_EQ(TENURED, heap->GetArrayBufferPretenureMode());
+
+  // Typed arrays with off-heap storage allocate their buffer through the
+  // ArrayBuffer constructor and follow the decision.
+  CHECK_LT(FLAG_typed_array_max_size_in_heap, 1024);
+  Handle<JSTypedArray> off_heap = v8::Utils::OpenHandle(
+      *v8::Local<v8::Uint8Array>::Cast(CompileRun("new Uint8Array(1024)")));
+  Handle<JSArrayBuffer> off_heap_buffer(
+      JSArrayBuffer::cast(off_heap->buffer()));
+  CHECK(heap->old_space()->Contains(*off_heap_buffer));
+  CHECK(IsTracked(*off_heap_buffer));
+
+  // Typed arrays with on-heap storage allocate their buffer and elements in
+  // new space. The buffer has no backing store to track and is not
+  // pretenured.
+  Handle<JSTypedArray> on_heap = v8::Utils::OpenHandle(
+      *v8::Local<v8::Uint8Array>::Cast(CompileRun("new Uint8Array(8)")));
+  CHECK(heap->InNewSpace(on_heap->buffer()));
+}
+
 }  // namespace internal
 }  // namespace v8
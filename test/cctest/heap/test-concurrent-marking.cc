@@ -21,10 +21,60 @@ TEST(ConcurrentMarking) {
   ConcurrentMarkingDeque deque(heap);
   deque.Push(heap->undefined_value());
   ConcurrentMarking* concurrent_marking = new ConcurrentMarking(heap, &deque);
-  concurrent_marking->StartTask();
-  concurrent_marking->WaitForTaskToComplete();
+  concurrent_marking->ScheduleTasks();
+  concurrent_marking->EnsureCompleted();
   delete concurrent_marking;
 }
 
+TEST(ConcurrentMarkingReschedule) {
+  if (!i::FLAG_concurrent_marking) return;
+  CcTest::InitializeVM();
+  Heap* heap = CcTest::heap();
+  ConcurrentMarkingDeque deque(heap);
+  deque.Push(heap->undefined_value());
+  ConcurrentMarking* concurrent_marking = new ConcurrentMarking(heap, &deque);
+  concurrent_marking->ScheduleTasks();
+  concurrent_marking->EnsureCompleted();
+  deque.Push(heap->undefined_value());
+  concurrent_marking->RescheduleTasksIfNeeded();
+  concurrent_marking->EnsureCompleted();
+  delete concurrent_marking;
+}
+
+TEST(ConcurrentMarkingPause) {
+  if (!i::FLAG_concurrent_marking) return;
+  CcTest::InitializeVM();
+  Heap* heap = CcTest::heap();
+  ConcurrentMarkingDeque deque(heap);
+  deque.Push(heap->undefined_value());
+  ConcurrentMarking* concurrent_marking = new ConcurrentMarking(heap, &deque);
+  concurrent_marking->ScheduleTasks();
+  {
+    ConcurrentMarking::PauseScope scope(concurrent_marking);
+    // All private work of the tasks is published while they are paused.
+    deque.Update([](HeapObject* object) { return object; });
+  }
+  concurrent_marking->EnsureCompleted();
+  delete concurrent_marking;
+}
+
+TEST(ConcurrentMarkingMarkedBytes) {
+  if (!i::FLAG_concurrent_marking) return;
+  if (!i::FLAG_incremental_marking) return;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = CcTest::heap();
+  HandleScope sc(isolate);
+  Handle<FixedArray> root = isolate->factory()->NewFixedArray(1000000);
+  CcTest::CollectAllGarbage();
+  if (!heap->incremental_marking()->IsStopped()) return;
+  heap::SimulateIncrementalMarking(heap, true);
+  // Live bytes of the concurrent tasks are merged when they complete.
+  heap->concurrent_marking()->EnsureCompleted();
+  CHECK_GE(MarkingState::Internal(MemoryChunk::FromAddress(root->address()))
+               .live_bytes(),
+           root->Size());
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -26,6 +26,7 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <stdlib.h>
+#include <limits>
 #include <utility>
 
 #include "src/api.h"
@@ -411,6 +412,38 @@ static void VerifyStringAllocation(Isolate* isolate, const char* string) {
 }
 
 
+TEST(ParallelScavenge) {
+  FLAG_parallel_scavenge = true;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  HandleScope sc(isolate);
+
+  // Old-to-new references are spread over the remembered set items, the
+  // nested arrays are reachable only transitively.
+  const int kNumArrays = 256;
+  Handle<FixedArray> holder = factory->NewFixedArray(kNumArrays, TENURED);
+  for (int i = 0; i < kNumArrays; i++) {
+    HandleScope inner_scope(isolate);
+    Handle<FixedArray> inner = factory->NewFixedArray(2);
+    inner->set(0, Smi::FromInt(i));
+    inner->set(1, *factory->NewHeapNumber(i + 0.5));
+    holder->set(i, *inner);
+  }
+  CHECK(!isolate->heap()->InNewSpace(*holder));
+
+  // The first scavenge copies the arrays within new space, the second one
+  // promotes them.
+  for (int gc = 0; gc < 2; gc++) {
+    CcTest::CollectGarbage(NEW_SPACE);
+    for (int i = 0; i < kNumArrays; i++) {
+      FixedArray* inner = FixedArray::cast(holder->get(i));
+      CHECK_EQ(Smi::FromInt(i), inner->get(0));
+      CHECK_EQ(i + 0.5, HeapNumber::cast(inner->get(1))->value());
+    }
+  }
+}
+
 TEST(String) {
   CcTest::InitializeVM();
   Isolate* isolate = reinterpret_cast<Isolate*>(CcTest::isolate());
@@ -1256,6 +1289,58 @@ TEST(TestUseOfIncrementalBarrierOnCompileLazy) {
   CHECK(g_function->is_compiled());
 }
 
+TEST(TestBytecodeFlushing) {
+  FLAG_flush_bytecode = true;
+  FLAG_always_opt = false;
+  FLAG_opt = false;
+  FLAG_stress_incremental_marking = false;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  v8::HandleScope scope(CcTest::isolate());
+
+  CompileRun(
+      "function foo() {"
+      "  var x = 42;"
+      "  var y = 42;"
+      "  return x + y;"
+      "};"
+      "foo();");
+
+  Handle<String> foo_name = factory->InternalizeUtf8String("foo");
+  Handle<Object> func_value =
+      Object::GetProperty(isolate->global_object(), foo_name)
+          .ToHandleChecked();
+  Handle<JSFunction> function = Handle<JSFunction>::cast(func_value);
+  if (!function->shared()->HasBytecodeArray()) return;
+  CHECK(function->shared()->is_compiled());
+
+  // Bytecode that is young survives a mark-compact.
+  CcTest::CollectAllGarbage();
+  CHECK(function->shared()->is_compiled());
+  CHECK(function->is_compiled());
+
+  // Progress the bytecode age until it's old and ready for flushing.
+  const int kAgingThreshold = 6;
+  for (int i = 0; i < kAgingThreshold; i++) {
+    function->shared()->bytecode_array()->MakeOlder();
+  }
+  CcTest::CollectAllGarbage();
+
+  // The bytecode is flushed and the closure is reset to lazy compilation.
+  CHECK(!function->shared()->is_compiled());
+  CHECK(!function->shared()->HasBytecodeArray());
+  CHECK(!function->is_compiled());
+
+  // Calling the function recompiles it.
+  v8::Local<v8::Value> result = CompileRun("foo();");
+  CHECK_EQ(84, result->Int32Value(CcTest::isolate()->GetCurrentContext())
+                   .FromJust());
+  CHECK(function->shared()->is_compiled());
+  CHECK(function->shared()->HasBytecodeArray());
+  CHECK(function->is_compiled());
+}
+
 TEST(CompilationCacheCachingBehavior) {
   // If we do not age code, or have the compilation cache turned off, this
   // test is invalid.
@@ -6268,6 +6353,59 @@ TEST(RememberedSetRemoveRange) {
   });
 }
 
+namespace {
+
+class SlotSetRemoveRangeThread : public v8::base::Thread {
+ public:
+  SlotSetRemoveRangeThread(SlotSet* set, base::Semaphore* start,
+                           int start_offset, int end_offset)
+      : v8::base::Thread(Options("SlotSetRemoveRangeThread")),
+        set_(set),
+        start_(start),
+        start_offset_(start_offset),
+        end_offset_(end_offset) {}
+
+  void Run() override {
+    start_->Wait();
+    set_->RemoveRange(start_offset_, end_offset_,
+                      SlotSet::KEEP_EMPTY_BUCKETS);
+  }
+
+ private:
+  SlotSet* set_;
+  base::Semaphore* start_;
+  int start_offset_;
+  int end_offset_;
+};
+
+}  // namespace
+
+TEST(SlotSetRemoveRangeRacesWithOverflowingInsert) {
+  // Removing a range from the inline slots on a sweeper thread must not miss
+  // a slot that a concurrent insert copies into the buckets.
+  const int kSparseSlots = SlotSet::kSparseSlots;
+  for (int iteration = 0; iteration < 100; iteration++) {
+    SlotSet set;
+    set.SetPageStart(nullptr);
+    for (int i = 0; i < kSparseSlots; i++) {
+      set.Insert(i * kPointerSize);
+    }
+    CHECK(set.IsSparse());
+    base::Semaphore start(0);
+    SlotSetRemoveRangeThread thread(&set, &start, 0, 2 * kPointerSize);
+    thread.Start();
+    start.Signal();
+    set.Insert(kSparseSlots * kPointerSize);
+    thread.Join();
+    CHECK(!set.IsSparse());
+    CHECK(!set.Contains(0));
+    CHECK(!set.Contains(kPointerSize));
+    for (int i = 2; i <= kSparseSlots; i++) {
+      CHECK(set.Contains(i * kPointerSize));
+    }
+  }
+}
+
 HEAP_TEST(Regress670675) {
   if (!FLAG_incremental_marking) return;
   FLAG_stress_incremental_marking = false;
@@ -6386,5 +6524,173 @@ HEAP_TEST(RegressMissingWriteBarrierInAllocate) {
   CHECK(object->map()->IsMap());
 }
 
+HEAP_TEST(MemoryReducerIdleNotification) {
+  if (!FLAG_incremental_marking) return;
+  FLAG_stress_incremental_marking = false;
+  CcTest::InitializeVM();
+  Heap* heap = CcTest::heap();
+  MemoryReducer* memory_reducer = heap->memory_reducer_;
+  IncrementalMarking* marking = heap->incremental_marking();
+  CcTest::CollectAllGarbage();
+  CHECK(marking->IsStopped());
+
+  // Without a target, idle periods are not used to shrink the heap.
+  heap->MemoryReducerIdleNotification(100000);
+  memory_reducer->PerformIdleStep();
+  CHECK(marking->IsStopped());
+
+  // The heap is always above this target, so idle steps start and finish a
+  // memory reducing GC.
+  heap->SetHeapMemoryTarget(1);
+  heap->MemoryReducerIdleNotification(100000);
+  int gc_count = heap->gc_count();
+  while (heap->gc_count() == gc_count) {
+    memory_reducer->PerformIdleStep();
+  }
+  CHECK_EQ(1, memory_reducer->idle_gcs_started_);
+  CHECK(marking->IsStopped());
+
+  // Ending the idle period stops further work.
+  heap->MemoryReducerIdleNotification(0);
+  memory_reducer->PerformIdleStep();
+  CHECK(marking->IsStopped());
+  CHECK_EQ(1, memory_reducer->idle_gcs_started_);
+  heap->SetHeapMemoryTarget(0);
+}
+
+TEST(GCStatistics) {
+  CcTest::InitializeVM();
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::GCStatistics before;
+  isolate->GetGCStatistics(&before);
+  CcTest::CollectGarbage(NEW_SPACE);
+  CcTest::CollectAllGarbage();
+  v8::GCStatistics after;
+  isolate->GetGCStatistics(&after);
+
+  size_t young_before =
+      before.pause_histogram(v8::GCStatistics::kScavenge).count() +
+      before.pause_histogram(v8::GCStatistics::kMinorMarkCompact).count();
+  size_t young_after =
+      after.pause_histogram(v8::GCStatistics::kScavenge).count() +
+      after.pause_histogram(v8::GCStatistics::kMinorMarkCompact).count();
+  CHECK_LT(young_before, young_after);
+  const v8::GCPauseHistogram& full =
+      after.pause_histogram(v8::GCStatistics::kMarkCompact);
+  CHECK_LT(before.pause_histogram(v8::GCStatistics::kMarkCompact).count(),
+           full.count());
+  CHECK_LT(before.pause_histogram(v8::GCStatistics::kMark).count(),
+           after.pause_histogram(v8::GCStatistics::kMark).count());
+  size_t bucket_counts = 0;
+  for (int i = 0; i < v8::GCPauseHistogram::kNumberOfBuckets; i++) {
+    bucket_counts += full.bucket_count(i);
+  }
+  CHECK_EQ(full.count(), bucket_counts);
+  CHECK_LE(full.max_ms(), full.total_ms());
+  CHECK_EQ(std::numeric_limits<double>::infinity(),
+           v8::GCPauseHistogram::BucketUpperBound(
+               v8::GCPauseHistogram::kNumberOfBuckets - 1));
+}
+
+TEST(GCStatisticsBytesFreedExcludesPromotedObjects) {
+  if (FLAG_minor_mc) return;
+  CcTest::InitializeVM();
+  v8::Isolate* isolate = CcTest::isolate();
+  Isolate* i_isolate = CcTest::i_isolate();
+  Heap* heap = i_isolate->heap();
+  HandleScope scope(i_isolate);
+
+  const int kLength = 16 * KB;
+  Handle<FixedArray> array = i_isolate->factory()->NewFixedArray(kLength);
+  CHECK(heap->InNewSpace(*array));
+  // The first scavenge copies the array within new space, the second one
+  // promotes it.
+  CcTest::CollectGarbage(NEW_SPACE);
+  CHECK(heap->InNewSpace(*array));
+  v8::GCStatistics before;
+  isolate->GetGCStatistics(&before);
+  size_t new_space_size = heap->new_space()->SizeOfObjects();
+  CcTest::CollectGarbage(NEW_SPACE);
+  CHECK(heap->InOldSpace(*array));
+  v8::GCStatistics after;
+  isolate->GetGCStatistics(&after);
+
+  size_t freed = after.bytes_freed(v8::GCStatistics::kNewSpace) -
+                 before.bytes_freed(v8::GCStatistics::kNewSpace);
+  CHECK_LE(freed, new_space_size - array->Size());
+  CHECK_LE(before.bytes_promoted() + array->Size(), after.bytes_promoted());
+}
+
+namespace {
+
+size_t TotalMemoryPressureNotifications(v8::HeapGroup* group) {
+  size_t total = 0;
+  for (size_t i = 0; i < group->NumberOfMembers(); i++) {
+    v8::HeapGroupMemberStatistics stats;
+    CHECK(group->GetMemberStatistics(&stats, i));
+    total += stats.memory_pressure_notifications();
+  }
+  return total;
+}
+
+}  // namespace
+
+UNINITIALIZED_HEAP_TEST(HeapGroupMembership) {
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate1 = v8::Isolate::New(create_params);
+  v8::Isolate* isolate2 = v8::Isolate::New(create_params);
+  v8::HeapGroup* group = v8::HeapGroup::New(static_cast<size_t>(1) << 40);
+  isolate1->SetHeapGroup(group);
+  isolate2->SetHeapGroup(group);
+  CHECK_EQ(2, group->NumberOfMembers());
+  {
+    v8::Isolate::Scope isolate_scope(isolate1);
+    Heap* heap = reinterpret_cast<Isolate*>(isolate1)->heap();
+    heap->CollectAllGarbage(Heap::kNoGCFlags,
+                            GarbageCollectionReason::kTesting);
+    v8::HeapGroupMemberStatistics stats;
+    CHECK(group->GetMemberStatistics(&stats, 0));
+    CHECK_EQ(isolate1, stats.isolate());
+    CHECK_EQ(heap->PromotedSpaceSizeOfObjects(), stats.old_generation_size());
+    CHECK_EQ(heap->old_generation_allocation_limit(),
+             stats.old_generation_allocation_limit());
+  }
+  // A large budget never causes memory pressure.
+  CHECK_EQ(0, TotalMemoryPressureNotifications(group));
+  isolate1->Dispose();
+  CHECK_EQ(1, group->NumberOfMembers());
+  isolate2->SetHeapGroup(nullptr);
+  CHECK_EQ(0, group->NumberOfMembers());
+  isolate2->Dispose();
+  group->Dispose();
+}
+
+UNINITIALIZED_HEAP_TEST(HeapGroupOverBudget) {
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  v8::HeapGroup* group = v8::HeapGroup::New(0);
+  isolate->SetHeapGroup(group);
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    Heap* heap = reinterpret_cast<Isolate*>(isolate)->heap();
+    heap->CollectAllGarbage(Heap::kNoGCFlags,
+                            GarbageCollectionReason::kTesting);
+    // The member is over budget, so it gets notified once and its limit is
+    // kept close to its current size.
+    CHECK_EQ(1, TotalMemoryPressureNotifications(group));
+    CHECK_LT(heap->old_generation_allocation_limit(),
+             heap->PromotedSpaceSizeOfObjects() + 16 * MB);
+    // Scavenges do not notify the member again while the pressure is
+    // pending.
+    heap->CollectGarbage(NEW_SPACE, GarbageCollectionReason::kTesting);
+    CHECK_EQ(1, TotalMemoryPressureNotifications(group));
+  }
+  isolate->Dispose();
+  CHECK_EQ(0, group->NumberOfMembers());
+  group->Dispose();
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -0,0 +1,123 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stdlib.h>
+
+#include "src/v8.h"
+
+#include "src/heap/heap-inl.h"
+#include "src/heap/heap.h"
+#include "src/heap/invalidated-slots-inl.h"
+#include "src/heap/invalidated-slots.h"
+#include "test/cctest/cctest.h"
+#include "test/cctest/heap/heap-utils.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+Page* FillPageWithFixedArrays(Heap* heap,
+                              std::vector<Handle<FixedArray>>* arrays) {
+  heap::SealCurrentObjects(heap);
+  *arrays = heap::FillOldSpacePageWithFixedArrays(heap, 0);
+  Page* page = Page::FromAddress(arrays->front()->address());
+  for (Handle<FixedArray> array : *arrays) {
+    CHECK_EQ(page, Page::FromAddress(array->address()));
+  }
+  return page;
+}
+
+}  // namespace
+
+TEST(InvalidatedSlotsNoInvalidatedRanges) {
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = CcTest::heap();
+  HandleScope scope(isolate);
+  std::vector<Handle<FixedArray>> arrays;
+  Page* page = FillPageWithFixedArrays(heap, &arrays);
+  InvalidatedSlotsFilter filter(page);
+  for (Handle<FixedArray> array : arrays) {
+    Address start = array->address() + kPointerSize;
+    for (Address addr = start; addr < array->address() + array->Size();
+         addr += kPointerSize) {
+      CHECK(filter.IsValid(addr));
+    }
+  }
+}
+
+TEST(InvalidatedSlotsSomeInvalidatedRanges) {
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = CcTest::heap();
+  HandleScope scope(isolate);
+  std::vector<Handle<FixedArray>> arrays;
+  Page* page = FillPageWithFixedArrays(heap, &arrays);
+  // Register every second array as invalidated.
+  for (size_t i = 0; i < arrays.size(); i += 2) {
+    page->RegisterObjectWithInvalidatedSlots(*arrays[i], arrays[i]->Size());
+  }
+  InvalidatedSlotsFilter filter(page);
+  for (size_t i = 0; i < arrays.size(); i++) {
+    Address start = arrays[i]->address() + kPointerSize;
+    for (Address addr = start; addr < arrays[i]->address() + arrays[i]->Size();
+         addr += kPointerSize) {
+      // The length field is not a tagged slot of the array.
+      bool is_length = addr == arrays[i]->address() + FixedArray::kLengthOffset;
+      if (i % 2 == 0) {
+        CHECK_EQ(!is_length, filter.IsValid(addr));
+      } else {
+        CHECK(filter.IsValid(addr));
+      }
+    }
+  }
+  page->ReleaseInvalidatedSlots();
+}
+
+TEST(InvalidatedSlotsAfterTrimming) {
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = CcTest::heap();
+  HandleScope scope(isolate);
+  std::vector<Handle<FixedArray>> arrays;
+  Page* page = FillPageWithFixedArrays(heap, &arrays);
+  // Register all arrays as invalidated and shrink them afterwards.
+  std::vector<int> old_sizes;
+  for (Handle<FixedArray> array : arrays) {
+    old_sizes.push_back(array->Size());
+    page->RegisterObjectWithInvalidatedSlots(*array, array->Size());
+    heap->RightTrimFixedArray(*array, 1);
+  }
+  InvalidatedSlotsFilter filter(page);
+  for (size_t i = 0; i < arrays.size(); i++) {
+    Address start = arrays[i]->address() + FixedArray::kHeaderSize;
+    for (Address addr = start; addr < arrays[i]->address() + old_sizes[i];
+         addr += kPointerSize) {
+      CHECK_EQ(addr < arrays[i]->address() + arrays[i]->Size(),
+               filter.IsValid(addr));
+    }
+  }
+  page->ReleaseInvalidatedSlots();
+}
+
+TEST(InvalidatedSlotsEvacuationCandidate) {
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = CcTest::heap();
+  HandleScope scope(isolate);
+  std::vector<Handle<FixedArray>> arrays;
+  Page* page = FillPageWithFixedArrays(heap, &arrays);
+  page->SetFlag(MemoryChunk::EVACUATION_CANDIDATE);
+  // Slots are not recorded on evacuation candidates, so there is nothing
+  // to invalidate.
+  for (Handle<FixedArray> array : arrays) {
+    page->RegisterObjectWithInvalidatedSlots(*array, array->Size());
+  }
+  CHECK_NULL(page->invalidated_slots());
+  page->ClearFlag(MemoryChunk::EVACUATION_CANDIDATE);
+}
+
+}  // namespace internal
+}  // namespace v8
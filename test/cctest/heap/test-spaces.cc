@@ -433,6 +433,104 @@ TEST(LargeObjectSpace) {
   CHECK(lo->AllocateRaw(lo_size, NOT_EXECUTABLE).IsRetry());
 }
 
+TEST(YoungGenerationLargeObjectPromotedOnScavenge) {
+  FLAG_young_generation_large_objects = true;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  HandleScope scope(isolate);
+
+  const int length = kMaxRegularHeapObjectSize / kPointerSize + 1;
+  Handle<FixedArray> array = isolate->factory()->NewFixedArray(length);
+  CHECK(heap->new_lo_space()->Contains(*array));
+  CHECK(heap->InNewSpace(*array));
+  CHECK(!heap->lo_space()->Contains(*array));
+  Address address = array->address();
+
+  Handle<HeapNumber> number = isolate->factory()->NewHeapNumber(42.0);
+  CHECK(heap->InNewSpace(*number));
+  array->set(0, *number);
+
+  // The array is promoted in place and its pointers into new space are
+  // recorded as old-to-new slots.
+  CcTest::CollectGarbage(NEW_SPACE);
+  CHECK_EQ(address, array->address());
+  CHECK(heap->lo_space()->Contains(*array));
+  CHECK(!heap->InNewSpace(*array));
+  CHECK(heap->new_lo_space()->IsEmpty());
+  CHECK_EQ(*number, array->get(0));
+
+  CcTest::CollectGarbage(NEW_SPACE);
+  CcTest::CollectGarbage(NEW_SPACE);
+  CHECK(array->get(0)->IsHeapNumber());
+  CHECK_EQ(42.0, HeapNumber::cast(array->get(0))->value());
+}
+
+TEST(YoungGenerationLargeObjectDiesOnScavenge) {
+  FLAG_young_generation_large_objects = true;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+
+  const size_t lo_size_before = heap->lo_space()->SizeOfObjects();
+  {
+    HandleScope scope(isolate);
+    const int length = kMaxRegularHeapObjectSize / kPointerSize + 1;
+    Handle<FixedArray> array = isolate->factory()->NewFixedArray(length);
+    CHECK(heap->new_lo_space()->Contains(*array));
+    CHECK(!heap->new_lo_space()->IsEmpty());
+  }
+  CcTest::CollectGarbage(NEW_SPACE);
+  CHECK(heap->new_lo_space()->IsEmpty());
+  CHECK_EQ(0u, heap->new_lo_space()->SizeOfObjects());
+  CHECK_EQ(lo_size_before, heap->lo_space()->SizeOfObjects());
+}
+
+TEST(YoungGenerationLargeObjectPromotedOnMarkCompact) {
+  FLAG_young_generation_large_objects = true;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  HandleScope scope(isolate);
+
+  const int length = kMaxRegularHeapObjectSize / kPointerSize + 1;
+  Handle<FixedArray> array = isolate->factory()->NewFixedArray(length);
+  {
+    HandleScope inner_scope(isolate);
+    isolate->factory()->NewFixedArray(length);
+  }
+  Handle<HeapNumber> number = isolate->factory()->NewHeapNumber(42.0);
+  array->set(0, *number);
+  Address address = array->address();
+
+  CcTest::CollectAllGarbage();
+  CHECK_EQ(address, array->address());
+  CHECK(heap->lo_space()->Contains(*array));
+  CHECK(heap->new_lo_space()->IsEmpty());
+  CHECK_EQ(*number, array->get(0));
+  CHECK_EQ(42.0, HeapNumber::cast(array->get(0))->value());
+}
+
+TEST(DeadLargeObjectPagesAreFreedByMarkCompact) {
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  MemoryAllocator::Unmapper* unmapper = heap->memory_allocator()->unmapper();
+
+  {
+    HandleScope scope(isolate);
+    const int length = kMaxRegularHeapObjectSize / kPointerSize + 1;
+    Handle<FixedArray> array =
+        isolate->factory()->NewFixedArray(length, TENURED);
+    CHECK(heap->lo_space()->Contains(*array));
+  }
+  CcTest::CollectAllGarbage();
+  // The pages of the dead array are unmapped by the garbage collection that
+  // found it dead, not only by the next one.
+  unmapper->WaitUntilCompleted();
+  CHECK_EQ(0u, unmapper->NumberOfNonRegularChunks());
+}
+
 TEST(SizeOfInitialHeap) {
   if (i::FLAG_always_opt) return;
   // Bootstrapping without a snapshot causes more allocations.
@@ -243,6 +243,46 @@ TEST(Utf8SingleByteChunks) {
   }
 }
 
+TEST(Utf8AsciiRuns) {
+  // Long runs of ascii characters, interrupted by multi-byte characters at
+  // varying alignments, both within and across buffer and chunk boundaries.
+  std::string utf8;
+  std::vector<uint16_t> ucs2;
+  for (int run = 0; run < 40; run++) {
+    for (int i = 0; i < run * 37; i++) {
+      char c = 'a' + (i % 26);
+      utf8 += c;
+      ucs2.push_back(c);
+    }
+    utf8 += unicode_utf8;
+    for (size_t i = 0; unicode_ucs2[i]; i++) ucs2.push_back(unicode_ucs2[i]);
+  }
+
+  for (int chunky = 0; chunky < 2; chunky++) {
+    ChunkSource chunk_source(reinterpret_cast<const uint8_t*>(utf8.data()),
+                             utf8.length(), chunky == 1);
+    std::unique_ptr<v8::internal::Utf16CharacterStream> stream(
+        v8::internal::ScannerStream::For(
+            &chunk_source, v8::ScriptCompiler::StreamedSource::UTF8, nullptr));
+
+    for (size_t i = 0; i < ucs2.size(); i++) {
+      CHECK_EQ(ucs2[i], stream->Advance());
+    }
+    CHECK_EQ(v8::internal::Utf16CharacterStream::kEndOfInput,
+             stream->Advance());
+
+    // Seek backwards and forwards through the data.
+    for (size_t pos = 0; pos < ucs2.size(); pos += 101) {
+      stream->Seek(pos);
+      CHECK_EQ(ucs2[pos], stream->Advance());
+    }
+    for (size_t pos = ucs2.size(); pos > 97; pos -= 97) {
+      stream->Seek(pos - 1);
+      CHECK_EQ(ucs2[pos - 1], stream->Advance());
+    }
+  }
+}
+
 #define CHECK_EQU(v1, v2) CHECK_EQ(static_cast<int>(v1), static_cast<int>(v2))
 
 void TestCharacterStream(const char* reference, i::Utf16CharacterStream* stream,
@@ -31,7 +31,9 @@
 #include "src/v8.h"
 
 #include "src/api.h"
+#include "src/compilation-info.h"
 #include "src/compiler.h"
+#include "src/compiler/pipeline.h"
 #include "src/disasm.h"
 #include "src/factory.h"
 #include "src/interpreter/interpreter.h"
@@ -718,3 +720,39 @@ TEST(InvocationCount) {
   CompileRun("foo(); foo()");
   CHECK_EQ(4, foo->feedback_vector()->invocation_count());
 }
+
+TEST(LoopAwareRegisterAllocationForHotFunctions) {
+  FLAG_always_opt = false;
+  FLAG_turbo_loop_aware_regalloc = true;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  v8::HandleScope scope(CcTest::isolate());
+
+  CompileRun(
+      "function foo(n) {"
+      "  var s = 0;"
+      "  for (var i = 0; i < n; i++) s += i;"
+      "  return s;"
+      "};"
+      "foo(10);");
+  Handle<JSFunction> foo = Handle<JSFunction>::cast(GetGlobalProperty("foo"));
+  if (!foo->shared()->HasBytecodeArray()) return;
+
+  // The ticks recorded on the compilation info decide, not the ones left on
+  // the function, which GetOptimizedCode resets before compiling.
+  foo->shared()->set_profiler_ticks(0);
+  const int kThreshold = FLAG_turbo_loop_aware_regalloc_ticks;
+  const int kTicks[] = {kThreshold - 1, kThreshold};
+  for (int ticks : kTicks) {
+    std::unique_ptr<CompilationJob> job(
+        compiler::Pipeline::NewCompilationJob(foo, true));
+    CompilationInfo* info = job->info();
+    info->SetOptimizing();
+    info->set_profiler_ticks(ticks);
+    info->MarkAsOptimizeFromBytecode();
+    CanonicalHandleScope canonical(isolate);
+    CHECK_EQ(CompilationJob::SUCCEEDED, job->PrepareJob());
+    CHECK(!info->is_osr());
+    CHECK_EQ(ticks >= kThreshold, info->is_loop_aware_register_allocation());
+  }
+}
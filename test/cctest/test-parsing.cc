@@ -42,6 +42,7 @@
 #include "src/isolate.h"
 #include "src/objects-inl.h"
 #include "src/objects.h"
+#include "src/parsing/parallel-preparser.h"
 #include "src/parsing/parse-info.h"
 #include "src/parsing/parser.h"
 #include "src/parsing/parsing.h"
@@ -298,6 +299,129 @@ TEST(UsingCachedData) {
 }
 
 
+TEST(ParallelPreParserFindTopLevelFunctions) {
+  // The parameter lists named (pN) are expected to be found, in order.
+  const char* source =
+      "function f(p1) { var s = '}'; return /}/.test(s); }\n"
+      "var t = `${ {a: `}`} }` + \"function n() {}\";\n"
+      "var r = /['{]/g, q = 1 / 2 / 3;\n"
+      "// function n() {}\n"
+      "/* function n() {} */\n"
+      "async function n() {}\n"
+      "function* n() {}\n"
+      "(function n() {})();\n"
+      "x.function(1);\n"
+      "var o = { m: function n() {} };\n"
+      "function g /* comment */ (p2) {}\n"
+      "var h = function (p3) {};\n"
+      "{ function n() {} }\n"
+      "function k(p4) { return `${function n() {}}`; }\n";
+  const char* expected[] = {"(p1)", "(p2)", "(p3)", "(p4)"};
+
+  std::vector<int> positions;
+  CHECK(!i::ParallelPreParser::FindTopLevelFunctions(
+      i::Vector<const uint8_t>(reinterpret_cast<const uint8_t*>(source),
+                               i::StrLength(source)),
+      &positions));
+  CHECK_EQ(arraysize(expected), positions.size());
+  for (size_t i = 0; i < arraysize(expected); i++) {
+    CHECK_EQ(static_cast<int>(strstr(source, expected[i]) - source),
+             positions[i]);
+  }
+
+  const char* strict_source = "/* x */ 'use strict'; function f(a) {}";
+  positions.clear();
+  CHECK(i::ParallelPreParser::FindTopLevelFunctions(
+      i::Vector<const uint8_t>(reinterpret_cast<const uint8_t*>(strict_source),
+                               i::StrLength(strict_source)),
+      &positions));
+  CHECK_EQ(1u, positions.size());
+  CHECK_EQ(static_cast<int>(strstr(strict_source, "(a)") - strict_source),
+           positions[0]);
+}
+
+
+namespace {
+
+int parallel_preparsed_functions = 0;
+
+int* LookupParallelPreparsedFunctions(const char* name) {
+  if (strcmp(name, "c:V8.ParallelPreparsedFunctions") == 0) {
+    return &parallel_preparsed_functions;
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+TEST(ParallelPreParse) {
+  if (!i::FLAG_lazy) return;
+  bool old_parallel_preparse = i::FLAG_parallel_preparse;
+  int old_parallel_preparse_min_size = i::FLAG_parallel_preparse_min_size;
+  bool old_parallel_preparse_on_main_thread =
+      i::FLAG_parallel_preparse_on_main_thread;
+  i::FLAG_parallel_preparse = true;
+  i::FLAG_parallel_preparse_min_size = 0;
+  i::FLAG_parallel_preparse_on_main_thread = true;
+  // Each source is compiled twice and must be parsed both times.
+  bool old_compilation_cache = i::FLAG_compilation_cache;
+  i::FLAG_compilation_cache = false;
+
+  v8::Isolate* isolate = CcTest::isolate();
+  isolate->SetCounterFunction(LookupParallelPreparsedFunctions);
+  v8::HandleScope handles(isolate);
+  v8::Local<v8::Context> context = v8::Context::New(isolate);
+  v8::Context::Scope context_scope(context);
+
+  const char* sources[] = {
+      "function f1(a) { return a + 1; }\n"
+      "function f2(a, b) { 'use strict'; return a * b + (this ? 0 : 1); }\n"
+      "function f3() { return function() { return 3; }; }\n"
+      "function f4(a, b) { return arguments.length + f4.length; }\n"
+      "f1(1) + f2(2, 3) + f3()() + f4(1) - 3;",
+      "'use strict';\n"
+      "function f1() { return this === undefined ? 1 : 0; }\n"
+      "function f2(a = 2) { return a; }\n"
+      "function f3() { return `${ {a: 1}.a }` == '1' ? 2 : 0; }\n"
+      "function f4() { return 100; }\n"
+      "f1() + f2() + f3() + 7;"};
+
+  parallel_preparsed_functions = 0;
+  for (const char* source : sources) {
+    // Both external and sequential sources are preparsed in parallel.
+    for (bool external : {true, false}) {
+      v8::Local<v8::String> script_source;
+      if (external) {
+        // ScriptResource will be deleted when the corresponding String is
+        // GCd.
+        script_source =
+            v8::String::NewExternalOneByte(
+                isolate, new ScriptResource(source, i::StrLength(source)))
+                .ToLocalChecked();
+      } else {
+        script_source = v8_str(source);
+      }
+      v8::Local<v8::Value> result =
+          v8::Script::Compile(context, script_source)
+              .ToLocalChecked()
+              ->Run(context)
+              .ToLocalChecked();
+      CHECK_EQ(12, result->Int32Value(context).FromJust());
+      // All four functions are preparsed before the parser reaches them.
+      CHECK_EQ(4, parallel_preparsed_functions);
+      parallel_preparsed_functions = 0;
+    }
+  }
+
+  isolate->SetCounterFunction(nullptr);
+  i::FLAG_parallel_preparse = old_parallel_preparse;
+  i::FLAG_parallel_preparse_min_size = old_parallel_preparse_min_size;
+  i::FLAG_parallel_preparse_on_main_thread =
+      old_parallel_preparse_on_main_thread;
+  i::FLAG_compilation_cache = old_compilation_cache;
+}
+
+
 TEST(PreparseFunctionDataIsUsed) {
   // Producing cached parser data while parsing eagerly is not supported.
   if (!i::FLAG_lazy) return;
@@ -1253,6 +1377,38 @@ TEST(DiscardFunctionBody) {
   }
 }
 
+TEST(PrecompileCandidates) {
+  // Test that lazily compiled top-level function declarations are marked for
+  // precompilation if top-level code calls them.
+  i::FLAG_compiler_dispatcher_precompile = true;
+  i::Isolate* isolate = CcTest::i_isolate();
+  i::Factory* factory = isolate->factory();
+  v8::HandleScope handles(CcTest::isolate());
+
+  const char* source =
+      "function f() { return 1; }\n"
+      "function g() { return 2; }\n"
+      "function h() { return 3; }\n"
+      "function k() { return h(); }\n"
+      "f();\n"
+      "if (f()) g();\n";
+  i::Handle<i::String> source_code =
+      factory->NewStringFromUtf8(i::CStrVector(source)).ToHandleChecked();
+  i::Handle<i::Script> script = factory->NewScript(source_code);
+  i::ParseInfo info(script);
+  CHECK(i::parsing::ParseProgram(&info, isolate));
+
+  // h is only called from within k, and k is not called at all.
+  const std::vector<i::FunctionLiteral*>& candidates =
+      info.precompile_candidates();
+  CHECK_EQ(2u, candidates.size());
+  CHECK_EQ(strstr(source, "function f") - source,
+           candidates[0]->function_token_position());
+  CHECK_EQ(strstr(source, "function g") - source,
+           candidates[1]->function_token_position());
+  i::FLAG_compiler_dispatcher_precompile = false;
+}
+
 
 const char* ReadString(unsigned* start) {
   int length = start[0];
@@ -1693,6 +1693,97 @@ TEST(CodeSerializerBitFlip) {
   isolate2->Dispose();
 }
 
+TEST(CodeSerializerAfterExecutionWithOptimizationHints) {
+  if (!FLAG_opt || FLAG_always_opt) return;
+  FLAG_serialize_toplevel = true;
+  FLAG_allow_natives_syntax = true;
+  FLAG_cache_optimization_hints = true;
+  FlagList::EnforceFlagImplications();
+
+  // Only the producing isolate sets {optimize}, so f is optimized there.
+  const char* source =
+      "function f(a, b) { return a + b; };"
+      "f(1, 2); f(3, 4);"
+      "if (this.optimize) %OptimizeFunctionOnNextCall(f);"
+      "f(5, 6);";
+
+  v8::ScriptCompiler::CachedData* cache;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate1 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate1);
+    v8::HandleScope scope(isolate1);
+    v8::Local<v8::Context> context = v8::Context::New(isolate1);
+    v8::Context::Scope context_scope(context);
+    CHECK(context->Global()
+              ->Set(context, v8_str("optimize"), v8::True(isolate1))
+              .FromJust());
+
+    v8::Local<v8::String> source_str = v8_str(source);
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source source(source_str, origin);
+    v8::Local<v8::UnboundScript> script =
+        v8::ScriptCompiler::CompileUnboundScript(isolate1, &source)
+            .ToLocalChecked();
+    script->BindToCurrentContext()->Run(context).ToLocalChecked();
+    Handle<JSFunction> f = Handle<JSFunction>::cast(v8::Utils::OpenHandle(
+        *context->Global()->Get(context, v8_str("f")).ToLocalChecked()));
+    CHECK(f->IsOptimized());
+    CHECK(f->shared()->has_optimization_hint());
+
+    cache = v8::ScriptCompiler::CreateCodeCache(script, source_str);
+    CHECK_NOT_NULL(cache);
+  }
+  isolate1->Dispose();
+
+  v8::Isolate* isolate2 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate2);
+    v8::HandleScope scope(isolate2);
+    v8::Local<v8::Context> context = v8::Context::New(isolate2);
+    v8::Context::Scope context_scope(context);
+
+    v8::Local<v8::String> source_str = v8_str(source);
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source source(source_str, origin, cache);
+    v8::Local<v8::UnboundScript> script =
+        v8::ScriptCompiler::CompileUnboundScript(
+            isolate2, &source, v8::ScriptCompiler::kConsumeCodeCache)
+            .ToLocalChecked();
+    CHECK(!cache->rejected);
+    script->BindToCurrentContext()->Run(context).ToLocalChecked();
+
+    // The hint survived, but f is only optimized once the profiler sees it.
+    Handle<JSFunction> f = Handle<JSFunction>::cast(v8::Utils::OpenHandle(
+        *context->Global()->Get(context, v8_str("f")).ToLocalChecked()));
+    CHECK(!f->IsOptimized());
+    CHECK(f->shared()->has_optimization_hint());
+  }
+  isolate2->Dispose();
+}
+
+TEST(OptimizationHintClearedOnDeopt) {
+  if (!FLAG_opt || FLAG_always_opt) return;
+  FLAG_allow_natives_syntax = true;
+  FLAG_cache_optimization_hints = true;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+
+  Handle<JSFunction> f = Handle<JSFunction>::cast(v8::Utils::OpenHandle(
+      *CompileRun("function f(a, b) { return a + b; };"
+                  "f(1, 2); f(3, 4);"
+                  "%OptimizeFunctionOnNextCall(f);"
+                  "f(5, 6);"
+                  "f")));
+  CHECK(f->IsOptimized());
+  CHECK(f->shared()->has_optimization_hint());
+
+  CompileRun("%DeoptimizeFunction(f)");
+  CHECK(!f->IsOptimized());
+  CHECK(!f->shared()->has_optimization_hint());
+}
+
 TEST(CodeSerializerWithHarmonyScoping) {
   FLAG_serialize_toplevel = true;
 
@@ -0,0 +1,102 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Handlers which call an IC on every execution, to measure the cost of
+// keeping the interpreter state live across the call.
+
+function addBenchmark(name, test) {
+  new BenchmarkSuite(name, [1000],
+      [
+        new Benchmark(name, false, false, 0, test)
+      ]);
+}
+
+addBenchmark('Named-Store', namedStore);
+addBenchmark('Keyed-Load', keyedLoad);
+addBenchmark('Keyed-Store', keyedStore);
+addBenchmark('Global-Store', globalStore);
+addBenchmark('Computed-Literal-Property', computedLiteralProperty);
+
+var global_value;
+
+function namedStore() {
+  var o = {x: 0};
+  for (var i = 0; i < 1000; ++i) {
+    o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i;
+    o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i;
+    o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i;
+    o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i;
+    o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i;
+    o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i;
+    o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i;
+    o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i;
+    o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i;
+    o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i; o.x = i;
+  }
+}
+
+function keyedLoad() {
+  var a = [1, 2, 3];
+  var k = 1;
+  for (var i = 0; i < 1000; ++i) {
+    a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k];
+    a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k];
+    a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k];
+    a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k];
+    a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k];
+    a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k];
+    a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k];
+    a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k];
+    a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k];
+    a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k]; a[k];
+  }
+}
+
+function keyedStore() {
+  var a = [1, 2, 3];
+  var k = 1;
+  for (var i = 0; i < 1000; ++i) {
+    a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i;
+    a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i;
+    a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i;
+    a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i;
+    a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i;
+    a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i;
+    a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i;
+    a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i;
+    a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i;
+    a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i; a[k] = i;
+  }
+}
+
+function globalStore() {
+  for (var i = 0; i < 1000; ++i) {
+    global_value = i; global_value = i; global_value = i; global_value = i; global_value = i;
+    global_value = i; global_value = i; global_value = i; global_value = i; global_value = i;
+    global_value = i; global_value = i; global_value = i; global_value = i; global_value = i;
+    global_value = i; global_value = i; global_value = i; global_value = i; global_value = i;
+    global_value = i; global_value = i; global_value = i; global_value = i; global_value = i;
+    global_value = i; global_value = i; global_value = i; global_value = i; global_value = i;
+    global_value = i; global_value = i; global_value = i; global_value = i; global_value = i;
+    global_value = i; global_value = i; global_value = i; global_value = i; global_value = i;
+    global_value = i; global_value = i; global_value = i; global_value = i; global_value = i;
+    global_value = i; global_value = i; global_value = i; global_value = i; global_value = i;
+  }
+}
+
+function computedLiteralProperty() {
+  var k = 'x';
+  for (var i = 0; i < 1000; ++i) {
+    ({[k]: i}); ({[k]: i}); ({[k]: i}); ({[k]: i}); ({[k]: i});
+    ({[k]: i}); ({[k]: i}); ({[k]: i}); ({[k]: i}); ({[k]: i});
+    ({[k]: i}); ({[k]: i}); ({[k]: i}); ({[k]: i}); ({[k]: i});
+    ({[k]: i}); ({[k]: i}); ({[k]: i}); ({[k]: i}); ({[k]: i});
+    ({[k]: i}); ({[k]: i}); ({[k]: i}); ({[k]: i}); ({[k]: i});
+    ({[k]: i}); ({[k]: i}); ({[k]: i}); ({[k]: i}); ({[k]: i});
+    ({[k]: i}); ({[k]: i}); ({[k]: i}); ({[k]: i}); ({[k]: i});
+    ({[k]: i}); ({[k]: i}); ({[k]: i}); ({[k]: i}); ({[k]: i});
+    ({[k]: i}); ({[k]: i}); ({[k]: i}); ({[k]: i}); ({[k]: i});
+    ({[k]: i}); ({[k]: i}); ({[k]: i}); ({[k]: i}); ({[k]: i});
+  }
+}
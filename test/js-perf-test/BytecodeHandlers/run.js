@@ -9,6 +9,7 @@ load('compare.js');
 load('string-concat.js');
 load('arithmetic.js');
 load('bitwise.js');
+load('property-access.js');
 
 var success = true;
 
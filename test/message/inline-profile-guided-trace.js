@@ -0,0 +1,49 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --no-always-opt
+// Flags: --turbo-profile-guided-inlining --trace-turbo-inlining-decisions
+// Flags: --max-inlined-nodes-cumulative=100
+
+// The hot call site gets ten times the cumulative budget and is inlined. The
+// cold one gets a quarter of it, which is less than the size of {cold}.
+
+function hot(x) {
+  x = (x * 3 + 1) | 0;
+  x = (x * 5 + 2) | 0;
+  x = (x * 7 + 3) | 0;
+  x = (x * 3 + 4) | 0;
+  x = (x * 5 + 5) | 0;
+  x = (x * 7 + 6) | 0;
+  x = (x * 3 + 7) | 0;
+  x = (x * 5 + 8) | 0;
+  x = (x * 7 + 9) | 0;
+  x = (x * 3 + 10) | 0;
+  return x;
+}
+
+function cold(x) {
+  x = (x * 7 + 1) | 0;
+  x = (x * 5 + 2) | 0;
+  x = (x * 3 + 3) | 0;
+  x = (x * 7 + 4) | 0;
+  x = (x * 5 + 5) | 0;
+  x = (x * 3 + 6) | 0;
+  x = (x * 7 + 7) | 0;
+  x = (x * 5 + 8) | 0;
+  x = (x * 3 + 9) | 0;
+  x = (x * 7 + 10) | 0;
+  return x;
+}
+
+function caller(n, take_cold_path) {
+  var x = 0;
+  for (var i = 0; i < n; ++i) x = hot(x);
+  if (take_cold_path) x = cold(x);
+  return x;
+}
+
+for (var i = 0; i < 4; ++i) caller(10, i == 0);
+%OptimizeFunctionOnNextCall(caller);
+caller(10, false);
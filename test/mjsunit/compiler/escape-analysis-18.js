@@ -0,0 +1,57 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo-escape --turbo-escape-loop-phis
+
+// Test objects that are carried across loop iterations in a phi.
+(function testLoopCarried() {
+  function sum(n) {
+    var p = {x: 0, y: 0};
+    for (var i = 0; i < n; i++) {
+      p = {x: p.x + i, y: p.y + 1};
+    }
+    return p.x + p.y;
+  }
+  assertEquals(55, sum(10));
+  assertEquals(55, sum(10));
+  %OptimizeFunctionOnNextCall(sum);
+  assertEquals(55, sum(10));
+  assertEquals(0, sum(0));
+})();
+
+// Test deoptimization with a loop carried object in a local variable.
+(function testDeoptInLoop() {
+  function sum(n, deopt) {
+    var p = {x: 0, y: 0};
+    for (var i = 0; i < n; i++) {
+      if (i == deopt) %DeoptimizeNow();
+      p = {x: p.x + i, y: p.y + 1};
+    }
+    return p.x + p.y;
+  }
+  assertEquals(55, sum(10, -1));
+  assertEquals(55, sum(10, -1));
+  %OptimizeFunctionOnNextCall(sum);
+  assertEquals(55, sum(10, 5));
+})();
+
+// Test that object identity survives deoptimization when the object that
+// enters the loop is still referenced by another variable.
+(function testDeoptIdentity() {
+  function f(n, deopt) {
+    var init = {x: 0};
+    var p = init;
+    for (var i = 0; i < n; i++) {
+      if (i == deopt) %DeoptimizeNow();
+      if (p === init) p = {x: 1};
+      else p = {x: p.x + 1};
+    }
+    return p === init ? -1 : p.x;
+  }
+  assertEquals(3, f(3, -1));
+  assertEquals(-1, f(0, -1));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals(3, f(3, 0));
+  assertEquals(-1, f(0, 0));
+})();
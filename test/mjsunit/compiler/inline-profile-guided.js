@@ -0,0 +1,89 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --opt --no-always-opt
+// Flags: --turbo-profile-guided-inlining --max-inlined-nodes-cumulative=100
+
+// Returns whether the function that asked for the optimization {status} ran
+// in TurboFan code, i.e. whether it was inlined into an optimized caller.
+function IsInlinedStatus(status) {
+  return (status & V8OptimizationStatus.kTopmostFrameIsTurboFanned) !== 0;
+}
+
+(function TestHotCallSiteIsInlinedAndColdIsNot() {
+  var inlined = {};
+
+  // Both functions are too big to be inlined as small functions. The hot call
+  // site gets ten times the cumulative budget, the cold one a quarter of it,
+  // which is less than the size of {cold}.
+  function hot(x) {
+    inlined.hot = IsInlinedStatus(%GetOptimizationStatus(hot));
+    x = (x * 3 + 1) | 0;
+    x = (x * 5 + 2) | 0;
+    x = (x * 7 + 3) | 0;
+    x = (x * 3 + 4) | 0;
+    x = (x * 5 + 5) | 0;
+    x = (x * 7 + 6) | 0;
+    return x;
+  }
+
+  function cold(x) {
+    inlined.cold = IsInlinedStatus(%GetOptimizationStatus(cold));
+    x = (x * 7 + 1) | 0;
+    x = (x * 5 + 2) | 0;
+    x = (x * 3 + 3) | 0;
+    x = (x * 7 + 4) | 0;
+    x = (x * 5 + 5) | 0;
+    x = (x * 3 + 6) | 0;
+    return x;
+  }
+
+  function caller(n, take_cold_path) {
+    var x = 0;
+    for (var i = 0; i < n; ++i) x = hot(x);
+    if (take_cold_path) x = cold(x);
+    return x;
+  }
+
+  var expected = caller(10, true);
+  for (var i = 1; i < 4; ++i) caller(10, false);
+  %OptimizeFunctionOnNextCall(caller);
+  assertEquals(expected, caller(10, true));
+  assertOptimized(caller);
+  // Other optimization variants make different inlining decisions.
+  if (isTurboFanned(caller) && !isAlwaysOptimize()) {
+    assertTrue(inlined.hot);
+    assertFalse(inlined.cold);
+  }
+})();
+
+(function TestPolymorphicCallSite() {
+  function A() {}
+  A.prototype.handle = function(x) { return x + 1; };
+  function B() {}
+  B.prototype.handle = function(x) { return x + 2; };
+  function C() {}
+  C.prototype.handle = function(x) { return x + 3; };
+  function D() {}
+  D.prototype.handle = function(x) { return x + 4; };
+
+  function cold(x) { return x * 2; }
+
+  function route(handlers, n) {
+    var result = 0;
+    for (var i = 0; i < n; ++i) {
+      result = handlers[i % handlers.length].handle(result);
+    }
+    if (result < 0) result = cold(result);
+    return result;
+  }
+
+  var handlers = [new A(), new B(), new C(), new D()];
+  assertEquals(10, route(handlers, 4));
+  assertEquals(20, route(handlers, 8));
+  %OptimizeFunctionOnNextCall(route);
+  assertEquals(30, route(handlers, 12));
+  assertOptimized(route);
+  assertEquals(-2, cold(-1));
+})();
@@ -0,0 +1,94 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo-loop-vectorization
+
+function Fill(array, start) {
+  for (var i = 0; i < array.length; ++i) array[i] = start + i * 7;
+  return array;
+}
+
+function ExpectedSum(a, b, n) {
+  var expected = [];
+  for (var i = 0; i < n; ++i) expected.push((a[i] + b[i]) | 0);
+  return expected;
+}
+
+(function TestRemainderLoop() {
+  function add(a, b, c, n) {
+    for (var i = 0; i < n; ++i) c[i] = a[i] + b[i];
+  }
+  var a = Fill(new Int32Array(10), 1);
+  var b = Fill(new Int32Array(10), 100);
+  for (var n of [8, 10]) {
+    var c = new Int32Array(10);
+    add(a, b, c, n);
+    %OptimizeFunctionOnNextCall(add);
+    c = new Int32Array(10);
+    add(a, b, c, n);
+    assertEquals(ExpectedSum(a, b, n), Array.from(c.subarray(0, n)));
+    for (var i = n; i < 10; ++i) assertEquals(0, c[i]);
+  }
+})();
+
+(function TestShorterThanVector() {
+  function add(a, b, c, n) {
+    for (var i = 0; i < n; ++i) c[i] = a[i] ^ b[i];
+  }
+  for (var n = 0; n < 4; ++n) {
+    var a = Fill(new Int32Array(n), 3);
+    var b = Fill(new Int32Array(n), -50);
+    var c = new Int32Array(n);
+    add(a, b, c, n);
+    %OptimizeFunctionOnNextCall(add);
+    c = new Int32Array(n);
+    add(a, b, c, n);
+    for (var i = 0; i < n; ++i) assertEquals(a[i] ^ b[i], c[i]);
+  }
+})();
+
+(function TestStartIndex() {
+  function add(a, b, c, start, n) {
+    for (var i = start; i < n; ++i) c[i] = a[i] - b[i];
+  }
+  var a = Fill(new Int32Array(13), 1000);
+  var b = Fill(new Int32Array(13), 5);
+  for (var start of [3, 0, -2, -5]) {
+    var c = new Int32Array(13);
+    add(a, b, c, start, 13);
+    %OptimizeFunctionOnNextCall(add);
+    c = new Int32Array(13);
+    add(a, b, c, start, 13);
+    for (var i = 0; i < 13; ++i) {
+      assertEquals(i < start ? 0 : a[i] - b[i], c[i]);
+    }
+  }
+})();
+
+(function TestOverlappingSubarrays() {
+  function inc(a, c, n) {
+    for (var i = 0; i < n; ++i) c[i] = a[i] + 1;
+  }
+  // Each store feeds the load of a later iteration when the stored elements
+  // are less than a vector behind the loaded ones, so only the scalar loop
+  // gives the right result.
+  for (var shift = 1; shift < 8; ++shift) {
+    var buffer = new Int32Array(32);
+    inc(buffer.subarray(0, 16), buffer.subarray(shift, shift + 16), 16);
+    %OptimizeFunctionOnNextCall(inc);
+    buffer = new Int32Array(32);
+    inc(buffer.subarray(0, 16), buffer.subarray(shift, shift + 16), 16);
+    for (var i = 0; i < shift + 16; ++i) {
+      assertEquals(Math.floor(i / shift), buffer[i]);
+    }
+  }
+  // Storing in front of the loaded elements is fine.
+  var buffer = Fill(new Int32Array(20), 0);
+  inc(buffer.subarray(2, 18), buffer.subarray(0, 16), 16);
+  %OptimizeFunctionOnNextCall(inc);
+  buffer = Fill(new Int32Array(20), 0);
+  inc(buffer.subarray(2, 18), buffer.subarray(0, 16), 16);
+  for (var i = 0; i < 16; ++i) assertEquals((i + 2) * 7 + 1, buffer[i]);
+  for (var i = 16; i < 20; ++i) assertEquals(i * 7, buffer[i]);
+})();
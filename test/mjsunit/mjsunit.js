@@ -134,7 +134,8 @@ var V8OptimizationStatus = {
   kMaybeDeopted: 1 << 3,
   kOptimized: 1 << 4,
   kTurboFanned: 1 << 5,
-  kInterpreted: 1 << 6
+  kInterpreted: 1 << 6,
+  kTopmostFrameIsTurboFanned: 1 << 7
 };
 
 // Returns true if --no-opt mode is on.
@@ -35,6 +35,24 @@ TEST(OS, GetCurrentProcessId) {
 #endif
 }
 
+#if V8_OS_LINUX
+TEST(OS, DiscardSystemPages) {
+  const size_t page_size = static_cast<size_t>(OS::CommitPageSize());
+  const size_t size = 4 * page_size;
+  size_t actual = 0;
+  char* base = static_cast<char*>(OS::Allocate(size, &actual, false));
+  ASSERT_NE(nullptr, base);
+  ASSERT_GE(actual, size);
+  for (size_t i = 0; i < size; i++) base[i] = 0x42;
+  // Discard the two pages in the middle; their contents read back as zero.
+  OS::DiscardSystemPages(base + page_size, 2 * page_size);
+  EXPECT_EQ(0x42, base[page_size - 1]);
+  for (size_t i = page_size; i < 3 * page_size; i++) EXPECT_EQ(0, base[i]);
+  EXPECT_EQ(0x42, base[3 * page_size]);
+  OS::Free(base, actual);
+}
+#endif  // V8_OS_LINUX
+
 
 namespace {
 
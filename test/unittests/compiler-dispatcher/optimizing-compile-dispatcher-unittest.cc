@@ -4,7 +4,10 @@
 
 #include "src/compiler-dispatcher/optimizing-compile-dispatcher.h"
 
+#include <vector>
+
 #include "src/base/atomic-utils.h"
+#include "src/base/platform/platform.h"
 #include "src/base/platform/semaphore.h"
 #include "src/compilation-info.h"
 #include "src/compiler.h"
@@ -61,6 +64,43 @@ class BlockingCompilationJob : public CompilationJob {
   DISALLOW_COPY_AND_ASSIGN(BlockingCompilationJob);
 };
 
+class RecordingCompilationJob : public CompilationJob {
+ public:
+  RecordingCompilationJob(Isolate* isolate, Handle<JSFunction> function,
+                          int id, std::vector<int>* order, base::Mutex* mutex)
+      : CompilationJob(isolate, &info_, "RecordingCompilationJob",
+                       State::kReadyToExecute),
+        parse_info_(handle(function->shared())),
+        info_(parse_info_.zone(), &parse_info_, function->GetIsolate(),
+              function),
+        id_(id),
+        order_(order),
+        mutex_(mutex) {}
+  ~RecordingCompilationJob() override = default;
+
+  // CompilationJob implementation.
+  Status PrepareJobImpl() override {
+    UNREACHABLE();
+  }
+
+  Status ExecuteJobImpl() override {
+    base::LockGuard<base::Mutex> guard(mutex_);
+    order_->push_back(id_);
+    return SUCCEEDED;
+  }
+
+  Status FinalizeJobImpl() override { return SUCCEEDED; }
+
+ private:
+  ParseInfo parse_info_;
+  CompilationInfo info_;
+  int id_;
+  std::vector<int>* order_;
+  base::Mutex* mutex_;
+
+  DISALLOW_COPY_AND_ASSIGN(RecordingCompilationJob);
+};
+
 }  // namespace
 
 TEST_F(OptimizingCompileDispatcherTest, Construct) {
@@ -91,5 +131,125 @@ TEST_F(OptimizingCompileDispatcherTest, NonBlockingFlush) {
   dispatcher.Stop();
 }
 
+TEST_F(OptimizingCompileDispatcherTest, PriorityOrder) {
+  bool old_block = FLAG_block_concurrent_recompilation;
+  int old_max_threads = FLAG_concurrent_recompilation_max_threads;
+  int old_queue_length = FLAG_concurrent_recompilation_queue_length;
+  FLAG_block_concurrent_recompilation = true;
+  FLAG_concurrent_recompilation_max_threads = 1;
+  FLAG_concurrent_recompilation_queue_length = 5;
+  Handle<JSFunction> fun = Handle<JSFunction>::cast(test::RunJS(
+      isolate(), "function f() { function g() {}; return g;}; f();"));
+
+  OptimizingCompileDispatcher dispatcher(i_isolate());
+  std::vector<int> order;
+  base::Mutex mutex;
+  const int kPriorities[] = {1, 5, 3, 5, 0};
+  const int kJobs = arraysize(kPriorities);
+  for (int i = 0; i < kJobs; i++) {
+    ASSERT_TRUE(dispatcher.IsQueueAvailable());
+    dispatcher.QueueForOptimization(
+        new RecordingCompilationJob(i_isolate(), fun, i, &order, &mutex),
+        kPriorities[i]);
+  }
+  ASSERT_FALSE(dispatcher.IsQueueAvailable());
+
+  // A single task works through the jobs, hottest first and in FIFO order
+  // among jobs with the same priority.
+  dispatcher.Unblock();
+  for (;;) {
+    base::LockGuard<base::Mutex> guard(&mutex);
+    if (static_cast<int>(order.size()) == kJobs) break;
+  }
+  const int kExpectedOrder[] = {1, 3, 2, 0, 4};
+  for (int i = 0; i < kJobs; i++) {
+    EXPECT_EQ(kExpectedOrder[i], order[i]);
+  }
+  dispatcher.Stop();
+
+  FLAG_block_concurrent_recompilation = old_block;
+  FLAG_concurrent_recompilation_max_threads = old_max_threads;
+  FLAG_concurrent_recompilation_queue_length = old_queue_length;
+}
+
+TEST_F(OptimizingCompileDispatcherTest, HotnessOrder) {
+  bool old_block = FLAG_block_concurrent_recompilation;
+  int old_max_threads = FLAG_concurrent_recompilation_max_threads;
+  FLAG_block_concurrent_recompilation = true;
+  FLAG_concurrent_recompilation_max_threads = 1;
+  Handle<JSFunction> fun = Handle<JSFunction>::cast(test::RunJS(
+      isolate(), "function f() { function g() {}; return g;}; f();"));
+
+  OptimizingCompileDispatcher dispatcher(i_isolate());
+  std::vector<int> order;
+  base::Mutex mutex;
+  // The profiler ticks recorded on the compilation info when the
+  // optimization was requested.
+  const int kTicks[] = {2, 0, 7, 3};
+  const int kJobs = arraysize(kTicks);
+  for (int i = 0; i < kJobs; i++) {
+    CompilationJob* job =
+        new RecordingCompilationJob(i_isolate(), fun, i, &order, &mutex);
+    job->info()->set_profiler_ticks(kTicks[i]);
+    dispatcher.QueueForOptimization(
+        job, OptimizingCompileDispatcher::HotnessPriority(job->info()));
+  }
+
+  dispatcher.Unblock();
+  for (;;) {
+    base::LockGuard<base::Mutex> guard(&mutex);
+    if (static_cast<int>(order.size()) == kJobs) break;
+  }
+  const int kExpectedOrder[] = {2, 3, 0, 1};
+  for (int i = 0; i < kJobs; i++) {
+    EXPECT_EQ(kExpectedOrder[i], order[i]);
+  }
+  dispatcher.Stop();
+
+  FLAG_block_concurrent_recompilation = old_block;
+  FLAG_concurrent_recompilation_max_threads = old_max_threads;
+}
+
+TEST_F(OptimizingCompileDispatcherTest, BlockedJobsWaitForUnblock) {
+  bool old_block = FLAG_block_concurrent_recompilation;
+  int old_max_threads = FLAG_concurrent_recompilation_max_threads;
+  FLAG_block_concurrent_recompilation = false;
+  FLAG_concurrent_recompilation_max_threads = 1;
+  Handle<JSFunction> fun = Handle<JSFunction>::cast(test::RunJS(
+      isolate(), "function f() { function g() {}; return g;}; f();"));
+
+  OptimizingCompileDispatcher dispatcher(i_isolate());
+  std::vector<int> order;
+  base::Mutex mutex;
+
+  // Keep a compile task busy with a job queued before blocking.
+  BlockingCompilationJob* running =
+      new BlockingCompilationJob(i_isolate(), fun);
+  dispatcher.QueueForOptimization(running);
+  while (!running->IsBlocking()) {
+  }
+
+  // The busy task must not pick up a job queued while blocking.
+  FLAG_block_concurrent_recompilation = true;
+  dispatcher.QueueForOptimization(
+      new RecordingCompilationJob(i_isolate(), fun, 0, &order, &mutex));
+  running->Signal();
+  base::OS::Sleep(base::TimeDelta::FromMilliseconds(100));
+  {
+    base::LockGuard<base::Mutex> guard(&mutex);
+    EXPECT_TRUE(order.empty());
+  }
+
+  dispatcher.Unblock();
+  for (;;) {
+    base::LockGuard<base::Mutex> guard(&mutex);
+    if (!order.empty()) break;
+  }
+  dispatcher.Stop();
+
+  FLAG_block_concurrent_recompilation = old_block;
+  FLAG_concurrent_recompilation_max_threads = old_max_threads;
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -518,6 +518,150 @@ TEST_F(EscapeAnalysisTest, DISABLED_DeoptReplacementIdentity) {
   ASSERT_EQ(object_state, object_state2);
 }
 
+class EscapeAnalysisObjectPhiTest : public EscapeAnalysisTest {
+ public:
+  EscapeAnalysisObjectPhiTest() : old_flag_(FLAG_turbo_escape_loop_phis) {
+    FLAG_turbo_escape_loop_phis = true;
+  }
+  ~EscapeAnalysisObjectPhiTest() { FLAG_turbo_escape_loop_phis = old_flag_; }
+
+ private:
+  bool old_flag_;
+};
+
+
+TEST_F(EscapeAnalysisObjectPhiTest, BranchObjectPhiNonEscape) {
+  Node* object1 = Constant(1);
+  Node* object2 = Constant(2);
+  Branch();
+  Node* ifFalse = IfFalse();
+  Node* ifTrue = IfTrue();
+  Node* begin1 = BeginRegion(start());
+  Node* allocation1 = Allocate(Constant(kPointerSize), begin1, ifFalse);
+  Store(FieldAccessAtIndex(0), allocation1, object1, allocation1, ifFalse);
+  Node* finish1 = FinishRegion(allocation1);
+  Node* begin2 = BeginRegion(start());
+  Node* allocation2 = Allocate(Constant(kPointerSize), begin2, ifTrue);
+  Store(FieldAccessAtIndex(0), allocation2, object2, allocation2, ifTrue);
+  Node* finish2 = FinishRegion(allocation2);
+  Node* merge = Merge2(ifFalse, ifTrue);
+  Node* effect_phi =
+      graph()->NewNode(common()->EffectPhi(2), finish1, finish2, merge);
+  Node* phi =
+      graph()->NewNode(common()->Phi(MachineRepresentation::kTagged, 2),
+                       finish1, finish2, merge);
+  Node* load = Load(FieldAccessAtIndex(0), phi, effect_phi, merge);
+  Node* result = Return(load, effect_phi);
+  EndGraph();
+
+  Analysis();
+
+  ExpectVirtual(allocation1);
+  ExpectVirtual(allocation2);
+  EXPECT_TRUE(escape_analysis()->IsVirtual(phi));
+  ExpectReplacementPhi(load, object1, object2);
+  Node* replacement_phi = escape_analysis()->GetReplacement(load);
+
+  Transformation();
+
+  ASSERT_EQ(replacement_phi, NodeProperties::GetValueInput(result, 1));
+}
+
+
+TEST_F(EscapeAnalysisObjectPhiTest, BranchObjectPhiEscapeThroughStore) {
+  Node* object1 = Constant(1);
+  Node* object2 = Constant(2);
+  Branch();
+  Node* ifFalse = IfFalse();
+  Node* ifTrue = IfTrue();
+  Node* begin1 = BeginRegion(start());
+  Node* allocation1 = Allocate(Constant(kPointerSize), begin1, ifFalse);
+  Store(FieldAccessAtIndex(0), allocation1, object1, allocation1, ifFalse);
+  Node* finish1 = FinishRegion(allocation1);
+  Node* begin2 = BeginRegion(start());
+  Node* allocation2 = Allocate(Constant(kPointerSize), begin2, ifTrue);
+  Store(FieldAccessAtIndex(0), allocation2, object2, allocation2, ifTrue);
+  Node* finish2 = FinishRegion(allocation2);
+  Node* merge = Merge2(ifFalse, ifTrue);
+  Node* effect_phi =
+      graph()->NewNode(common()->EffectPhi(2), finish1, finish2, merge);
+  Node* phi =
+      graph()->NewNode(common()->Phi(MachineRepresentation::kTagged, 2),
+                       finish1, finish2, merge);
+  Node* store = Store(FieldAccessAtIndex(0), phi, object1, effect_phi, merge);
+  Node* load = Load(FieldAccessAtIndex(0), phi, store, merge);
+  Node* result = Return(load, store);
+  EndGraph();
+
+  Analysis();
+
+  ExpectEscaped(allocation1);
+  ExpectEscaped(allocation2);
+  ExpectReplacement(load, nullptr);
+
+  Transformation();
+
+  ASSERT_EQ(load, NodeProperties::GetValueInput(result, 1));
+}
+
+
+TEST_F(EscapeAnalysisObjectPhiTest, LoopObjectPhiDeoptReplacement) {
+  Node* object1 = Constant(1);
+  Node* object2 = Constant(2);
+  BeginRegion();
+  Node* allocation0 = Allocate(Constant(kPointerSize));
+  Store(FieldAccessAtIndex(0), allocation0, object1);
+  Node* finish0 = FinishRegion(allocation0);
+  Node* loop = graph()->NewNode(common()->Loop(2), control(), control());
+  Node* effect_phi =
+      graph()->NewNode(common()->EffectPhi(2), finish0, finish0, loop);
+  Node* phi =
+      graph()->NewNode(common()->Phi(MachineRepresentation::kTagged, 2),
+                       finish0, finish0, loop);
+  Node* state_values1 = graph()->NewNode(
+      common()->StateValues(1, SparseInputMask::Dense()), phi);
+  Node* state_values2 =
+      graph()->NewNode(common()->StateValues(0, SparseInputMask::Dense()));
+  Node* state_values3 =
+      graph()->NewNode(common()->StateValues(0, SparseInputMask::Dense()));
+  Node* frame_state = graph()->NewNode(
+      common()->FrameState(BailoutId::None(), OutputFrameStateCombine::Ignore(),
+                           nullptr),
+      state_values1, state_values2, state_values3, UndefinedConstant(),
+      graph()->start(), graph()->start());
+  Node* checkpoint = graph()->NewNode(common()->Checkpoint(), frame_state,
+                                      effect_phi, loop);
+  Node* load = Load(FieldAccessAtIndex(0), phi, checkpoint, loop);
+  BeginRegion(checkpoint);
+  Node* allocation1 = Allocate(Constant(kPointerSize), nullptr, loop);
+  Store(FieldAccessAtIndex(0), allocation1, object2, nullptr, loop);
+  Node* finish1 = FinishRegion(allocation1);
+  Node* branch = graph()->NewNode(common()->Branch(), Constant(0), loop);
+  Node* ifTrue = graph()->NewNode(common()->IfTrue(), branch);
+  Node* ifFalse = graph()->NewNode(common()->IfFalse(), branch);
+  loop->ReplaceInput(1, ifTrue);
+  effect_phi->ReplaceInput(1, finish1);
+  phi->ReplaceInput(1, finish1);
+  Node* result = Return(load, finish1, ifFalse);
+  EndGraph();
+
+  Analysis();
+
+  ExpectVirtual(allocation0);
+  ExpectVirtual(allocation1);
+  EXPECT_TRUE(escape_analysis()->IsVirtual(phi));
+  ExpectReplacementPhi(load, object1, object2);
+  Node* replacement_phi = escape_analysis()->GetReplacement(load);
+
+  Transformation();
+
+  ASSERT_EQ(replacement_phi, NodeProperties::GetValueInput(result, 1));
+  Node* object_state = NodeProperties::GetValueInput(state_values1, 0);
+  ASSERT_EQ(object_state->opcode(), IrOpcode::kObjectState);
+  ASSERT_EQ(1, object_state->op()->ValueInputCount());
+  ASSERT_EQ(replacement_phi, NodeProperties::GetValueInput(object_state, 0));
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
@@ -0,0 +1,101 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/instruction-scheduler.h"
+#include "src/compiler/instruction.h"
+#include "test/unittests/test-utils.h"
+#include "testing/gtest-support.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class InstructionSchedulerTest : public TestWithZone {
+ public:
+  InstructionSchedulerTest() {}
+  ~InstructionSchedulerTest() override {}
+
+ protected:
+  // Creates an instruction with one register output and no inputs.
+  Instruction* NewInstruction(InstructionCode opcode) {
+    InstructionOperand output =
+        UnallocatedOperand(UnallocatedOperand::MUST_HAVE_REGISTER, 0);
+    return Instruction::New(zone(), opcode, 1, &output, 0, nullptr, 0,
+                            nullptr);
+  }
+
+  int Latency(InstructionCode opcode, int model) {
+    return InstructionScheduler::GetInstructionLatency(NewInstruction(opcode),
+                                                       model);
+  }
+};
+
+TEST_F(InstructionSchedulerTest, LatencyModels) {
+  if (!InstructionScheduler::SchedulerSupported()) return;
+  int count = InstructionScheduler::LatencyModelCount();
+  EXPECT_LE(1, count);
+  EXPECT_LE(0, InstructionScheduler::HostLatencyModel());
+  EXPECT_GT(count, InstructionScheduler::HostLatencyModel());
+  for (int model = 0; model < count; ++model) {
+    EXPECT_LE(1, InstructionScheduler::GetIssueWidth(model));
+    EXPECT_LE(1, Latency(kArchNop, model));
+#if V8_TARGET_ARCH_X64
+    EXPECT_EQ(1, Latency(kX64Add, model));
+    EXPECT_LT(Latency(kX64Add, model), Latency(kX64Imul, model));
+    EXPECT_LT(Latency(kX64Imul, model), Latency(kX64Idiv, model));
+    EXPECT_LT(Latency(kSSEFloat64Add, model), Latency(kSSEFloat64Div, model));
+    EXPECT_LE(Latency(kX64Movq, model),
+              Latency(kX64Movq | AddressingModeField::encode(kMode_MR),
+                      model));
+#elif V8_TARGET_ARCH_ARM64
+    EXPECT_EQ(1, Latency(kArm64Add, model));
+    EXPECT_LT(Latency(kArm64Add, model), Latency(kArm64Mul, model));
+    EXPECT_LT(Latency(kArm64Mul32, model), Latency(kArm64Idiv32, model));
+    EXPECT_LE(Latency(kArm64Idiv32, model), Latency(kArm64Idiv, model));
+    EXPECT_LT(Latency(kArm64Float64Add, model),
+              Latency(kArm64Float64Div, model));
+#endif
+  }
+}
+
+// The generic model is used for snapshots and keeps the empirical latencies
+// that were used before per-core models existed.
+TEST_F(InstructionSchedulerTest, GenericLatencyModel) {
+  if (!InstructionScheduler::SchedulerSupported()) return;
+  const int model = InstructionScheduler::kGenericLatencyModel;
+  EXPECT_EQ(1, InstructionScheduler::GetIssueWidth(model));
+#if V8_TARGET_ARCH_X64
+  EXPECT_EQ(1, Latency(kX64Add, model));
+  EXPECT_EQ(1, Latency(kX64Add | AddressingModeField::encode(kMode_MR),
+                       model));
+  EXPECT_EQ(1, Latency(kX64Movq, model));
+  EXPECT_EQ(1, Latency(kX64Movq | AddressingModeField::encode(kMode_MR),
+                       model));
+  EXPECT_EQ(3, Latency(kX64Imul, model));
+  EXPECT_EQ(49, Latency(kX64Idiv, model));
+  EXPECT_EQ(35, Latency(kX64Idiv32, model));
+  EXPECT_EQ(3, Latency(kSSEFloat64Add, model));
+  EXPECT_EQ(4, Latency(kSSEFloat32Mul, model));
+  EXPECT_EQ(5, Latency(kSSEFloat64Mul, model));
+  EXPECT_EQ(13, Latency(kSSEFloat64Div, model));
+  EXPECT_EQ(1, Latency(kAVXFloat64Add, model));
+  EXPECT_EQ(1, Latency(kAVXFloat64Div, model));
+  EXPECT_EQ(50, Latency(kSSEFloat64Mod, model));
+#elif V8_TARGET_ARCH_ARM64
+  EXPECT_EQ(1, Latency(kArm64Add, model));
+  EXPECT_EQ(3, Latency(kArm64Add | AddressingModeField::encode(
+                                       kMode_Operand2_R_LSL_I),
+                       model));
+  EXPECT_EQ(11, Latency(kArm64Ldr, model));
+  EXPECT_EQ(3, Latency(kArm64Mul32, model));
+  EXPECT_EQ(5, Latency(kArm64Mul, model));
+  EXPECT_EQ(12, Latency(kArm64Idiv32, model));
+  EXPECT_EQ(20, Latency(kArm64Idiv, model));
+  EXPECT_EQ(5, Latency(kArm64Float64Add, model));
+#endif
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
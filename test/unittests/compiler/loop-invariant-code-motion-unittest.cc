@@ -0,0 +1,174 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/loop-invariant-code-motion.h"
+#include "src/compiler/access-builder.h"
+#include "src/compiler/js-graph.h"
+#include "src/compiler/loop-analysis.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/simplified-operator.h"
+#include "test/unittests/compiler/graph-unittest.h"
+#include "test/unittests/compiler/node-test-utils.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class LoopInvariantCodeMotionTest : public TypedGraphTest {
+ public:
+  LoopInvariantCodeMotionTest()
+      : TypedGraphTest(3),
+        simplified_(zone()),
+        jsgraph_(isolate(), graph(), common(), nullptr, simplified(), nullptr) {
+  }
+  ~LoopInvariantCodeMotionTest() override {}
+
+ protected:
+  void Run() {
+    LoopTree* loop_tree = LoopFinder::BuildLoopTree(graph(), zone());
+    LoopInvariantCodeMotion licm(jsgraph(), loop_tree, zone());
+    licm.Run();
+  }
+
+  Node* Return(Node* value, Node* effect, Node* control) {
+    Node* zero = graph()->NewNode(common()->Int32Constant(0));
+    Node* ret =
+        graph()->NewNode(common()->Return(), zero, value, effect, control);
+    graph()->SetEnd(graph()->NewNode(common()->End(1), ret));
+    return ret;
+  }
+
+  JSGraph* jsgraph() { return &jsgraph_; }
+  SimplifiedOperatorBuilder* simplified() { return &simplified_; }
+
+ private:
+  SimplifiedOperatorBuilder simplified_;
+  JSGraph jsgraph_;
+};
+
+TEST_F(LoopInvariantCodeMotionTest, HoistCheckMapsAndLoadField) {
+  Node* object = Parameter(Type::Any(), 0);
+  Node* condition = Parameter(Type::Boolean(), 1);
+  Node* entry = graph()->NewNode(common()->Checkpoint(), EmptyFrameState(),
+                                 graph()->start(), graph()->start());
+  ZoneHandleSet<Map> maps(factory()->fixed_array_map());
+
+  Node* loop =
+      graph()->NewNode(common()->Loop(2), graph()->start(), graph()->start());
+  Node* effect_phi =
+      graph()->NewNode(common()->EffectPhi(2), entry, entry, loop);
+  Node* check =
+      graph()->NewNode(simplified()->CheckMaps(CheckMapsFlag::kNone, maps),
+                       object, effect_phi, loop);
+  Node* load = graph()->NewNode(
+      simplified()->LoadField(AccessBuilder::ForJSArrayLength(FAST_ELEMENTS)),
+      object, check, loop);
+  Node* branch = graph()->NewNode(common()->Branch(), condition, loop);
+  Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+  Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+  loop->ReplaceInput(1, if_true);
+  effect_phi->ReplaceInput(1, load);
+  Node* ret = Return(load, load, if_false);
+
+  Run();
+
+  // Both nodes are now on the effect chain into the loop, behind a fresh
+  // checkpoint that deoptimizes to the state before the loop.
+  EXPECT_EQ(load, effect_phi->InputAt(0));
+  EXPECT_EQ(effect_phi, effect_phi->InputAt(1));
+  EXPECT_EQ(effect_phi, NodeProperties::GetEffectInput(ret));
+  EXPECT_EQ(check, NodeProperties::GetEffectInput(load));
+  EXPECT_EQ(graph()->start(), NodeProperties::GetControlInput(load));
+  EXPECT_EQ(graph()->start(), NodeProperties::GetControlInput(check));
+  Node* checkpoint = NodeProperties::GetEffectInput(check);
+  EXPECT_EQ(IrOpcode::kCheckpoint, checkpoint->opcode());
+  EXPECT_EQ(entry, NodeProperties::GetEffectInput(checkpoint));
+  EXPECT_EQ(NodeProperties::GetFrameStateInput(entry),
+            NodeProperties::GetFrameStateInput(checkpoint));
+}
+
+TEST_F(LoopInvariantCodeMotionTest, DontHoistAcrossFieldStores) {
+  Node* object = Parameter(Type::Any(), 0);
+  Node* condition = Parameter(Type::Boolean(), 1);
+  Node* entry = graph()->NewNode(common()->Checkpoint(), EmptyFrameState(),
+                                 graph()->start(), graph()->start());
+  FieldAccess const access = AccessBuilder::ForJSArrayLength(FAST_ELEMENTS);
+
+  Node* loop =
+      graph()->NewNode(common()->Loop(2), graph()->start(), graph()->start());
+  Node* effect_phi =
+      graph()->NewNode(common()->EffectPhi(2), entry, entry, loop);
+  Node* load = graph()->NewNode(simplified()->LoadField(access), object,
+                                effect_phi, loop);
+  Node* store = graph()->NewNode(simplified()->StoreField(access), object,
+                                 load, load, loop);
+  Node* branch = graph()->NewNode(common()->Branch(), condition, loop);
+  Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+  Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+  loop->ReplaceInput(1, if_true);
+  effect_phi->ReplaceInput(1, store);
+  Return(load, store, if_false);
+
+  Run();
+
+  EXPECT_EQ(entry, effect_phi->InputAt(0));
+  EXPECT_EQ(effect_phi, NodeProperties::GetEffectInput(load));
+  EXPECT_EQ(loop, NodeProperties::GetControlInput(load));
+}
+
+TEST_F(LoopInvariantCodeMotionTest, EliminateCheckBoundsAfterLessThan) {
+  Node* index = Parameter(Type::UnsignedSmall(), 0);
+  Node* length = Parameter(Type::UnsignedSmall(), 1);
+
+  Node* loop =
+      graph()->NewNode(common()->Loop(2), graph()->start(), graph()->start());
+  Node* effect_phi = graph()->NewNode(common()->EffectPhi(2), graph()->start(),
+                                      graph()->start(), loop);
+  Node* condition =
+      graph()->NewNode(simplified()->NumberLessThan(), index, length);
+  Node* branch = graph()->NewNode(common()->Branch(), condition, loop);
+  Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+  Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+  Node* check = graph()->NewNode(simplified()->CheckBounds(), index, length,
+                                 effect_phi, if_true);
+  NodeProperties::SetType(check, Type::Range(0.0, 10.0, zone()));
+  loop->ReplaceInput(1, if_true);
+  effect_phi->ReplaceInput(1, check);
+  Node* ret = Return(check, effect_phi, if_false);
+
+  Run();
+
+  EXPECT_THAT(NodeProperties::GetValueInput(ret, 1),
+              IsTypeGuard(index, if_true));
+  EXPECT_EQ(effect_phi, effect_phi->InputAt(1));
+}
+
+TEST_F(LoopInvariantCodeMotionTest, KeepCheckBoundsWithoutLessThan) {
+  Node* index = Parameter(Type::UnsignedSmall(), 0);
+  Node* length = Parameter(Type::UnsignedSmall(), 1);
+  Node* condition = Parameter(Type::Boolean(), 2);
+
+  Node* loop =
+      graph()->NewNode(common()->Loop(2), graph()->start(), graph()->start());
+  Node* effect_phi = graph()->NewNode(common()->EffectPhi(2), graph()->start(),
+                                      graph()->start(), loop);
+  Node* branch = graph()->NewNode(common()->Branch(), condition, loop);
+  Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+  Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+  Node* check = graph()->NewNode(simplified()->CheckBounds(), index, length,
+                                 effect_phi, if_true);
+  NodeProperties::SetType(check, Type::Range(0.0, 10.0, zone()));
+  loop->ReplaceInput(1, if_true);
+  effect_phi->ReplaceInput(1, check);
+  Node* ret = Return(check, effect_phi, if_false);
+
+  Run();
+
+  EXPECT_EQ(check, NodeProperties::GetValueInput(ret, 1));
+  EXPECT_EQ(check, effect_phi->InputAt(1));
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,222 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/loop-vectorizer.h"
+#include "src/compiler/access-builder.h"
+#include "src/compiler/js-graph.h"
+#include "src/compiler/linkage.h"
+#include "src/compiler/loop-analysis.h"
+#include "src/compiler/machine-operator.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/simplified-operator.h"
+#include "test/unittests/compiler/graph-unittest.h"
+#include "test/unittests/compiler/node-test-utils.h"
+
+using testing::_;
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class LoopVectorizerTest : public GraphTest {
+ public:
+  LoopVectorizerTest()
+      : GraphTest(4),
+        machine_(zone()),
+        simplified_(zone()),
+        jsgraph_(isolate(), graph(), common(), nullptr, simplified(),
+                 machine()) {}
+  ~LoopVectorizerTest() override {}
+
+ protected:
+  // Builds the machine graph of
+  //
+  //   for (i = 0; i < n; ++i) c[i] = a[i] op b[i];
+  //
+  // for off-heap Int32Arrays a, b and c, and returns the loop. With
+  // |stack_check|, the loop header contains a lowered stack check.
+  Node* BuildLoop(const Operator* op, bool stack_check = false) {
+    ElementAccess const access =
+        AccessBuilder::ForTypedArrayElement(kExternalInt32Array, true);
+    a_ = Parameter(0);
+    b_ = Parameter(1);
+    c_ = Parameter(2);
+    Node* n = Parameter(3);
+
+    Node* loop = graph()->NewNode(common()->Loop(2), start(), start());
+    Node* effect_phi =
+        graph()->NewNode(common()->EffectPhi(2), start(), start(), loop);
+    Node* i = graph()->NewNode(common()->Phi(MachineRepresentation::kWord32, 2),
+                               Int32Constant(0), Int32Constant(0), loop);
+    Node* header = loop;
+    Node* header_effect = effect_phi;
+    if (stack_check) BuildStackCheck(i, &header_effect, &header);
+    Node* branch = graph()->NewNode(
+        common()->Branch(), graph()->NewNode(machine()->Int32LessThan(), i, n),
+        header);
+    Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+    Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+    Node* load_a = graph()->NewNode(simplified()->LoadElement(access), a_, i,
+                                    header_effect, if_true);
+    Node* load_b = graph()->NewNode(simplified()->LoadElement(access), b_, i,
+                                    load_a, if_true);
+    Node* value = graph()->NewNode(op, load_a, load_b);
+    Node* store = graph()->NewNode(simplified()->StoreElement(access), c_, i,
+                                   value, load_b, if_true);
+    i->ReplaceInput(
+        1, graph()->NewNode(machine()->Int32Add(), i, Int32Constant(1)));
+    loop->ReplaceInput(1, if_true);
+    effect_phi->ReplaceInput(1, store);
+
+    Node* ret = graph()->NewNode(common()->Return(), Int32Constant(0), i,
+                                 effect_phi, if_false);
+    graph()->SetEnd(graph()->NewNode(common()->End(1), ret));
+    return loop;
+  }
+
+  // Builds the lowered stack check of a loop whose frame state refers to the
+  // induction variable |i|.
+  void BuildStackCheck(Node* i, Node** effect, Node** control) {
+    Node* limit = *effect = graph()->NewNode(
+        machine()->Load(MachineType::Pointer()),
+        jsgraph()->ExternalConstant(
+            ExternalReference::address_of_stack_limit(isolate())),
+        jsgraph()->IntPtrConstant(0), *effect, *control);
+    Node* check =
+        graph()->NewNode(machine()->UintLessThan(), limit,
+                         graph()->NewNode(machine()->LoadStackPointer()));
+    Node* branch = graph()->NewNode(common()->Branch(BranchHint::kTrue), check,
+                                    *control);
+    Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+    Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+
+    Node* locals = graph()->NewNode(
+        common()->StateValues(1, SparseInputMask::Dense()), i);
+    Node* empty =
+        graph()->NewNode(common()->StateValues(0, SparseInputMask::Dense()));
+    Node* frame_state = graph()->NewNode(
+        common()->FrameState(BailoutId(0), OutputFrameStateCombine::Ignore(),
+                             nullptr),
+        empty, locals, empty, NumberConstant(0), UndefinedConstant(),
+        graph()->start());
+    CallDescriptor* descriptor = Linkage::GetRuntimeCallDescriptor(
+        zone(), Runtime::kStackGuard, 0, Operator::kNoWrite,
+        CallDescriptor::kNeedsFrameState);
+    stack_check_ = graph()->NewNode(
+        common()->Call(descriptor), jsgraph()->CEntryStubConstant(1),
+        jsgraph()->ExternalConstant(
+            ExternalReference(Runtime::kStackGuard, isolate())),
+        Int32Constant(0), UndefinedConstant(), frame_state, *effect, if_false);
+
+    *control = graph()->NewNode(common()->Merge(2), if_true, stack_check_);
+    *effect = graph()->NewNode(common()->EffectPhi(2), *effect, stack_check_,
+                               *control);
+  }
+
+  void Run() {
+    LoopTree* loop_tree = LoopFinder::BuildLoopTree(graph(), zone());
+    LoopVectorizer vectorizer(jsgraph(), loop_tree, zone());
+    vectorizer.Run();
+  }
+
+  JSGraph* jsgraph() { return &jsgraph_; }
+  MachineOperatorBuilder* machine() { return &machine_; }
+  SimplifiedOperatorBuilder* simplified() { return &simplified_; }
+
+  Node* a_ = nullptr;
+  Node* b_ = nullptr;
+  Node* c_ = nullptr;
+  Node* stack_check_ = nullptr;
+
+ private:
+  MachineOperatorBuilder machine_;
+  SimplifiedOperatorBuilder simplified_;
+  JSGraph jsgraph_;
+};
+
+TEST_F(LoopVectorizerTest, VectorizeInt32Add) {
+  if (!machine()->Is64()) return;
+  Node* loop = BuildLoop(machine()->Int32Add());
+  Node* effect_phi = nullptr;
+  Node* i = nullptr;
+  for (Node* use : loop->uses()) {
+    if (use->opcode() == IrOpcode::kEffectPhi) effect_phi = use;
+    if (use->opcode() == IrOpcode::kPhi) i = use;
+  }
+
+  Run();
+
+  // The original loop is entered from the exit of the vector loop.
+  Node* exit = loop->InputAt(0);
+  ASSERT_EQ(IrOpcode::kIfFalse, exit->opcode());
+  Node* vector_loop = NodeProperties::GetControlInput(
+      NodeProperties::GetControlInput(exit));
+  ASSERT_EQ(IrOpcode::kLoop, vector_loop->opcode());
+  EXPECT_EQ(start(), vector_loop->InputAt(0));
+  Node* vector_i = i->InputAt(0);
+  ASSERT_EQ(IrOpcode::kPhi, vector_i->opcode());
+  EXPECT_EQ(vector_loop, NodeProperties::GetControlInput(vector_i));
+
+  // The vector loop adds four elements at a time.
+  Node* vector_effect_phi = effect_phi->InputAt(0);
+  ASSERT_EQ(IrOpcode::kEffectPhi, vector_effect_phi->opcode());
+  Node* store = vector_effect_phi->InputAt(1);
+  EXPECT_THAT(store,
+              IsStore(StoreRepresentation(MachineRepresentation::kSimd128,
+                                          kNoWriteBarrier),
+                      c_, _, _, _, _));
+  Node* value = NodeProperties::GetValueInput(store, 2);
+  EXPECT_EQ(IrOpcode::kI32x4Add, value->opcode());
+  EXPECT_THAT(value->InputAt(0),
+              IsLoad(MachineType::Simd128(), a_, _, _, _));
+  EXPECT_THAT(value->InputAt(1),
+              IsLoad(MachineType::Simd128(), b_, _, _, _));
+  EXPECT_THAT(vector_i->InputAt(1), IsInt32Add(vector_i, IsInt32Constant(4)));
+}
+
+TEST_F(LoopVectorizerTest, VectorLoopChecksStack) {
+  if (!machine()->Is64()) return;
+  Node* loop = BuildLoop(machine()->Int32Add(), true);
+  Node* i = nullptr;
+  for (Node* use : loop->uses()) {
+    if (use->opcode() == IrOpcode::kPhi) i = use;
+  }
+
+  Run();
+
+  // The vector loop header starts with a copy of the stack check, whose frame
+  // state refers to the vector induction variable instead.
+  Node* exit = loop->InputAt(0);
+  ASSERT_EQ(IrOpcode::kIfFalse, exit->opcode());
+  Node* header = NodeProperties::GetControlInput(
+      NodeProperties::GetControlInput(exit));
+  ASSERT_EQ(IrOpcode::kMerge, header->opcode());
+  Node* call = header->InputAt(1);
+  ASSERT_EQ(IrOpcode::kCall, call->opcode());
+  EXPECT_NE(stack_check_, call);
+  EXPECT_EQ(stack_check_->op(), call->op());
+  Node* vector_loop = NodeProperties::GetControlInput(
+      NodeProperties::GetControlInput(header->InputAt(0)));
+  ASSERT_EQ(IrOpcode::kLoop, vector_loop->opcode());
+  Node* vector_i = i->InputAt(0);
+  EXPECT_EQ(vector_loop, NodeProperties::GetControlInput(vector_i));
+  Node* frame_state = call->InputAt(4);
+  ASSERT_EQ(IrOpcode::kFrameState, frame_state->opcode());
+  EXPECT_EQ(vector_i, frame_state->InputAt(1)->InputAt(0));
+  EXPECT_EQ(i, NodeProperties::GetValueInput(stack_check_, 4)
+                   ->InputAt(1)
+                   ->InputAt(0));
+}
+
+TEST_F(LoopVectorizerTest, DontVectorizeInt32Mul) {
+  Node* loop = BuildLoop(machine()->Int32Mul());
+
+  Run();
+
+  EXPECT_EQ(start(), loop->InputAt(0));
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -77,9 +77,10 @@ bool IsParallelMovePresent(int instr_index, Instruction::GapPosition gap_pos,
 
 class RegisterAllocatorTest : public InstructionSequenceTest {
  public:
-  void Allocate() {
+  void Allocate(bool loop_aware = false) {
     WireBlocks();
-    Pipeline::AllocateRegistersForTesting(config(), sequence(), true);
+    Pipeline::AllocateRegistersForTesting(config(), sequence(), true,
+                                          loop_aware);
   }
 };
 
@@ -303,6 +304,63 @@ TEST_F(RegisterAllocatorTest, RegressionPhisNeedTooManyRegisters) {
   Allocate();
 }
 
+TEST_F(RegisterAllocatorTest, LoopAwareSpillsOutsideOfLoop) {
+  const int kNumRegs = 3;
+  const int kValues = kNumRegs + 1;
+  SetNumRegs(kNumRegs, kNumRegs);
+
+  StartBlock();  // B0
+  auto constant = DefineConstant();
+  VReg values[kValues];
+  for (size_t i = 0; i < arraysize(values); ++i) {
+    values[i] = EmitOI(Reg());
+  }
+  EndBlock();
+
+  {
+    StartLoop(2);
+
+    StartBlock();  // B1
+    auto phi = Phi(constant, 2);
+    auto result = EmitOI(Same(), Reg(phi), Use(constant));
+    SetInput(phi, 1, result);
+    EndBlock(Branch(Reg(result), 1, 2));
+
+    StartBlock();  // B2
+    EndBlock(Jump(-1));
+
+    EndLoop();
+  }
+
+  StartBlock();  // B3
+  for (size_t i = 0; i < arraysize(values); ++i) {
+    EmitI(Reg(values[i]));
+  }
+  Return(Reg(values[0]));
+  EndBlock();
+
+  Allocate(true);
+
+  // None of the values is used inside the loop, so neither spills nor reloads
+  // should end up in it.
+  const InstructionBlocks& blocks = sequence()->instruction_blocks();
+  int loop_start = blocks[1]->first_instruction_index();
+  int loop_end = blocks[2]->last_instruction_index();
+  for (int i = loop_start; i <= loop_end; ++i) {
+    for (int pos = Instruction::FIRST_GAP_POSITION;
+         pos <= Instruction::LAST_GAP_POSITION; ++pos) {
+      const ParallelMove* moves = sequence()->InstructionAt(i)->GetParallelMove(
+          static_cast<Instruction::GapPosition>(pos));
+      if (moves == nullptr) continue;
+      for (auto move : *moves) {
+        if (move->IsEliminated() || move->IsRedundant()) continue;
+        EXPECT_FALSE(move->source().IsStackSlot());
+        EXPECT_FALSE(move->destination().IsStackSlot());
+      }
+    }
+  }
+}
+
 TEST_F(RegisterAllocatorTest, SpillPhi) {
   StartBlock();
   EndBlock(Branch(Imm(), 1, 2));
@@ -155,6 +155,26 @@ TEST_F(ZoneStatsTest, SimpleAllocationLoop) {
   ExpectForPool(0, max_loop_allocation, total_allocated);
 }
 
+TEST_F(ZoneStatsTest, MaxZoneSegmentBytes) {
+  EXPECT_EQ(0u, zone_stats()->GetMaxZoneSegmentBytes());
+  size_t large_zone_bytes = 0;
+  {
+    ZoneStats::Scope small_scope(zone_stats(), ZONE_NAME);
+    Allocate(small_scope.zone());
+    {
+      ZoneStats::Scope large_scope(zone_stats(), ZONE_NAME);
+      large_scope.zone()->New(100 * KB);
+      large_zone_bytes = large_scope.zone()->segment_bytes_allocated();
+      EXPECT_LT(small_scope.zone()->segment_bytes_allocated(),
+                large_zone_bytes);
+      EXPECT_EQ(large_zone_bytes, zone_stats()->GetMaxZoneSegmentBytes());
+    }
+    // The high-water mark survives the zone.
+    EXPECT_EQ(large_zone_bytes, zone_stats()->GetMaxZoneSegmentBytes());
+  }
+  EXPECT_EQ(large_zone_bytes, zone_stats()->GetMaxZoneSegmentBytes());
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
@@ -53,5 +53,31 @@ TEST_F(ConcurrentMarkingDequeTest, BailoutDeque) {
   EXPECT_EQ(nullptr, marking_deque()->Pop(MarkingThread::kConcurrent));
 }
 
+TEST_F(ConcurrentMarkingDequeTest, PrivateSegment) {
+  marking_deque()->Push(object(), MarkingThread::kConcurrent,
+                        TargetDeque::kShared, 0);
+  EXPECT_TRUE(marking_deque()->IsEmpty());
+  EXPECT_EQ(1, marking_deque()->Size());
+  marking_deque()->FlushLocal(0);
+  EXPECT_FALSE(marking_deque()->IsEmpty());
+  EXPECT_EQ(object(), marking_deque()->Pop());
+  EXPECT_TRUE(marking_deque()->IsEmpty());
+}
+
+TEST_F(ConcurrentMarkingDequeTest, FullSegmentIsPublished) {
+  for (int i = 0; i <= StackSegment::kNumEntries; i++) {
+    marking_deque()->Push(object(), MarkingThread::kConcurrent,
+                          TargetDeque::kShared, 0);
+  }
+  EXPECT_FALSE(marking_deque()->IsSharedEmpty());
+  for (int i = 0; i < StackSegment::kNumEntries; i++) {
+    EXPECT_EQ(object(), marking_deque()->Pop(MarkingThread::kConcurrent, 1));
+  }
+  EXPECT_EQ(nullptr, marking_deque()->Pop(MarkingThread::kConcurrent, 1));
+  EXPECT_EQ(object(), marking_deque()->Pop(MarkingThread::kConcurrent, 0));
+  EXPECT_EQ(nullptr, marking_deque()->Pop(MarkingThread::kConcurrent, 0));
+  EXPECT_EQ(0, marking_deque()->Size());
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -294,5 +294,46 @@ TEST_F(GCTracerTest, IncrementalMarkingSpeed) {
                        tracer->IncrementalMarkingSpeedInBytesPerMillisecond()));
 }
 
+TEST(GCTracer, PauseHistogram) {
+  GCTracer::PauseHistogram histogram;
+  histogram.Add(0.05);
+  histogram.Add(0.1);
+  histogram.Add(7);
+  histogram.Add(1000);
+  EXPECT_EQ(4u, histogram.count());
+  EXPECT_EQ(1u, histogram.bucket_count(0));
+  EXPECT_EQ(1u, histogram.bucket_count(1));
+  // 5ms <= 7ms < 10ms.
+  EXPECT_EQ(1u, histogram.bucket_count(6));
+  EXPECT_EQ(1u, histogram.bucket_count(
+                    GCTracer::PauseHistogram::kNumberOfBuckets - 1));
+  EXPECT_DOUBLE_EQ(1007.15, histogram.total_ms());
+  EXPECT_DOUBLE_EQ(1000, histogram.max_ms());
+}
+
+TEST_F(GCTracerTest, Telemetry) {
+  GCTracer* tracer = i_isolate()->heap()->tracer();
+  tracer->ResetForTesting();
+
+  tracer->Start(MARK_COMPACTOR, GarbageCollectionReason::kTesting,
+                "collector unittest");
+  tracer->AddScopeSample(GCTracer::Scope::MC_MARK, 3);
+  tracer->Stop(MARK_COMPACTOR);
+  tracer->AddBackgroundScopeSample(
+      GCTracer::BackgroundScope::MC_BACKGROUND_SWEEPING, 5);
+
+  GCTracer::Telemetry telemetry;
+  tracer->GetTelemetry(&telemetry);
+  EXPECT_EQ(1u, telemetry.pauses[GCTracer::Telemetry::kMarkCompact].count());
+  EXPECT_EQ(0u, telemetry.pauses[GCTracer::Telemetry::kScavenge].count());
+  EXPECT_EQ(1u, telemetry.pauses[GCTracer::Telemetry::kMark].count());
+  EXPECT_DOUBLE_EQ(3,
+                   telemetry.pauses[GCTracer::Telemetry::kMark].total_ms());
+  // Phases that did not run are not recorded.
+  EXPECT_EQ(0u, telemetry.pauses[GCTracer::Telemetry::kSweep].count());
+  EXPECT_DOUBLE_EQ(5, telemetry.background_time_ms
+                          [GCTracer::BackgroundScope::MC_BACKGROUND_SWEEPING]);
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -97,6 +97,47 @@ TEST(SlotSet, Remove) {
   }
 }
 
+TEST(SlotSet, SparseSlots) {
+  const int kSparseSlots = SlotSet::kSparseSlots;
+  const int kStride = Page::kPageSize / kSparseSlots;
+  SlotSet set;
+  set.SetPageStart(0);
+  for (int i = 0; i < kSparseSlots; i++) {
+    set.Insert(i * kStride);
+    // Inserting a recorded slot again must not use up another entry.
+    set.Insert(i * kStride);
+  }
+  EXPECT_TRUE(set.IsSparse());
+  set.Remove(0);
+  EXPECT_FALSE(set.Lookup(0));
+  set.Insert(kPointerSize);
+  EXPECT_TRUE(set.IsSparse());
+  int visited = 0;
+  int remaining = set.Iterate(
+      [&visited](Address slot_address) {
+        uintptr_t intaddr = reinterpret_cast<uintptr_t>(slot_address);
+        visited++;
+        return intaddr == static_cast<uintptr_t>(2 * kStride) ? REMOVE_SLOT
+                                                              : KEEP_SLOT;
+      },
+      SlotSet::KEEP_EMPTY_BUCKETS);
+  EXPECT_EQ(kSparseSlots, visited);
+  EXPECT_EQ(kSparseSlots - 1, remaining);
+  EXPECT_FALSE(set.Lookup(2 * kStride));
+
+  // Overflowing the inline slots moves all of them into buckets.
+  set.Insert(2 * kPointerSize);
+  set.Insert(3 * kPointerSize);
+  EXPECT_FALSE(set.IsSparse());
+  EXPECT_TRUE(set.Lookup(kPointerSize));
+  EXPECT_TRUE(set.Lookup(2 * kPointerSize));
+  EXPECT_TRUE(set.Lookup(3 * kPointerSize));
+  for (int i = 1; i < kSparseSlots; i++) {
+    EXPECT_EQ(i != 2, set.Lookup(i * kStride));
+  }
+  EXPECT_FALSE(set.Lookup(0));
+}
+
 void CheckRemoveRangeOn(uint32_t start, uint32_t end) {
   SlotSet set;
   set.SetPageStart(0);
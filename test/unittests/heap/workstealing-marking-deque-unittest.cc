@@ -29,5 +29,26 @@ TEST(WorkStealingMarkingDeque, LocalPushPop) {
   delete object1;
 }
 
+TEST(WorkStealingMarkingDeque, StealFullSegment) {
+  WorkStealingMarkingDeque marking_deque;
+  LocalWorkStealingMarkingDeque local_marking_deque1(&marking_deque, 0);
+  LocalWorkStealingMarkingDeque local_marking_deque2(&marking_deque, 1);
+  HeapObject dummy;
+  HeapObject* object = nullptr;
+  // Pushing more than a segment publishes the oldest segment.
+  for (int i = 0; i <= StackSegment::kNumEntries; i++) {
+    EXPECT_TRUE(local_marking_deque1.Push(&dummy));
+  }
+  EXPECT_TRUE(local_marking_deque2.IsEmpty());
+  EXPECT_TRUE(local_marking_deque2.WaitForMoreObjects());
+  for (int i = 0; i < StackSegment::kNumEntries; i++) {
+    EXPECT_TRUE(local_marking_deque2.Pop(&object));
+    EXPECT_EQ(&dummy, object);
+  }
+  EXPECT_FALSE(local_marking_deque2.Pop(&object));
+  EXPECT_TRUE(local_marking_deque1.Pop(&object));
+  EXPECT_FALSE(local_marking_deque1.WaitForMoreObjects());
+}
+
 }  // namespace internal
 }  // namespace v8
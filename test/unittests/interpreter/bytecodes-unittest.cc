@@ -6,6 +6,7 @@
 
 #include "src/v8.h"
 
+#include "src/interpreter/bytecode-lookahead-pairs.h"
 #include "src/interpreter/bytecode-register.h"
 #include "src/interpreter/bytecodes.h"
 #include "test/unittests/test-utils.h"
@@ -317,6 +318,30 @@ TEST(Bytecodes, IsJumpIfToBoolean) {
 #undef TEST_BYTECODE
 }
 
+TEST(Bytecodes, LookaheadPairsAreSupported) {
+  // Only jumps on a boolean accumulator and the binary operations inlined by
+  // the Ldar handler can be looked ahead for, see bytecode-lookahead-pairs.h.
+#define LOOKAHEAD_JUMP_LIST(V) V(JumpIfTrue) V(JumpIfFalse)
+#define LDAR_LOOKAHEAD_LIST(V) V(Add) V(Sub) V(Mul) V(Div) V(Mod)
+#define TEST_PAIR(First, Second)                                             \
+  EXPECT_TRUE(                                                               \
+      Bytecodes::IsLookaheadPair(Bytecode::k##First, Bytecode::k##Second));  \
+  EXPECT_FALSE(Bytecodes::IsJump(Bytecode::k##First));                       \
+  if (!IN_BYTECODE_LIST(Bytecode::k##Second, LOOKAHEAD_JUMP_LIST)) {         \
+    EXPECT_EQ(Bytecode::kLdar, Bytecode::k##First);                          \
+    EXPECT_TRUE(IN_BYTECODE_LIST(Bytecode::k##Second, LDAR_LOOKAHEAD_LIST)); \
+  }
+
+  BYTECODE_LOOKAHEAD_PAIR_LIST(TEST_PAIR)
+#undef TEST_PAIR
+#undef LDAR_LOOKAHEAD_LIST
+#undef LOOKAHEAD_JUMP_LIST
+
+  EXPECT_FALSE(Bytecodes::IsLookaheadPair(Bytecode::kJumpIfFalse,
+                                          Bytecode::kJumpIfFalse));
+  EXPECT_FALSE(Bytecodes::IsLookaheadPair(Bytecode::kLdar, Bytecode::kStar));
+}
+
 #undef OR_IS_BYTECODE
 #undef IN_BYTECODE_LIST
 
@@ -53,6 +53,7 @@
       'compiler/graph-unittest.cc',
       'compiler/graph-unittest.h',
       'compiler/instruction-unittest.cc',
+      'compiler/instruction-scheduler-unittest.cc',
       'compiler/instruction-selector-unittest.cc',
       'compiler/instruction-selector-unittest.h',
       'compiler/instruction-sequence-unittest.cc',
@@ -68,7 +69,9 @@
       'compiler/live-range-builder.h',
       'compiler/regalloc/live-range-unittest.cc',
       'compiler/load-elimination-unittest.cc',
+      'compiler/loop-invariant-code-motion-unittest.cc',
       'compiler/loop-peeling-unittest.cc',
+      'compiler/loop-vectorizer-unittest.cc',
       'compiler/machine-operator-reducer-unittest.cc',
       'compiler/machine-operator-unittest.cc',
       'compiler/regalloc/move-optimizer-unittest.cc',
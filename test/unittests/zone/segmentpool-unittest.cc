@@ -22,11 +22,52 @@ TEST(Zone, SegmentPoolConstraints) {
     for (size_t power = 0; power < AccountingAllocator::kNumberBuckets;
          ++power) {
       total_size +=
-          allocator.unused_segments_max_sizes_[power] * (size_t(1) << power);
+          allocator.unused_segments_max_sizes_[power] *
+          (size_t(1) << (power + AccountingAllocator::kMinSegmentSizePower));
     }
     EXPECT_LE(total_size, size);
+    EXPECT_EQ(size, allocator.GetMaxPoolSize());
   }
 }
 
+TEST(Zone, SegmentPoolMaxSize) {
+  // Room for one segment of 8 KB and one of 16 KB.
+  AccountingAllocator allocator;
+  allocator.ConfigureSegmentPool(24 * KB);
+
+  // Segments are pooled in the size class they are at least as large as, so
+  // these two fit into the size classes, but not into the pool.
+  Segment* first = allocator.GetSegment(15 * KB);
+  Segment* second = allocator.GetSegment(31 * KB);
+  allocator.ReturnSegment(first);
+  allocator.ReturnSegment(second);
+
+  EXPECT_EQ(15 * KB, allocator.GetCurrentPoolSize());
+  EXPECT_EQ(15 * KB, allocator.GetCurrentMemoryUsage());
+}
+
+TEST(Zone, SegmentPoolTrim) {
+  static const size_t kSmallSegmentSize = 8 * KB;
+  static const size_t kLargeSegmentSize = 256 * KB;
+  AccountingAllocator allocator;
+  allocator.ConfigureSegmentPool(GB);
+
+  Segment* small = allocator.GetSegment(kSmallSegmentSize);
+  Segment* large = allocator.GetSegment(kLargeSegmentSize);
+  allocator.ReturnSegment(small);
+  allocator.ReturnSegment(large);
+  EXPECT_EQ(kSmallSegmentSize + kLargeSegmentSize,
+            allocator.GetCurrentPoolSize());
+
+  // Large segments are released first.
+  allocator.TrimPool(kSmallSegmentSize);
+  EXPECT_EQ(kSmallSegmentSize, allocator.GetCurrentPoolSize());
+  EXPECT_EQ(kSmallSegmentSize, allocator.GetCurrentMemoryUsage());
+
+  allocator.TrimPool(0);
+  EXPECT_EQ(0u, allocator.GetCurrentPoolSize());
+  EXPECT_EQ(0u, allocator.GetCurrentMemoryUsage());
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -44,11 +44,21 @@ examples:
 
   # Display the top 5 sources and destinations of dispatches to/from LdaZero
   $ tools/ignition/bytecode_dispatches_report.py -f LdaZero -n 5
+
+  # Print BYTECODE_LOOKAHEAD_PAIR_LIST for the hottest 12 supported pairs
+  $ tools/ignition/bytecode_dispatches_report.py -l -n 12
 """
 
 __COUNTER_BITS = struct.calcsize("P") * 8  # Size in bits of a pointer
 __COUNTER_MAX = 2**__COUNTER_BITS - 1
 
+# Bytecodes which the interpreter can execute inline from the handler of any
+# non-jump bytecode, see src/interpreter/bytecode-lookahead-pairs.h.
+__LOOKAHEAD_JUMPS = frozenset(["JumpIfTrue", "JumpIfFalse"])
+
+# Bytecodes which the Ldar handler can execute inline.
+__LDAR_LOOKAHEAD_BINARY_OPS = frozenset(["Add", "Sub", "Mul", "Div", "Mod"])
+
 
 def warn_if_counter_may_have_saturated(dispatches_table):
   for source, counters_from_source in iteritems(dispatches_table):
@@ -76,6 +86,36 @@ def print_top_bytecode_dispatch_pairs(dispatches_table, top_count):
     print "{:>12d}\t{} -> {}".format(counter, source, destination)
 
 
+def is_supported_lookahead_pair(source, destination):
+  if destination in __LOOKAHEAD_JUMPS:
+    return not source.startswith("Jump")
+  if destination in __LDAR_LOOKAHEAD_BINARY_OPS:
+    return source == "Ldar"
+  return False
+
+
+def find_lookahead_pairs(dispatches_table, top_count):
+  def supported_counters_generator():
+    for source, counters_from_source in iteritems(dispatches_table):
+      for destination, counter in iteritems(counters_from_source):
+        if is_supported_lookahead_pair(source, destination):
+          yield source, destination, counter
+
+  return heapq.nlargest(top_count, supported_counters_generator(),
+                        key=lambda x: x[2])
+
+
+def print_lookahead_pairs(dispatches_table, top_count):
+  lookahead_pairs = find_lookahead_pairs(dispatches_table, top_count)
+  lines = ["#define BYTECODE_LOOKAHEAD_PAIR_LIST(V)"]
+  for source, destination, _ in lookahead_pairs:
+    lines.append("  V({}, {})".format(source, destination))
+  width = max(len(line) for line in lines)
+  for line in lines[:-1]:
+    print "{} \\".format(line.ljust(width))
+  print lines[-1]
+
+
 def find_top_bytecodes(dispatches_table):
   top_bytecodes = []
   for bytecode, counters_from_bytecode in iteritems(dispatches_table):
@@ -209,13 +249,19 @@ def parse_command_line():
     metavar="N",
     type=int,
     default=10,
-    help="print N top entries when running with -t or -f (default 10)"
+    help="print N top entries when running with -t, -f or -l (default 10)"
   )
   command_line_parser.add_argument(
     "--top-dispatches-for-bytecode", "-f",
     metavar="<bytecode name>",
     help="print top dispatch sources and destinations to the specified bytecode"
   )
+  command_line_parser.add_argument(
+    "--lookahead-pairs", "-l",
+    action="store_true",
+    help=("print BYTECODE_LOOKAHEAD_PAIR_LIST for the top N dispatch pairs "
+          "the interpreter supports looking ahead for")
+  )
   command_line_parser.add_argument(
     "--output-filename", "-o",
     metavar="<output filename>",
@@ -269,6 +315,8 @@ def main():
   elif program_options.top_bytecode_dispatch_pairs:
     print_top_bytecode_dispatch_pairs(
       dispatches_table, program_options.top_entries_count)
+  elif program_options.lookahead_pairs:
+    print_lookahead_pairs(dispatches_table, program_options.top_entries_count)
   elif program_options.top_dispatches_for_bytecode:
     print_top_dispatch_sources_and_destinations(
       dispatches_table, program_options.top_dispatches_for_bytecode,
@@ -19,6 +19,18 @@ class BytecodeDispatchesReportTest(unittest.TestCase):
       ('a', 'b',  8),
       ('c', 'c',  7)])
 
+  def test_find_lookahead_pairs(self):
+    lookahead_pairs = bdr.find_lookahead_pairs({
+      "Ldar": {"Add": 50, "Star": 99, "Mod": 2, "JumpIfFalse": 3},
+      "Star": {"Ldar": 80, "JumpIfTrue": 7},
+      "TestLessThan": {"JumpIfFalse": 40, "Star": 9},
+      "JumpIfFalse": {"JumpIfFalse": 60}}, 4)
+    self.assertListEqual(lookahead_pairs, [
+      ('Ldar', 'Add', 50),
+      ('TestLessThan', 'JumpIfFalse', 40),
+      ('Star', 'JumpIfTrue', 7),
+      ('Ldar', 'JumpIfFalse', 3)])
+
   def test_build_counters_matrix(self):
     counters_matrix, xlabels, ylabels = bdr.build_counters_matrix({
       "a": {"a": 10, "b":  8, "c":  7},